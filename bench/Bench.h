@@ -0,0 +1,133 @@
+﻿#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// ========== 微基准测试框架 ==========
+// 每个用例先运行 warmup 次（不计时），再运行 reps 次，每次先执行不计时的 setup，
+// 再对 body 计时；报告每个元素耗时（纳秒）的中位数、最小值与标准差。
+// 比较两个提交时以中位数为准，标准差用于判断这次测量是否可信
+struct BenchConfig {
+	int warmup = 3;
+	int reps = 15;
+	int cpu = 0;                // 把测试线程固定到该核心，-1 表示不固定
+	std::string filter;         // 只运行名字包含该字符串的用例
+	std::string jsonPath;       // 结果写入的 JSON 文件，空表示不写
+};
+
+struct BenchResult {
+	std::string name;
+	uint64_t items = 0;         // 每次 body 处理的元素数
+	double median = 0;          // 纳秒/元素
+	double min = 0;
+	double mean = 0;
+	double stddev = 0;
+};
+
+// 防止编译器把基准中的计算优化掉
+inline volatile uint64_t gBenchSink = 0;
+template<typename T>
+inline void benchKeep(const T& value) {
+	gBenchSink = gBenchSink + static_cast<uint64_t>(value);
+}
+
+class Bench {
+public:
+	explicit Bench(const BenchConfig& config) : mConfig(config) {}
+
+	// 把当前线程固定到 config.cpu，减少调度迁移带来的抖动
+	bool pinThread() const {
+		if (mConfig.cpu < 0) return false;
+#ifdef _WIN32
+		return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << mConfig.cpu) != 0;
+#elif defined(__linux__)
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(mConfig.cpu, &set);
+		return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+		return false;
+#endif
+	}
+
+	// 用例是否会被运行（未被 filter 过滤掉）
+	bool selected(const std::string& name) const {
+		return mConfig.filter.empty() || name.find(mConfig.filter) != std::string::npos;
+	}
+
+	template<typename Setup, typename Body>
+	void run(const std::string& name, uint64_t items, Setup&& setup, Body&& body) {
+		if (!selected(name)) return;
+		for (int i = 0; i < mConfig.warmup; i++) {
+			setup();
+			body();
+		}
+		std::vector<double> samples;
+		samples.reserve(mConfig.reps);
+		for (int i = 0; i < mConfig.reps; i++) {
+			setup();
+			auto begin = std::chrono::steady_clock::now();
+			body();
+			auto end = std::chrono::steady_clock::now();
+			double ns = std::chrono::duration<double, std::nano>(end - begin).count();
+			samples.push_back(ns / static_cast<double>(items ? items : 1));
+		}
+		std::sort(samples.begin(), samples.end());
+
+		BenchResult result;
+		result.name = name;
+		result.items = items;
+		result.min = samples.front();
+		result.median = samples[samples.size() / 2];
+		double sum = 0;
+		for (double s : samples) sum += s;
+		result.mean = sum / samples.size();
+		double var = 0;
+		for (double s : samples) var += (s - result.mean) * (s - result.mean);
+		result.stddev = std::sqrt(var / samples.size());
+		printf("%-44s %10.2f ns/item  (min %.2f, sd %.1f%%)\n", name.c_str(), result.median, result.min,
+			result.mean > 0 ? 100.0 * result.stddev / result.mean : 0.0);
+		mResults.push_back(result);
+	}
+
+	template<typename Body>
+	void run(const std::string& name, uint64_t items, Body&& body) {
+		run(name, items, []() {}, body);
+	}
+
+	bool writeJson(const std::string& path, const std::string& label) const {
+		std::FILE* file = std::fopen(path.c_str(), "w");
+		if (!file) {
+			std::fprintf(stderr, "cannot write %s\n", path.c_str());
+			return false;
+		}
+		std::fprintf(file, "{\n  \"label\": \"%s\",\n  \"warmup\": %d,\n  \"reps\": %d,\n  \"cpu\": %d,\n  \"results\": [\n",
+			label.c_str(), mConfig.warmup, mConfig.reps, mConfig.cpu);
+		for (size_t i = 0; i < mResults.size(); i++) {
+			const BenchResult& r = mResults[i];
+			std::fprintf(file, "    {\"name\": \"%s\", \"items\": %llu, \"median_ns\": %.3f, \"min_ns\": %.3f, \"mean_ns\": %.3f, \"stddev_ns\": %.3f}%s\n",
+				r.name.c_str(), static_cast<unsigned long long>(r.items), r.median, r.min, r.mean, r.stddev,
+				i + 1 < mResults.size() ? "," : "");
+		}
+		std::fputs("  ]\n}\n", file);
+		std::fclose(file);
+		return true;
+	}
+
+	const std::vector<BenchResult>& results() const { return mResults; }
+
+private:
+	BenchConfig mConfig;
+	std::vector<BenchResult> mResults;
+};
@@ -0,0 +1,362 @@
+﻿#include "Bench.h"
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <NullGL.hpp>
+#include <Texture.hpp>
+#include <Sprite.hpp>
+#include <Action.h>
+#include <BulletWorld.h>
+#include <BulletProgram.h>
+#include <SpatialGrid.h>
+#include <CollisionManager.h>
+#include <MovementUpdater.h>
+#include <Player.h>
+#include <Item.h>
+#include <Scene.h>
+#include <ScriptSystem.h>
+
+// ========== th_bench ==========
+// 热点代码的微基准：子弹生成/删除、运动更新器、网格与碰撞、道具更新、脚本解析。
+// 不创建窗口，渲染相关的 gl* 调用全部进入 NullGL；随机数使用固定种子，
+// 因此同一台机器上两次运行处理的数据完全相同，结果可以直接比较。
+// 用法：th_bench [--warmup N] [--reps N] [--cpu N] [--filter 子串] [--json 文件] [--label 名称]
+
+namespace {
+
+// 游戏区域，与 MainGame 一致
+const glm::vec2 AREA_MIN = { 64.0f, 32.0f };
+const glm::vec2 AREA_MAX = { 64.0f + 768.0f, 32.0f + 896.0f };
+const double STEP = 1.0 / 60.0;
+
+// 只用于碰撞检测的玩家：不加载纹理，只给一个 16x16 的精灵提供位置
+class BenchPlayer : public Player {
+public:
+	BenchPlayer(unsigned int& power, esl::Texture* texture, glm::vec2 pos) : Player(power) {
+		mSprite = std::make_unique<esl::Sprite>(texture);
+		mSprite->setPosition(pos);
+		mInvincible = true;
+	}
+};
+
+glm::vec2 randomPoint(std::mt19937& rng) {
+	std::uniform_real_distribution<float> x(AREA_MIN.x, AREA_MAX.x);
+	std::uniform_real_distribution<float> y(AREA_MIN.y, AREA_MAX.y);
+	return { x(rng), y(rng) };
+}
+
+void fillWorld(BulletWorld& world, size_t count, std::mt19937& rng) {
+	std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+	world.clear();
+	world.reserve(count);
+	for (size_t i = 0; i < count; i++) {
+		world.spawn(static_cast<uint16_t>(i % 16), 4.0f, randomPoint(rng), angle(rng), 120.0f);
+	}
+}
+
+// ---------- 子弹 ----------
+void benchBullets(Bench& bench, std::mt19937& rng) {
+	const uint32_t count = 10000;
+	BulletWorld world;
+	world.reserve(count);
+	std::vector<glm::vec2> positions(count);
+	std::vector<BulletHandle> handles(count);
+	for (auto& pos : positions) pos = randomPoint(rng);
+
+	bench.run("bullet_world/spawn_release/10k", count,
+		[&]() {
+			world.clear();
+		},
+		[&]() {
+			for (uint32_t i = 0; i < count; i++) {
+				handles[i] = world.spawn(3, 4.0f, positions[i], static_cast<float>(i), 150.0f);
+			}
+			// 逐个释放一半（只做标记），再一次性压缩
+			for (uint32_t i = 0; i < count; i += 2) {
+				world.release(handles[i]);
+			}
+			benchKeep(world.compact());
+		});
+
+	PatternDesc ring;
+	ring.origin = { 448.0f, 700.0f };
+	ring.angleStep = 360.0f / 64.0f;
+	ring.speed = 200.0f;
+	ring.spawnRadius = 16.0f;
+	ring.style = 5;
+	ring.radius = 4.0f;
+	bench.run("bullet_world/spawn_batch/64x128", 64 * 128,
+		[&]() {
+			world.clear();
+		},
+		[&]() {
+			for (int wave = 0; wave < 128; wave++) {
+				ring.baseAngle = wave * 2.5f;
+				benchKeep(world.spawnBatch(ring, 64));
+			}
+		});
+
+	fillWorld(world, count, rng);
+	bench.run("bullet_world/update/linear/10k", count, [&]() {
+		world.update(STEP);
+		benchKeep(world.mX[0]);
+	});
+
+	BulletProgram program;
+	program.linear(0.1f).accelerate(-60.0f, 0.5f).turn(90.0f, 0.5f).jump(1);
+	ring.program = world.registerProgram(program);
+	world.clear();
+	for (int wave = 0; wave < static_cast<int>(count / 64); wave++) {
+		ring.baseAngle = wave * 2.5f;
+		world.spawnBatch(ring, 64);
+	}
+	bench.run("bullet_world/update/program/10k", world.size(), [&]() {
+		world.update(STEP);
+		benchKeep(world.mX[0]);
+	});
+}
+
+// ---------- 运动更新器 ----------
+void benchUpdater(Bench& bench, const std::string& name, const IMovementUpdater& prototype,
+	const std::function<void(MovementState&)>& configure) {
+	const size_t count = 2048;
+	const int steps = 30;
+	std::vector<std::unique_ptr<IMovementUpdater>> updaters;
+	std::vector<MovementState> states(count);
+	for (size_t i = 0; i < count; i++) updaters.push_back(prototype.clone());
+
+	bench.run("movement/" + name, count * steps,
+		[&]() {
+			for (size_t i = 0; i < count; i++) {
+				states[i] = MovementState();
+				configure(states[i]);
+				glm::vec2 start = { 100.0f + (i % 64) * 10.0f, 400.0f + (i / 64) * 10.0f };
+				updaters[i]->initialize(states[i], start);
+			}
+		},
+		[&]() {
+			for (int step = 0; step < steps; step++) {
+				for (size_t i = 0; i < count; i++) {
+					updaters[i]->update(states[i], STEP);
+				}
+			}
+			benchKeep(states[count - 1].position.x);
+		});
+}
+
+void benchMovement(Bench& bench) {
+	benchUpdater(bench, "linear", LinearMovementUpdater(), [](MovementState& s) {
+		s.speed = 200.0f;
+		s.direction = 30.0f;
+		s.accelerationScalar = 20.0f;
+	});
+	benchUpdater(bench, "target", TargetMovementUpdater(), [](MovementState& s) {
+		s.useTargetMode = true;
+		s.targetPosition = { 448.0f, 200.0f };
+		s.speed = 150.0f;
+	});
+	benchUpdater(bench, "circular", CircularMovementUpdater(), [](MovementState& s) {
+		s.useCenterMode = true;
+		s.center = { 448.0f, 480.0f };
+		s.angleVelocity = 2.0f;
+		s.radiusVelocity = 10.0f;
+	});
+	benchUpdater(bench, "elliptical", EllipticalMovementUpdater(), [](MovementState& s) {
+		s.useCenterMode = true;
+		s.center = { 448.0f, 480.0f };
+		s.angleVelocity = 2.0f;
+		s.axisRatio = 0.5f;
+		s.ellipseDirection = 30.0f;
+	});
+	benchUpdater(bench, "wave", WaveMovementUpdater(40.0f, 3.0f), [](MovementState& s) {
+		s.speed = 120.0f;
+		s.direction = 270.0f;
+	});
+
+	const std::vector<glm::vec2> curve = { { 100, 800 }, { 300, 200 }, { 600, 900 }, { 800, 300 } };
+	benchUpdater(bench, "bezier", BezierMovementUpdater(curve, 2.0f), [](MovementState&) {});
+
+	// 动态控制点与静态控制点一一对应，非空的 getter 覆盖同位置的静态点
+	const glm::vec2 dynamicTarget = { 448.0f, 160.0f };
+	GeneralBezierMovementUpdater general({ { 200, 700 }, { 700, 700 }, { 0, 0 } },
+		{ nullptr, nullptr, [&dynamicTarget]() { return dynamicTarget; } }, 2.0f);
+	benchUpdater(bench, "general_bezier", general, [](MovementState&) {});
+
+	std::vector<CompositeGeneralBezierMovementUpdater::BezierSegment> segments(3);
+	segments[0] = { { { 200, 700 }, { 300, 500 } }, 0.2f, nullptr };
+	segments[1] = { { { 600, 800 }, { 700, 400 } }, 0.2f, nullptr };
+	segments[2] = { { { 400, 300 }, { 448, 600 } }, 0.2f, nullptr };
+	benchUpdater(bench, "composite_bezier", CompositeGeneralBezierMovementUpdater(segments), [](MovementState&) {});
+}
+
+// ---------- 网格与碰撞 ----------
+void benchCollision(Bench& bench, std::mt19937& rng) {
+	esl::Texture texture(0, 16, 16);
+	unsigned int power = 100;
+	BenchPlayer player(power, &texture, { 448.0f, 200.0f });
+	CollisionManager collision;
+
+	std::vector<glm::vec2> probes(1000);
+	for (auto& probe : probes) probe = randomPoint(rng);
+
+	for (size_t count : { size_t(1000), size_t(5000), size_t(20000) }) {
+		const std::string suffix = "/" + std::to_string(count / 1000) + "k";
+		BulletWorld world;
+		fillWorld(world, count, rng);
+		SpatialGrid grid;
+
+		bench.run("spatial_grid/build" + suffix, count, [&]() {
+			grid.build(world.mX.data(), world.mY.data(), world.mRadius.data(), world.size());
+			benchKeep(grid.size());
+		});
+
+		bench.run("spatial_grid/query" + suffix, probes.size(), [&]() {
+			uint64_t found = 0;
+			for (const glm::vec2& probe : probes) {
+				for (const SpatialGrid::Span& span : grid.query(probe, 72.0f)) found += span.size();
+			}
+			benchKeep(found);
+		});
+
+		const int checks = 200;
+		bench.run("collision/enemy_bullets_vs_player" + suffix, checks, [&]() {
+			for (int i = 0; i < checks; i++) {
+				benchKeep(collision.checkEnemyBulletsVsPlayer(world, grid, player));
+			}
+		});
+	}
+}
+
+// ---------- 道具 ----------
+void benchItems(Bench& bench, std::mt19937& rng) {
+	// Item::init 会尝试加载道具纹理，用例被过滤掉时不做准备
+	if (!bench.selected("item/update_all/2k")) return;
+	esl::Texture texture(0, 16, 16);
+	unsigned int power = 100;
+	// 玩家在屏幕下方，远离道具，也不触发全收取
+	BenchPlayer player(power, &texture, { 448.0f, 64.0f });
+	Data data;
+	Item::init(nullptr, &player, data);
+
+	// 道具从上半屏缓慢下落，所有重复运行结束前都不会离开屏幕，数量保持不变
+	const size_t count = 2000;
+	std::uniform_real_distribution<float> x(100.0f, 800.0f);
+	std::uniform_real_distribution<float> y(650.0f, 900.0f);
+	for (size_t i = 0; i < count; i++) {
+		Item::generate_item(i % 4 == 0 ? Item::Type::Point : Item::Type::Power, { x(rng), y(rng) });
+	}
+	const int steps = 4;
+	bench.run("item/update_all/2k", count * steps, [&]() {
+		for (int i = 0; i < steps; i++) {
+			Item::UpdateAll(STEP, player.get_position().y);
+		}
+	});
+	Item::cleanup();
+}
+
+// ---------- 脚本解析 ----------
+std::filesystem::path writeTempFile(const char* name, const std::string& content) {
+	std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+	std::ofstream file(path, std::ios::binary);
+	file << content;
+	return path;
+}
+
+void benchScripts(Bench& bench) {
+	// 与 Assets/audio/thbgm.fmt 格式相同的音乐描述
+	const int tracks = 64;
+	std::ostringstream audio;
+	audio << "@BGM\n";
+	for (int i = 0; i < tracks; i++) {
+		audio << "@a\n"
+			<< "\ttitle: \"\xE6\x9B\xB2\xE7\x9B\xAE " << i << "\"\n"
+			<< "\tstart: 0x" << std::hex << (0x10 + i * 0x400000) << "\n"
+			<< "\tprelude: 0x" << (0x20000 + i) << "\n"
+			<< "\tloopStart: 0x" << (0x40000 + i) << "\n"
+			<< "\tloopLength: 0x" << (0x300000 + i) << std::dec << "\n"
+			<< "@end\n";
+	}
+	audio << "@#\n";
+	const std::filesystem::path audioPath = writeTempFile("th_bench_audio.fmt", audio.str());
+
+	bench.run("script/load_audio_script/64", tracks, [&]() {
+		ScriptSystem scripts;
+		scripts.loadAudioScript(audioPath.string());
+	});
+
+	// 与对话脚本同样格式的文本：逐行解码、去空白、解析属性值。
+	// 完整的 preloadDialogueScript 需要立绘和字体资源，这里只覆盖文本解析部分
+	const int messages = 500;
+	std::ostringstream dialogue;
+	for (int i = 0; i < messages; i++) {
+		dialogue << "  @2\n\trole: " << (i % 2) << "\n\tface: " << (i % 5) << "\n\tballoon: " << (i % 3) << "\n"
+			<< "\t\"\xE3\x81\x93\xE3\x82\x93\xE3\x81\xAB\xE3\x81\xA1\xE3\x81\xAF " << i << "\"\n"
+			<< "\t\"\xE5\xBC\xBE\xE5\xB9\x95\xE3\x81\xAE\xE5\xA4\x9C\"\n";
+	}
+	const std::filesystem::path dialoguePath = writeTempFile("th_bench_dialogue.txt", dialogue.str());
+
+	ScriptSystem scripts;
+	bench.run("script/dialogue_text/500", messages, [&]() {
+		std::wistringstream stream(scripts.fileConvertToWideString(dialoguePath.string()));
+		std::wstring line;
+		size_t values = 0;
+		while (std::getline(stream, line)) {
+			scripts.trim(line);
+			if (line.find(L':') != std::wstring::npos) {
+				values += std::stoi(scripts.parseStrVal(line));
+			}
+			else {
+				values += line.size();
+			}
+		}
+		benchKeep(values);
+	});
+
+	std::error_code ignored;
+	std::filesystem::remove(audioPath, ignored);
+	std::filesystem::remove(dialoguePath, ignored);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	BenchConfig config;
+	std::string label = "th_bench";
+	for (int i = 1; i < argc; i++) {
+		const bool hasValue = i + 1 < argc;
+		if (!std::strcmp(argv[i], "--warmup") && hasValue) config.warmup = std::atoi(argv[++i]);
+		else if (!std::strcmp(argv[i], "--reps") && hasValue) config.reps = std::atoi(argv[++i]);
+		else if (!std::strcmp(argv[i], "--cpu") && hasValue) config.cpu = std::atoi(argv[++i]);
+		else if (!std::strcmp(argv[i], "--filter") && hasValue) config.filter = argv[++i];
+		else if (!std::strcmp(argv[i], "--json") && hasValue) config.jsonPath = argv[++i];
+		else if (!std::strcmp(argv[i], "--label") && hasValue) label = argv[++i];
+		else {
+			std::fprintf(stderr, "unknown option %s\n"
+				"usage: th_bench [--warmup N] [--reps N] [--cpu N] [--filter name] [--json file] [--label name]\n", argv[i]);
+			return 1;
+		}
+	}
+	if (config.reps < 1) config.reps = 1;
+
+	esl::NullGL::load();
+	Bench bench(config);
+	if (config.cpu >= 0 && !bench.pinThread()) {
+		std::fprintf(stderr, "cannot pin to cpu %d, running unpinned\n", config.cpu);
+	}
+	std::printf("th_bench: warmup %d, reps %d, cpu %d\n", config.warmup, config.reps, config.cpu);
+
+	std::mt19937 rng(20240601u);
+	benchBullets(bench, rng);
+	benchMovement(bench);
+	benchCollision(bench, rng);
+	benchItems(bench, rng);
+	benchScripts(bench);
+
+	if (!config.jsonPath.empty() && !bench.writeJson(config.jsonPath, label)) return 1;
+	return 0;
+}
@@ -0,0 +1,87 @@
+﻿#pragma once
+#include<cstdint>
+#include<cstdio>
+#include<vector>
+#include"Profiler.hpp"
+
+namespace esl
+{
+	// 内存分配跟踪：定义 ESL_TRACK_ALLOCATIONS 编译时替换全局 operator new/delete，
+	// 统计每帧的分配次数与字节数，按分配发生时所在的 Profiler 区段归类，
+	// 并按调用栈汇总出分配最多的调用位置。
+	// 区段归类依赖 Profiler 的区段，开启跟踪时会同时开启 Profiler。
+	// 帧边界由 Profiler::frame() 驱动。
+	// 未定义该宏时接口照常可用，但不会记录任何分配
+	class AllocTracker
+	{
+	public:
+		static constexpr size_t MAX_ZONES = 64;		// 超出的区段计入最后一项
+		static constexpr size_t MAX_SITES = 4096;	// 超出的调用位置只计入总数
+		static constexpr int STACK_DEPTH = 8;		// 每个调用位置记录的栈帧数
+
+		enum class BudgetMode {
+			Off,	// 不检查
+			Warn,	// 超出时打印一行警告
+			Assert	// 超出时打印本帧各区段与调用位置后终止程序
+		};
+
+		struct Counter {
+			uint64_t allocations = 0;
+			uint64_t bytes = 0;
+		};
+		struct ZoneStats {
+			const char* name = nullptr;	// 不在任何区段内的分配为 "(no zone)"
+			Counter counter;
+		};
+		struct Site {
+			void* frames[STACK_DEPTH] = {};
+			int depth = 0;
+			Counter counter;
+		};
+
+		// 编译时是否替换了 operator new/delete
+		static bool available();
+		static void setEnabled(bool enabled);
+		static bool enabled();
+
+		// 帧边界，只在主线程调用（由 Profiler::frame() 调用）
+		static void frame();
+		// 上一帧的总计与各区段统计（按分配次数降序）
+		static Counter lastFrame();
+		static std::vector<ZoneStats> lastFrameZones();
+		// 开启以来的总计
+		static Counter total();
+		// 开启以来分配次数最多的 count 个调用位置
+		static std::vector<Site> topSites(size_t count);
+		static void reset();
+		// 打印上一帧各区段与最多的调用位置（调用位置尽量解析为函数名）
+		static void writeReport(std::FILE* file, size_t siteCount = 10);
+
+		// 每个 AllocBudgetScope 内允许的分配次数
+		static void setBudget(uint64_t allocations, BudgetMode mode);
+
+		// 由替换后的 operator new 调用
+		static void record(size_t bytes);
+	};
+
+	// 分配预算作用域：作用域内打开它的线程上的分配次数超过
+	// AllocTracker::setBudget 设置的预算时，按预算模式报告。
+	// 其他线程（工作线程、纹理解码、音频）的分配不计入，结果与线程调度无关
+	class AllocBudgetScope
+	{
+		const char* m_Name;
+		uint64_t m_Begin = 0;
+		bool m_Active;
+	public:
+		explicit AllocBudgetScope(const char* name);
+		~AllocBudgetScope();
+		AllocBudgetScope(const AllocBudgetScope&) = delete;
+		AllocBudgetScope& operator=(const AllocBudgetScope&) = delete;
+	};
+}
+
+#ifdef ESL_TRACK_ALLOCATIONS
+#define ESL_ALLOC_BUDGET(name) esl::AllocBudgetScope ESL_PROFILE_CONCAT(esl_alloc_budget_, __LINE__)(name)
+#else
+#define ESL_ALLOC_BUDGET(name) ((void)0)
+#endif
@@ -0,0 +1,55 @@
+﻿#pragma once
+#include<cstdint>
+#include<string>
+
+namespace esl
+{
+	// 资源包文件格式（由 tools/asset_packer 生成）：
+	//   AssetPackHeader | 各图片的 RGBA 像素块（16 字节对齐）| AssetPackEntry[entryCount] | 名字表
+	// 像素已按 stbi_set_flip_vertically_on_load(true) 的顺序翻转（自下而上逐行），可直接交给 glTexImage2D。
+	// 索引按名字字节序排序，名字为 AssetPack::normalize 处理后的相对路径，如 "assets/bullet/bullet1.png"
+	struct AssetPackHeader
+	{
+		char magic[4];			// "ESLP"
+		uint32_t version;
+		uint32_t entryCount;
+		uint32_t reserved;
+		uint64_t indexOffset;	// AssetPackEntry 数组
+		uint64_t namesOffset;	// 名字表
+	};
+	struct AssetPackEntry
+	{
+		uint64_t dataOffset;	// 像素块在文件中的位置
+		uint32_t nameOffset;	// 相对名字表
+		uint32_t nameLength;
+		uint32_t width;
+		uint32_t height;
+	};
+	static_assert(sizeof(AssetPackHeader) == 32, "AssetPackHeader layout");
+	static_assert(sizeof(AssetPackEntry) == 24, "AssetPackEntry layout");
+
+	// 运行时资源包：把打包好的文件映射进内存，纹理直接从映射中上传，省去 PNG 解码。
+	// 挂载后 Texture 和 TextureAtlas 按路径先在包中查找，找不到再从磁盘解码
+	class AssetPack
+	{
+	public:
+		static constexpr char MAGIC[4] = { 'E', 'S', 'L', 'P' };
+		static constexpr uint32_t VERSION = 1;
+
+		struct Image {
+			const unsigned char* pixels = nullptr;	// RGBA，指向映射内存，卸载前有效
+			int width = 0;
+			int height = 0;
+		};
+
+		// 挂载资源包，替换已挂载的包。文件不存在或格式不对时返回 false
+		static bool mount(const std::string& path);
+		static void unmount();
+		static bool mounted();
+		static uint32_t size();
+		static bool findImage(const std::string& path, Image& image);
+
+		// 统一路径写法：反斜杠换为斜杠，去掉开头的 "./"，ASCII 字母转为小写
+		static std::string normalize(const std::string& path);
+	};
+}
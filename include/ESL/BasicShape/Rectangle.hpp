@@ -11,7 +11,7 @@ namespace esl
 
 		void setSize(const glm::vec2& size);
 
-		// д߼
+		// 重写绘制逻辑
 		virtual void draw(float right, float top) override;
 
 	private:
@@ -1,4 +1,5 @@
 #pragma once
+#include <memory>
 #include "Shader.hpp"
 #include "Render.hpp"
 namespace esl
@@ -13,8 +14,8 @@ namespace esl
 		bool m_isShapeFilled = true;
 		float m_borderWidth = 2.f;
 		GLuint VAO = 0, VBO = 0, EBO = 0;
-		Shader* m_shapeShader = nullptr;
-		// ɫתı־
+		std::shared_ptr<Shader> m_shapeShader;
+		// 用于颜色反转的标志
 		bool m_InversionLayer = false;
 	public:
 		Shape();
@@ -8,7 +8,7 @@ namespace esl
 	class CharacterMap
 	{
 		std::unordered_map<char32_t, std::unique_ptr<Sprite>> m_CharacterMap;
-		std::unique_ptr<Texture> m_MapTexture;
+		std::shared_ptr<Texture> m_MapTexture;
 
 	protected:
 
@@ -17,7 +17,7 @@ namespace esl
 		CharacterMap(const std::string& filePath);
 		~CharacterMap();
 		void loadFromFile(const std::string& filePath);
-		void loadFromTexture(const esl::Texture& texture);
+		void loadFromTexture(std::shared_ptr<Texture> texture);
 		void bindCharacter(char32_t ch, glm::vec2 pos, glm::vec2 size);
 		void unbindCharacter(char32_t ch);
 		Sprite& getCharacterSprite(char32_t ch);
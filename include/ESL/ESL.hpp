@@ -1,8 +1,13 @@
-#pragma once
+﻿#pragma once
 #include <iostream>
 namespace esl
 {
 	void Initialize();
+	// 无窗口模式：GLFW 使用空平台，窗口不创建 OpenGL 上下文，gl* 调用进入 NullGL，
+	// AudioEngine 不打开音频设备。
+	// 用于没有显示器和 GPU 的机器上运行模拟，需代替 Initialize 调用
+	void InitializeHeadless();
+	bool IsHeadless();
 
 	void Terminate();
 
@@ -1,4 +1,4 @@
-#pragma once
+﻿#pragma once
 #include <iostream>
 #include "Mouse.hpp"
 #include "Keyboard.hpp"
@@ -20,6 +20,8 @@ namespace esl
 		bool isMouseReleased(Mouse::MouseButtonCode button);
 		Keyboard::KeyState getKeyState(Keyboard::KeyCode key);
 		Mouse::MouseState getMouseState(Mouse::MouseButtonCode button);
+		// 直接写入按键状态，供录像回放和无窗口模拟注入输入
+		void setKeyState(Keyboard::KeyCode key, Keyboard::KeyState state);
 	protected:
 		Mouse& getMouse();
 		Keyboard& getKeyboard();
@@ -0,0 +1,56 @@
+﻿#pragma once
+#include"glad/glad.h"
+#include<cstdint>
+#include"Profiler.hpp"
+
+namespace esl
+{
+	// GPU 计时：用 GL_TIME_ELAPSED 查询测量每个绘制阶段在 GPU 上的执行时间，
+	// 结果通过 Profiler::recordGpu 进入与 CPU 区段相同的统计、面板与 Chrome trace。
+	// 查询按帧轮换 FRAMES 组，读取的是 FRAMES - 1 帧之前的结果，
+	// 读取前先检查 GL_QUERY_RESULT_AVAILABLE，尚未完成的结果直接丢弃，CPU 从不等待 GPU。
+	// GL_TIME_ELAPSED 不能嵌套，已有区段在计时时新的区段被忽略。
+	// 只在 Profiler 开启时工作；Mesa 软件光栅化（llvmpipe）同样支持计时查询
+	class GpuProfiler
+	{
+	public:
+		static constexpr size_t FRAMES = 3;			// 同时在途的查询组数
+		static constexpr size_t MAX_ZONES = 32;		// 每帧最多的区段数
+
+		struct Stats {
+			uint64_t resolved = 0;	// 读到结果的区段数
+			uint64_t dropped = 0;	// 轮换回来时结果仍不可用而丢弃的区段数
+			uint64_t overflow = 0;	// 超过 MAX_ZONES 或嵌套而未计时的区段数
+		};
+
+		// 当前上下文是否支持计时查询
+		static bool supported();
+		// 开始计时，返回 false 表示本区段不计时（分析器关闭、嵌套或超出数量）
+		static bool beginZone(const char* name);
+		static void endZone();
+		// 帧结束（交换缓冲区之后）调用：读取已完成的旧查询并切换到下一组
+		static void frame();
+		// 在 GL 上下文销毁前释放查询对象
+		static void release();
+		static const Stats& stats();
+	};
+
+	// 作用域 GPU 区段，通常通过 ESL_PROFILE_GPU_ZONE 使用
+	class GpuZone
+	{
+		bool m_Active;
+	public:
+		explicit GpuZone(const char* name) : m_Active(GpuProfiler::beginZone(name)) {}
+		~GpuZone() { if (m_Active) GpuProfiler::endZone(); }
+		GpuZone(const GpuZone&) = delete;
+		GpuZone& operator=(const GpuZone&) = delete;
+	};
+}
+
+// 同时记录 CPU 区段 name 与 GPU 区段 "GPU name"，name 必须是字符串字面量
+#ifndef ESL_DISABLE_PROFILER
+#define ESL_PROFILE_GPU_ZONE(name) ESL_PROFILE_ZONE(name); \
+	esl::GpuZone ESL_PROFILE_CONCAT(esl_gpu_zone_, __LINE__)("GPU " name)
+#else
+#define ESL_PROFILE_GPU_ZONE(name) ((void)0)
+#endif
@@ -0,0 +1,83 @@
+﻿#pragma once
+#include<atomic>
+#include<condition_variable>
+#include<cstddef>
+#include<deque>
+#include<functional>
+#include<memory>
+#include<mutex>
+#include<thread>
+#include<vector>
+
+namespace esl
+{
+	// 一组任务的完成计数，wait 会一直等到计数归零
+	struct JobCounter
+	{
+		std::atomic<int> pending{ 0 };
+		bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+	};
+
+	// 任务系统：每个工作线程拥有自己的双端队列，从队尾取自己的任务，
+	// 空闲时从其他队列的队头窃取。提交任务的线程在 wait 时也会参与执行，
+	// 因此在只有一个核心（workerCount 为 0）时任务直接在调用线程上完成
+	class JobSystem
+	{
+	public:
+		using Job = std::function<void()>;
+
+		// workerCount 为 0 时取 硬件线程数 - 1
+		explicit JobSystem(unsigned workerCount = 0);
+		~JobSystem();
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		unsigned workerCount() const { return static_cast<unsigned>(m_Workers.size()); }
+
+		void submit(Job job, JobCounter* counter = nullptr);
+		// 等待 counter 归零，等待期间执行队列里的任务
+		void wait(JobCounter& counter);
+
+		// 把 [0, count) 切成每块 grain 个元素并行执行 fn(begin, end)，返回时全部完成。
+		// 块数为 1 时直接在调用线程上执行
+		template<typename Fn>
+		void parallelFor(size_t count, size_t grain, Fn&& fn)
+		{
+			if (count == 0) return;
+			if (grain == 0) grain = 1;
+			const size_t chunks = (count + grain - 1) / grain;
+			if (chunks == 1 || m_Workers.empty()) {
+				fn(size_t(0), count);
+				return;
+			}
+			JobCounter counter;
+			// 最后一块留给调用线程自己执行
+			for (size_t c = 0; c + 1 < chunks; ++c) {
+				const size_t begin = c * grain;
+				const size_t end = begin + grain;
+				submit([&fn, begin, end]() { fn(begin, end); }, &counter);
+			}
+			fn((chunks - 1) * grain, count);
+			wait(counter);
+		}
+
+	private:
+		struct Queue
+		{
+			std::mutex mutex;
+			std::deque<std::pair<Job, JobCounter*>> jobs;
+		};
+		// 下标 0 属于提交任务的外部线程，1..N 属于工作线程
+		std::vector<std::unique_ptr<Queue>> m_Queues;
+		std::vector<std::thread> m_Workers;
+		std::atomic<int> m_Queued{ 0 };
+		std::atomic<bool> m_Running{ true };
+		std::mutex m_SleepMutex;
+		std::condition_variable m_Wake;
+
+		void workerLoop(size_t index);
+		// 先取自己的队尾，再窃取其他队列的队头
+		bool runOne(size_t index);
+		size_t currentQueue() const;
+	};
+}
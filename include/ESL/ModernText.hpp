@@ -2,7 +2,9 @@
 #include <iostream>
 #include <Font.hpp>
 #include <Render.hpp>
+#include <ShaderLibrary.hpp>
 #include <map>
+#include <memory>
 
 namespace esl {
 
@@ -16,7 +18,7 @@ namespace esl {
             glm::ivec2 Bearing;
             GLuint Advance;
         };
-        Shader* shader = nullptr;
+        std::shared_ptr<Shader> shader;
         T text;
         std::map<typename T::value_type, Character> charMap;
         Font* font = nullptr;
@@ -0,0 +1,23 @@
+﻿#pragma once
+#include<cstdint>
+
+namespace esl
+{
+	// 空渲染后端：把 glad 的函数指针换成不做任何事的实现，
+	// 使全部渲染代码在没有显示器和 GPU 的机器上照常运行。
+	// 创建类函数返回递增的名字，编译/链接状态总是成功，uniform 位置总是 -1
+	class NullGL
+	{
+	public:
+		struct Stats {
+			uint64_t drawCalls = 0;		// glDraw* 调用次数
+			uint64_t instances = 0;		// 实例化绘制的实例数
+			uint64_t uploadBytes = 0;	// glBufferData/glBufferSubData/glTexImage2D 上传的字节数
+		};
+		// 安装空实现，之后所有 gl* 调用都进入这里
+		static void load();
+		static bool loaded();
+		static const Stats& stats();
+		static void resetStats();
+	};
+}
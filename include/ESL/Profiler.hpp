@@ -0,0 +1,87 @@
+﻿#pragma once
+#include<atomic>
+#include<cstdint>
+#include<string>
+#include<vector>
+
+namespace esl
+{
+	// 帧分析器：ProfileZone 在作用域开始和结束时取时间戳，
+	// 写入当前线程自己的环形缓冲区（单生产者，只需一次 release 存储，不加锁）。
+	// 主线程每帧调用 frame() 汇总各线程新增的区段，得到每个区段的每帧耗时，
+	// 保留最近 HISTORY 帧用于计算分位数；环形缓冲区中的原始区段可以导出为
+	// Chrome trace JSON（chrome://tracing 或 Perfetto 打开）。
+	// 默认关闭，关闭时每个区段只有一次原子读取的开销。
+	// 定义 ESL_DISABLE_PROFILER 可在编译期去掉所有区段宏
+	class Profiler
+	{
+	public:
+		static constexpr size_t RING_SIZE = 1 << 14;	// 每个线程保留的区段数
+		static constexpr size_t HISTORY = 240;			// 分位数统计的帧数
+
+		struct Zone {
+			const char* name = nullptr;	// 必须是字符串字面量或生命周期足够长的字符串
+			uint64_t begin = 0;			// 纳秒，相对分析器启动时刻
+			uint64_t end = 0;
+			uint32_t depth = 0;			// 嵌套深度，frame() 记录的整帧区段为 0
+		};
+
+		// 区段的每帧耗时（毫秒）
+		struct ZoneStats {
+			const char* name = nullptr;
+			uint32_t depth = 0;
+			double average = 0;
+			double p50 = 0, p95 = 0, p99 = 0, max = 0;
+		};
+
+		static void setEnabled(bool enabled);
+		static bool enabled() { return s_Enabled.load(std::memory_order_relaxed); }
+		static uint64_t now();
+
+		// 给当前线程命名，显示在 Chrome trace 中
+		static void setThreadName(const char* name);
+		// 当前线程最内层正在进行的区段名，没有时为 nullptr（分析器关闭时区段不生效）
+		static const char* currentZone();
+		static void record(const char* name, uint64_t begin, uint64_t end, uint32_t depth);
+		// 记录一段 GPU 耗时（由 GpuProfiler 在查询结果可用后调用，只在主线程调用）。
+		// 写入名为 "GPU" 的独立轨道，cpuBegin 是发出该段绘制命令时的 CPU 时间
+		static void recordGpu(const char* name, uint64_t cpuBegin, uint64_t gpuNanoseconds);
+
+		// 帧边界，只在主线程调用
+		static void frame();
+		// 各区段在最近 HISTORY 帧内的统计，按首次开始的时间排列（父区段在子区段之前）
+		static std::vector<ZoneStats> stats();
+		// 把各线程环形缓冲区中仍保留的区段写成 Chrome trace JSON
+		static bool writeChromeTrace(const std::string& path);
+		// 清空历史统计（环形缓冲区中的原始区段保留）
+		static void resetStats();
+
+	private:
+		static std::atomic<bool> s_Enabled;
+	};
+
+	// 作用域区段，通常通过 ESL_PROFILE_ZONE 使用
+	class ProfileZone
+	{
+		const char* m_Name;
+		const char* m_Parent = nullptr;
+		uint64_t m_Begin = 0;
+		uint32_t m_Depth = 0;
+		bool m_Active;
+	public:
+		explicit ProfileZone(const char* name);
+		~ProfileZone();
+		ProfileZone(const ProfileZone&) = delete;
+		ProfileZone& operator=(const ProfileZone&) = delete;
+	};
+}
+
+#define ESL_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ESL_PROFILE_CONCAT(a, b) ESL_PROFILE_CONCAT_IMPL(a, b)
+#ifndef ESL_DISABLE_PROFILER
+#define ESL_PROFILE_ZONE(name) esl::ProfileZone ESL_PROFILE_CONCAT(esl_profile_zone_, __LINE__)(name)
+#define ESL_PROFILE_FRAME() esl::Profiler::frame()
+#else
+#define ESL_PROFILE_ZONE(name) ((void)0)
+#define ESL_PROFILE_FRAME() ((void)0)
+#endif
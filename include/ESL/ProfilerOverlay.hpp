@@ -0,0 +1,29 @@
+﻿#pragma once
+#include<memory>
+#include<string>
+#include<Font.hpp>
+#include<ModernText.hpp>
+#include<Render.hpp>
+
+namespace esl
+{
+	// 在画面左上角显示 Profiler::stats() 的分析结果：
+	// 每个区段一行，按嵌套深度缩进，列出最近若干帧的平均值与 50/95/99 分位数（毫秒）。
+	// 下方两行是纹理缓存与着色器缓存的统计，开启 AllocTracker 时再列出上一帧分配最多的区段。
+	// 字体在第一次显示时才加载，隐藏时不产生任何开销
+	class ProfilerOverlay : public Renderable
+	{
+		static constexpr size_t ALLOC_ZONE_LINES = 6;
+		std::string m_FontPath;
+		std::unique_ptr<Font> m_Font;
+		std::unique_ptr<SText> m_Text;
+		bool m_Visible = false;
+		int m_FontSize = 16;
+	public:
+		explicit ProfilerOverlay(const std::string& fontPath);
+		void setVisible(bool visible);
+		bool isVisible() const { return m_Visible; }
+		void toggle() { setVisible(!m_Visible); }
+		void draw(float right, float top) override;
+	};
+}
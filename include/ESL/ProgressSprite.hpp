@@ -8,25 +8,19 @@ namespace esl
     public:
         enum class Type
         {
-            RADIAL,     // ԲΣ
-            HORIZONTAL, // ˮƽ
-            VERTICAL    // ֱ
+            RADIAL,     // 径向进度条（圆形）
+            HORIZONTAL, // 水平进度条
+            VERTICAL    // 垂直进度条
         };
 
     private:
         Type m_Type = Type::RADIAL;
         float m_Percentage = 0.0f; // 0.0 - 1.0
-        bool m_ReverseDirection = false; // Ƿ
-        Shader* m_ProgressShader = nullptr;
-
-        // ̬Դ
-        static Shader* s_SharedProgressShader;
-        static int s_InstanceCount;
-        static bool s_ProgressShaderInitialized;
-
-        // ʼ Shader
-        static void initializeProgressShader();
-        static void cleanupProgressShader();
+        bool m_ReverseDirection = false; // 是否反向
+        // 所有进度条共享同一个程序，由 ShaderLibrary 管理
+        std::shared_ptr<Shader> m_ProgressShader;
+        SpriteUniforms m_ProgressUniforms;
+        UniformHandle m_PercentageUniform, m_TypeUniform, m_ReverseUniform;
     public:
         ProgressSprite();
         ProgressSprite(Texture* texture);
@@ -0,0 +1,174 @@
+﻿#pragma once
+#include<cstdint>
+#include<functional>
+#include<list>
+#include<memory>
+#include<string>
+#include<unordered_map>
+#include"Texture.hpp"
+
+namespace esl
+{
+	// 按键（通常是路径）共享的资源缓存：acquire 返回 shared_ptr 句柄，同一个键只加载一次。
+	// 最后一个句柄释放后资源不会立即销毁，而是进入最近释放列表，再次 acquire 时直接复用；
+	// 列表中资源的总大小超过预算时，从最早释放的开始销毁。
+	// 缓存先于句柄销毁时，剩下的句柄释放时各自销毁资源。
+	// 不是线程安全的，纹理缓存只能在 OpenGL 上下文线程上使用
+	template<typename T>
+	class ResourceCache
+	{
+	public:
+		using Handle = std::shared_ptr<T>;
+		// 估算资源占用的字节数，用于预算
+		using SizeOf = std::function<size_t(const T&)>;
+
+		struct Stats {
+			uint64_t hits = 0;			// 资源仍在使用，直接共享
+			uint64_t revivals = 0;		// 从最近释放列表中复用
+			uint64_t misses = 0;		// 需要加载
+			uint64_t evictions = 0;		// 因超出预算被销毁
+			size_t live = 0;			// 正在使用的资源数
+			size_t released = 0;		// 最近释放列表中的资源数
+			size_t releasedBytes = 0;
+		};
+
+		ResourceCache(SizeOf sizeOf, size_t budgetBytes)
+			:m_State(std::make_shared<State>())
+		{
+			m_State->sizeOf = std::move(sizeOf);
+			m_State->budget = budgetBytes;
+		}
+		~ResourceCache()
+		{
+			// 仍在使用的资源交给句柄销毁
+			for (auto& pair : m_State->entries) {
+				if (!pair.second.released) pair.second.resource.release();
+			}
+		}
+		ResourceCache(const ResourceCache&) = delete;
+		ResourceCache& operator=(const ResourceCache&) = delete;
+
+		// 返回 key 对应的资源，没有时调用 load() 创建。load 返回空指针时不缓存，返回空句柄
+		template<typename Load>
+		Handle acquire(const std::string& key, Load&& load)
+		{
+			State& state = *m_State;
+			auto it = state.entries.find(key);
+			if (it != state.entries.end()) {
+				Entry& entry = it->second;
+				if (!entry.released) {
+					state.stats.hits++;
+					return entry.handle.lock();
+				}
+				state.stats.revivals++;
+				state.lru.erase(entry.lru);
+				entry.released = false;
+				state.stats.released--;
+				state.stats.releasedBytes -= entry.bytes;
+				return makeHandle(it->first, entry);
+			}
+			state.stats.misses++;
+			std::unique_ptr<T> resource = load();
+			if (!resource) return nullptr;
+			Entry& entry = state.entries[key];
+			entry.bytes = state.sizeOf ? state.sizeOf(*resource) : 0;
+			entry.resource = std::move(resource);
+			return makeHandle(key, entry);
+		}
+
+		void setBudget(size_t bytes)
+		{
+			m_State->budget = bytes;
+			m_State->trim();
+		}
+		size_t budget() const { return m_State->budget; }
+		// 销毁最近释放列表中的全部资源
+		void purge()
+		{
+			size_t budget = m_State->budget;
+			m_State->budget = 0;
+			m_State->trim();
+			m_State->budget = budget;
+		}
+		const Stats& stats() const { return m_State->stats; }
+		// 只清零计数，不影响 live/released
+		void resetCounters()
+		{
+			Stats& stats = m_State->stats;
+			stats.hits = stats.revivals = stats.misses = stats.evictions = 0;
+		}
+
+	private:
+		struct Entry {
+			std::unique_ptr<T> resource;
+			std::weak_ptr<T> handle;
+			size_t bytes = 0;
+			bool released = false;
+			typename std::list<std::string>::iterator lru;
+		};
+		struct State {
+			std::unordered_map<std::string, Entry> entries;
+			std::list<std::string> lru;		// 最近释放的在前
+			SizeOf sizeOf;
+			size_t budget = 0;
+			Stats stats;
+
+			void release(const std::string& key)
+			{
+				Entry& entry = entries.at(key);
+				entry.released = true;
+				lru.push_front(key);
+				entry.lru = lru.begin();
+				stats.live--;
+				stats.released++;
+				stats.releasedBytes += entry.bytes;
+				trim();
+			}
+			void trim()
+			{
+				while (stats.releasedBytes > budget && !lru.empty()) {
+					auto it = entries.find(lru.back());
+					lru.pop_back();
+					stats.released--;
+					stats.releasedBytes -= it->second.bytes;
+					stats.evictions++;
+					entries.erase(it);
+				}
+			}
+		};
+		// 句柄的删除器：缓存还在时把资源放回最近释放列表，否则直接销毁
+		struct Releaser {
+			std::weak_ptr<State> state;
+			std::string key;
+			void operator()(T* resource) const
+			{
+				if (auto owner = state.lock()) owner->release(key);
+				else delete resource;
+			}
+		};
+		std::shared_ptr<State> m_State;
+
+		Handle makeHandle(const std::string& key, Entry& entry)
+		{
+			Handle handle(entry.resource.get(), Releaser{ m_State, key });
+			entry.handle = handle;
+			m_State->stats.live++;
+			return handle;
+		}
+	};
+
+	// 全局纹理缓存，键为规范化的路径加上环绕与过滤方式
+	class TextureCache
+	{
+	public:
+		static constexpr size_t DEFAULT_BUDGET = 128u << 20;
+
+		static std::shared_ptr<Texture> get(const std::string& path,
+			Texture::Wrap wrap = Texture::Wrap::REPEAT, Texture::Filter filter = Texture::Filter::LINEAR);
+		static ResourceCache<Texture>& cache();
+		// 销毁未在使用的纹理，需在 OpenGL 上下文销毁前调用
+		static void purge();
+		// 一行统计，例如 "textures: 40 live, 12 cached (9.5 MiB), 130 hits, 12 reused, 52 loads"
+		static std::string summary();
+	};
+}
@@ -1,8 +1,11 @@
-#pragma once
+﻿#pragma once
 #include<iostream>
+#include<memory>
 #include<string>
 #include<fstream>
 #include<sstream>
+#include<vector>
+#include<unordered_map>
 
 #include"glm/glm.hpp"
 #include"glm/gtc/matrix_transform.hpp"
@@ -12,14 +15,55 @@ namespace esl
 {
     typedef unsigned int uint;
     typedef unsigned int GLuint;
+    // 预先解析好的 uniform 位置，热路径上用它代替名字，避免字符串构造和驱动查询
+    class UniformHandle {
+        int m_Location = -1;
+        explicit UniformHandle(int location) : m_Location(location) {}
+        friend class Shader;
+    public:
+        UniformHandle() = default;
+        bool valid() const { return m_Location >= 0; }
+        int location() const { return m_Location; }
+    };
     class Shader {
         uint m_Program = 0;
+        bool m_Linked = false;
+        // 链接后通过 glGetActiveUniform 填充的 名字 -> 位置 表
+        mutable std::unordered_map<std::string, int> m_Locations;
+        // 每个位置上最近一次上传的值，相同的值不再重复上传
+        struct UniformState {
+            float data[16];
+            bool valid = false;
+        };
+        mutable std::vector<UniformState> m_Shadow;
+        Shader() = default;
+        void link(const char* vShaderCode, const char* fShaderCode);
+        void introspect();
+        int location(const std::string& name) const;
+        // 与上次上传的值相同时返回 false，否则记录新值并返回 true
+        bool changed(int location, const void* data, size_t bytes) const;
     public:
         explicit Shader(const char* vertexPath, const char* fragmentPath);
         explicit Shader(const std::string& vertexCode, const std::string& fragmentCode);
         ~Shader();
+        Shader(const Shader&) = delete;
+        Shader& operator=(const Shader&) = delete;
+        // 由 getBinary 取得的程序二进制创建，驱动不接受时返回空
+        static std::shared_ptr<Shader> fromBinary(uint format, const void* data, int length);
+        // 取出链接好的程序二进制，驱动不支持或未链接成功时返回 false
+        bool getBinary(uint& format, std::vector<char>& data) const;
+        bool linked() const { return m_Linked; }
         void load();
         void unload();
+        UniformHandle getUniform(const std::string& name) const;
+        // 以下 set 需要在 load() 之后调用
+        void set(UniformHandle handle, bool value) const;
+        void set(UniformHandle handle, int value) const;
+        void set(UniformHandle handle, float value) const;
+        void set(UniformHandle handle, const glm::vec2& value) const;
+        void set(UniformHandle handle, const glm::vec3& value) const;
+        void set(UniformHandle handle, const glm::vec4& value) const;
+        void set(UniformHandle handle, const glm::mat4& value) const;
         void setBool(const std::string& name, bool value) const;
         void setInt(const std::string& name, int value) const;
         void setFloat(const std::string& name, float value) const;
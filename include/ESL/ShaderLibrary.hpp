@@ -0,0 +1,48 @@
+﻿#pragma once
+#include<cstdint>
+#include<memory>
+#include<string>
+#include<unordered_map>
+#include"Shader.hpp"
+
+namespace esl
+{
+	// 全局着色器程序缓存：相同源码（或相同名字）的程序只编译链接一次，
+	// 以 shared_ptr 形式分发给所有使用者。
+	// 开启二进制缓存后，链接好的程序二进制按源码与驱动（厂商、渲染器、版本）写入磁盘，
+	// 下次启动直接由 glProgramBinary 载入；驱动拒绝时重新编译并覆盖缓存文件
+	class ShaderLibrary
+	{
+	public:
+		struct BinaryCacheStats {
+			uint32_t hits = 0;		// 由磁盘二进制载入
+			uint32_t misses = 0;	// 没有缓存文件，编译链接
+			uint32_t rejected = 0;	// 缓存文件无效或被驱动拒绝，已重新编译
+			uint32_t stored = 0;	// 写入磁盘的程序数
+		};
+	private:
+		// 键为顶点与片段着色器源码拼接后的字符串，由 unordered_map 按哈希查找
+		static std::unordered_map<std::string, std::shared_ptr<Shader>> s_Programs;
+		static std::unordered_map<std::string, std::shared_ptr<Shader>> s_Named;
+	public:
+		// 按源码获取程序，不存在时编译
+		static std::shared_ptr<Shader> get(const std::string& vertexCode, const std::string& fragmentCode);
+		// 按名字获取程序，首次使用时以给定源码编译并登记
+		static std::shared_ptr<Shader> get(const std::string& name, const std::string& vertexCode, const std::string& fragmentCode);
+		// 按名字查找已登记的程序，不存在时返回空
+		static std::shared_ptr<Shader> find(const std::string& name);
+		// 已缓存的程序数量
+		static size_t size();
+		// 释放不再被任何对象引用的程序
+		static void purge();
+		// 清空缓存，需在 OpenGL 上下文销毁前调用
+		static void clear();
+
+		// 设置程序二进制缓存目录（不存在时创建），空字符串关闭。需在 OpenGL 上下文创建后调用，
+		// 驱动不支持任何二进制格式时不开启，返回 false
+		static bool setBinaryCache(const std::string& directory);
+		static const BinaryCacheStats& binaryCacheStats();
+		// 一行统计，例如 "shaders: 12 programs, binary cache 11 hits, 1 misses, 0 rejected"
+		static std::string summary();
+	};
+}
@@ -1,11 +1,13 @@
 #pragma once
 #include<iostream>
+#include<memory>
 #include"Texture.hpp"
 #include"Shader.hpp"
 #include"Render.hpp"
 namespace esl
 {
 	typedef unsigned int GLuint;
+	struct TextureRegion;
 	class Sprite : public Renderable
 	{
 	private:
@@ -14,33 +16,49 @@ namespace esl
 		float m_Rotation = 0;
 		glm::vec2 m_Origin = glm::vec2(0.f, 0.f);
 		Texture* m_Texture = nullptr;
-		Shader* m_Shader = nullptr;
+		std::shared_ptr<Shader> m_Shader;
+		// m_Shader 中每帧都要设置的 uniform，更换着色器后需重新调用 resolveUniforms
+		struct SpriteUniforms {
+			UniformHandle projection, view, transform, spriteColor, uvScale, uvRect;
+		} m_Uniforms;
+		void resolveUniforms();
 		glm::vec3 m_Position = glm::vec3(0.f, 0.f, 0.f);
 		glm::vec2 m_Size = glm::vec2(0.f, 0.f);
 		glm::vec4 m_Color = glm::vec4(1.f, 1.f, 1.f, 1.f);
+		// 指向所有精灵共享的单位四边形，纹理区域通过 uvRect uniform 传入
 		uint m_VAO = 0;
-		uint m_VBO = 0;
-		uint m_EBO = 0;
+		static uint s_QuadVAO, s_QuadVBO, s_QuadEBO;
+		static uint sharedQuad();
 		glm::vec2 m_Scale = glm::vec2(1.f, 1.f);
 		glm::vec2 m_RectScale = glm::vec2(1.f, 1.f);
 		glm::vec2 m_RepeatScale = glm::vec2(1.f, 1.f);
+		//纹理区域 u1, v1, u2, v2
+		glm::vec4 m_TexRect = glm::vec4(0.f, 0.f, 1.f, 1.f);
+		// 使用图集区域时，setTextureRect 的坐标相对于该区域；尺寸为 0 表示整张纹理
+		glm::vec2 m_RegionOffset = glm::vec2(0.f, 0.f);
+		glm::vec2 m_RegionSize = glm::vec2(0.f, 0.f);
 		//border
 		glm::vec4 m_BorderColor = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
 		float m_BorderWidthPixels = 5.f;
 		bool m_ShowBorder = false;
 		GLuint m_BorderVAO, m_BorderVBO, m_BorderEBO;
-		Shader* m_BorderShader;
+		std::shared_ptr<Shader> m_BorderShader;
 		void setUpBorder();
-		//ProgressSpriteṩӿ
+		//给ProgressSprite提供接口
 		void bindTexture(){ m_Texture->bind(); }
 		bool m_available = true;
 		
 	public:
 		Sprite();
 		Sprite(Texture* texture);
+		Sprite(const TextureRegion& region);
+		// 释放共享的四边形，需在 OpenGL 上下文销毁前调用
+		static void releaseSharedQuad();
 		void setup();
 		void setPosition(glm::vec2 pos);
 		void setTexture(Texture* texture);
+		// 使用图集中的一块区域，之后的 setTextureRect 以该区域左下角为原点
+		void setTextureRegion(const TextureRegion& region);
 		void setRotation(float angle);
 		void setColor(glm::vec4 rgba_float);
 		void setColor(glm::uvec4 rgba_int);
@@ -67,5 +85,6 @@ namespace esl
 		virtual void draw(float right, float top)override;
 		void drawBorder(float right, float top);
 		friend class Window;
+		friend class SpriteBatch;
 	};
 }
@@ -9,6 +9,9 @@ namespace esl
 		float m_FogStart = 100.0f;
 		float m_FogEnd = 500.0f;
 		glm::vec4 m_FogColor = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+		struct FogUniforms {
+			UniformHandle cameraPos, fogEnabled, fogStart, fogEnd, fogColor;
+		} m_FogUniforms;
 		void setupFogShader();
 	protected:
 		glm::vec3 m_Rotation3D = glm::vec3(1.f, 1.f, 1.f);
@@ -30,11 +33,11 @@ namespace esl
 		void setRotation(float) = delete;
 		void setOrigin(glm::vec2) = delete;
 		void move(glm::vec2) = delete;
-		// Ч
+		// 设置雾效开关
 		void setFogEnabled(bool enabled);
-		// Ч뷶Χ (start: ʼ, end: ȫ)
+		// 设置雾效距离范围 (start: 开始渐变距离, end: 完全雾化距离)
 		void setFogDistance(float start, float end);
-		// Чɫ (֧ alpha)
+		// 设置雾效颜色 (支持 alpha)
 		void setFogColor(glm::vec4 color);
 	protected:
 		virtual void draw(float right, float top)override;
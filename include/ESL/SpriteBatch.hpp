@@ -0,0 +1,70 @@
+﻿#pragma once
+#include<iostream>
+#include<vector>
+#include<cstddef>
+#include<memory>
+#include"Texture.hpp"
+#include"Shader.hpp"
+#include"Render.hpp"
+namespace esl
+{
+	class Sprite;
+	// 实例化批量绘制：每帧收集精灵的实例数据，按 纹理/混合方式 分组，
+	// 一次上传到同一个实例缓冲，每组只调用一次 glDrawElementsInstancedBaseInstance
+	class SpriteBatch : public Renderable
+	{
+	public:
+		enum class Blend {
+			ALPHA,		//普通透明混合
+			ADDITIVE,	//叠加混合
+		};
+		struct Instance {
+			glm::vec2 translation;	//旋转中心修正后的位置
+			float rotation;			//弧度
+			glm::vec2 scale;		//最终像素尺寸
+			glm::vec4 uvRect;		//u1, v1, u2, v2
+			glm::vec4 color;
+			glm::vec2 motion = { 0.f, 0.f };	//上一逻辑步到本步的位移，用于插值
+		};
+	private:
+		struct Group {
+			Texture* texture = nullptr;
+			Blend blend = Blend::ALPHA;
+			std::vector<Instance> instances;
+		};
+		std::vector<Group> m_Groups;
+		size_t m_LastGroup = 0;
+		std::vector<Instance> m_Staging;
+		uint m_VAO = 0;
+		uint m_QuadVBO = 0;
+		uint m_EBO = 0;
+		uint m_InstanceVBO = 0;
+		size_t m_Capacity = 0;
+		std::shared_ptr<Shader> m_Shader;
+		UniformHandle m_ProjectionUniform;
+		UniformHandle m_SamplerUniform;
+		UniformHandle m_AlphaUniform;
+		float m_Alpha = 1.f;
+		Group& group(Texture* texture, Blend blend);
+		void reserveInstances(size_t count);
+	public:
+		SpriteBatch(size_t capacity = 1024);
+		~SpriteBatch();
+		SpriteBatch(const SpriteBatch&) = delete;
+		SpriteBatch& operator=(const SpriteBatch&) = delete;
+		// 清空上一帧收集的实例（保留已分配的内存）
+		void begin();
+		void add(Texture* texture, const Instance& instance, Blend blend = Blend::ALPHA);
+		// 一次添加 count 个同一纹理的实例（例如其他线程预先整理好的实例数据）
+		void add(Texture* texture, const Instance* instances, size_t count, Blend blend = Blend::ALPHA);
+		// 按精灵当前的位置、旋转、缩放、纹理区域和颜色添加一个实例，
+		// motion 为精灵在上一逻辑步中的位移
+		void add(const Sprite& sprite, Blend blend = Blend::ALPHA, glm::vec2 motion = glm::vec2(0.f, 0.f));
+		// 绘制位置 = translation - motion * (1 - alpha)，alpha 为 1 时即当前位置
+		void setInterpolation(float alpha);
+		size_t size() const;
+	protected:
+		// 通过 Window::draw 提交
+		virtual void draw(float right, float top)override;
+	};
+}
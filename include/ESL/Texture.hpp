@@ -10,6 +10,7 @@ namespace esl
 		int m_Width = 0;
 		int m_Height = 0;
 		int m_Channel = 0;
+		bool m_Loading = false;	// 由 TextureLoader 异步加载，尚未上传完毕
 		struct Size {
 			int w;
 			int h;
@@ -18,26 +19,36 @@ namespace esl
 		
 	public:
 		enum class Filter {
-			LINEAR, //Թ
-			NEAREST, //ڹ
+			LINEAR, //线性过滤
+			NEAREST, //最近邻过滤
 		};
 		enum class Wrap {
-			REPEAT,	//곬[0,1]Χʱظ
-			MIRRORED_REPEAT, //곬[0,1]Χʱظ
-			CLAMP_TO_EDGE, //곬[0,1]ΧʱʹԵɫ
-			CLAMP_TO_BORDER //곬ȡ߽ɫ
+			REPEAT,	//纹理坐标超出[0,1]范围时，重复纹理
+			MIRRORED_REPEAT, //纹理坐标超出[0,1]范围时，镜像重复纹理
+			CLAMP_TO_EDGE, //当纹理坐标超出[0,1]范围时，会使用纹理边缘的颜色
+			CLAMP_TO_BORDER //纹理坐标超出部分取边界颜色
 		};
 		Texture(const char* path, Wrap wrap = Wrap::REPEAT, Filter filter = Filter::LINEAR);
 		Texture(const std::string& path, Wrap wrap = Wrap::REPEAT, Filter filter = Filter::LINEAR);
 		Texture(uint glfwTextureID, uint width, uint height);
+		// 由 RGBA 像素创建纹理，像素自下而上逐行存放（与 stbi 翻转加载后的顺序一致）
+		Texture(const uchar* pixels, int width, int height, Wrap wrap = Wrap::CLAMP_TO_EDGE, Filter filter = Filter::LINEAR);
 		~Texture();
-		Size getSize();
+		// 纹理对象只能有一个所有者，需要共享时使用 TextureCache
+		Texture(const Texture&) = delete;
+		Texture& operator=(const Texture&) = delete;
+		Size getSize() const;
+		// 异步加载的纹理在上传完毕前为 false，此时绘制出来是透明的
+		bool ready() const { return !m_Loading; }
 	private:
+		static void setParameters(Wrap wrap, Filter filter);
 		void bind();
 		int getWidth() const;
 		int getHeight() const;
 		int getChannel()const;
 		friend class Sprite;
 		friend class Sprite3D;
+		friend class SpriteBatch;
+		friend class TextureLoader;
 	};
 }
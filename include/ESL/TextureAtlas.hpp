@@ -0,0 +1,72 @@
+﻿#pragma once
+#include<memory>
+#include<string>
+#include<unordered_map>
+#include<vector>
+#include<glm/glm.hpp>
+#include"Texture.hpp"
+
+namespace esl
+{
+	// 图集中的一块区域。坐标与 Sprite::setTextureRect 相同（像素，原点在纹理左下角）
+	struct TextureRegion
+	{
+		Texture* texture = nullptr;
+		glm::vec2 offset = glm::vec2(0.f, 0.f);	// 源图片左下角在图集纹理中的位置
+		glm::vec2 size = glm::vec2(0.f, 0.f);	// 源图片尺寸
+		explicit operator bool() const { return texture != nullptr; }
+	};
+
+	// 纹理图集：把多张源图片用 skyline 算法打包进一张或几张大纹理，
+	// 使来自不同图片的精灵可以合并进同一个批次绘制。
+	// 每张图片四周留出 padding 像素并用边缘像素填充，线性过滤时不会采样到相邻图片。
+	// 对精灵调用 Sprite::setTextureRegion 后，setTextureRect 仍使用源图片内的坐标。
+	// 打包结果可以缓存到磁盘，源图片的大小或修改时间变化后缓存自动失效
+	class TextureAtlas
+	{
+	public:
+		explicit TextureAtlas(int pageSize = 2048, int padding = 2, Texture::Filter filter = Texture::Filter::LINEAR);
+		~TextureAtlas();
+		TextureAtlas(const TextureAtlas&) = delete;
+		TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+		// 登记一张源图片，在 build 之前调用
+		void add(const std::string& name, const std::string& path);
+		// 打包全部源图片并创建纹理。cachePath 不为空时先尝试读取缓存，
+		// 缓存无效则重新打包并写入缓存。有图片加载失败或放不下时返回 false，其余图片照常可用
+		bool build(const std::string& cachePath = "");
+
+		// 找不到时返回空区域
+		const TextureRegion& region(const std::string& name) const;
+		bool contains(const std::string& name) const;
+		size_t pageCount() const { return m_Pages.size(); }
+		Texture* page(size_t index) const { return m_Pages[index].get(); }
+
+	private:
+		struct Source {
+			std::string name;
+			std::string path;
+		};
+		struct Placement {
+			int page = -1;	// -1 表示未能放入
+			int x = 0, y = 0, w = 0, h = 0;
+		};
+		struct PageImage {
+			int width = 0, height = 0;
+			std::vector<uchar> pixels;	// RGBA，自下而上逐行存放
+		};
+
+		int m_PageSize;
+		int m_Padding;
+		Texture::Filter m_Filter;
+		std::vector<Source> m_Sources;
+		std::vector<TextureRegion> m_Regions;
+		std::unordered_map<std::string, size_t> m_Index;
+		std::vector<std::unique_ptr<Texture>> m_Pages;
+
+		bool pack(std::vector<Placement>& placements, std::vector<PageImage>& pages) const;
+		void createPages(const std::vector<Placement>& placements, const std::vector<PageImage>& pages);
+		bool loadCache(const std::string& path, std::vector<Placement>& placements, std::vector<PageImage>& pages) const;
+		void writeCache(const std::string& path, const std::vector<Placement>& placements, const std::vector<PageImage>& pages) const;
+	};
+}
@@ -0,0 +1,39 @@
+﻿#pragma once
+#include<cstddef>
+#include<string>
+#include"Texture.hpp"
+
+namespace esl
+{
+	// 异步纹理加载：开启后 Texture(path) 只读取图片头得到尺寸，立即返回一张透明的 1x1 占位纹理，
+	// 解码交给工作线程，解码完成的图片在 update 中按时间预算分段上传到新的纹理对象，
+	// 全部上传完成后再替换占位纹理，因此不会显示上传了一半的图片。
+	// Texture 对象本身和尺寸不变，精灵等持有的指针照常可用，就绪前绘制出来是透明的。
+	// 除工作线程内的解码外，全部接口只能在 OpenGL 上下文所在的线程调用
+	class TextureLoader
+	{
+	public:
+		static constexpr unsigned DEFAULT_WORKERS = 2;
+		static constexpr double DEFAULT_BUDGET_MS = 2.0;	// 每帧用于上传的时间
+
+		// 启动解码线程，之后创建的纹理都异步加载
+		static void start(unsigned workerCount = DEFAULT_WORKERS);
+		// 等待进行中的解码并丢弃未上传的图片，仍在加载的纹理保留占位内容
+		static void stop();
+		static bool active();
+
+		// 每帧调用一次，上传已解码的图片，耗时超过 budgetMs 后留到下一帧（每帧至少上传一段）
+		static void update(double budgetMs = DEFAULT_BUDGET_MS);
+		// 等待全部解码并上传完毕
+		static void finish();
+		// 尚未就绪的纹理数
+		static size_t pending();
+
+	private:
+		// 由 Texture(path) 调用：读不到图片头时返回 false，由调用者按同步方式加载并报告错误
+		static bool request(Texture* texture, const std::string& path, Texture::Wrap wrap, Texture::Filter filter);
+		// 由 ~Texture 调用
+		static void cancel(Texture* texture);
+		friend class Texture;
+	};
+}
@@ -0,0 +1,39 @@
+﻿#pragma once
+#include<atomic>
+#include<cstdint>
+
+namespace esl
+{
+	// 无锁三缓冲：一个生产者线程写 back() 后 publish()，一个消费者线程 acquire() 后读取。
+	// 三个槽位分别归生产者、消费者和中转所有，交换只是一次原子 exchange，
+	// 双方都不会等待对方；消费者总是拿到最近一次发布的完整数据，过时的帧被直接覆盖
+	template<typename T>
+	class TripleBuffer
+	{
+		static constexpr uint8_t INDEX_MASK = 0x3;
+		static constexpr uint8_t FRESH = 0x4;	// 中转槽里有消费者尚未取走的新数据
+
+		T m_Slots[3];
+		uint8_t m_Back = 0;						// 只由生产者访问
+		uint8_t m_Front = 2;					// 只由消费者访问
+		std::atomic<uint8_t> m_Middle{ 1 };
+	public:
+		// 生产者：当前可写的槽位，内容是更早某一帧的数据，可复用其内存
+		T& back() { return m_Slots[m_Back]; }
+		// 生产者：发布 back() 中写好的数据，并换到另一个槽位继续写
+		void publish()
+		{
+			m_Back = m_Middle.exchange(m_Back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+		}
+		// 消费者：有新数据时换入，返回最近一次发布的数据
+		const T& acquire()
+		{
+			if (m_Middle.load(std::memory_order_relaxed) & FRESH) {
+				m_Front = m_Middle.exchange(m_Front, std::memory_order_acq_rel) & INDEX_MASK;
+			}
+			return m_Slots[m_Front];
+		}
+		// 消费者：上一次 acquire 得到的数据
+		const T& front() const { return m_Slots[m_Front]; }
+	};
+}
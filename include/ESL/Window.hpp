@@ -14,8 +14,9 @@ namespace esl
     class Cursor;
     class Event;
     class Text;
-    class TextM;  // TextMǰ
+    class TextM;  // 添加TextM前向声明
     class Shape;
+    class SpriteBatch;
     
     class Window : public RenderTarget
     {
@@ -25,6 +26,10 @@ namespace esl
         bool m_Vsync = false;
         double m_LastFrameTime = 0;
         double m_TimePerFrame = 0;
+        bool m_Headless = false;    // 由 InitializeHeadless 创建，没有 OpenGL 上下文
+        // 逻辑步之间的插值：alpha 为距上一次逻辑步的时间占步长的比例
+        bool m_Interpolation = true;
+        float m_InterpolationAlpha = 1.0f;
         Event m_Event;
         Cursor m_Cursor;
         static void KeyEventCallback(GLFWwindow* window, int key, int scancode, int action, int modes);
@@ -52,10 +57,19 @@ namespace esl
         void setFramerateLimit(double framerate);
         virtual void draw(Renderable& renderObject);
         void draw(Text& text);
+        // 按当前插值系数绘制实例化批次
+        void draw(SpriteBatch& batch);
+        // 在相邻两个逻辑步的状态之间插值绘制，适合高刷新率显示器
+        void setInterpolation(bool enable);
+        bool getInterpolation() const;
+        void setInterpolationAlpha(float alpha);
+        // 关闭插值时始终为 1（即绘制最新的逻辑状态）
+        float getInterpolationAlpha() const;
         void setCursorStyle(Cursor::Style style);
         void setCursorIcon(const char* iconPath);
         void setCursorState(Cursor::State state);
         void setWindowIcon(const char* iconPath);
         GLFWwindow* getWindowHandle();
+        bool isHeadless() const { return m_Headless; }
     };
 }
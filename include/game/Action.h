@@ -6,19 +6,20 @@
 #include <Window.hpp>
 #include "MovementState.h"
 #include "MovementUpdater.h"
-#include "Bullet.h"  //  Bullet ͷļʹ BulletLinearMovement
+#include "Bullet.h"  // 引入 Bullet 头文件以使用 BulletLinearMovement
+#include "BulletWorld.h"
 
 class Enemy;
 class Action {
 public:
     virtual ~Action() = default;
-    virtual bool update(double deltaTime) = 0; // trueʾ¼
+    virtual bool update(double deltaTime) = 0; // 返回true表示事件完成
     virtual void apply(class Enemy* enemy) = 0;
 };
 
 
 class MovementAction : public Action {
-    std::function<glm::vec2(double)> mTrajectoryFunc; // 켣
+    std::function<glm::vec2(double)> mTrajectoryFunc; // 轨迹函数
     double mDuration;
     double mElapsedTime = 0;
 public:
@@ -37,32 +38,31 @@ public:
     void apply(Enemy* enemy);
 };
 
-// ========== Ļϵͳ ==========
+// ========== 弹幕系统 ==========
 
-// ӵ
+// 子弹配置
 struct BulletConfig {
-    int type = 2;           // ӵ
-    int color = 1;          // ӵɫ
-    float baseAngle = 0;    // Ƕ
-    float baseSpeed = 200;  // ٶ
+    int type = 2;           // 子弹类型
+    int color = 1;          // 子弹颜色
+    float baseAngle = 0;    // 基础角度
+    float baseSpeed = 200;  // 基础速度
 };
 
-// ģʽö
+// 发射模式枚举
 enum class DanmakuPattern {
-    LINEAR,     // ֱߣ
-    CIRCLE,     // 
-    FAN,        // 
-    RANDOM,     // 
-    SPIRAL      // 
+    LINEAR,     // 直线（单发或连发）
+    CIRCLE,     // 环形
+    FAN,        // 扇形
+    RANDOM,     // 随机
+    SPIRAL      // 螺旋
 };
 
-// ǰ
-class Bullet;
+// 子弹运动 Action：作用于 BulletWorld 中下标为 index 的子弹
 class BulletMovementAction {
 public:
     virtual ~BulletMovementAction() = default;
     virtual bool update(double deltaTime) = 0;
-    virtual void apply(Bullet* bullet) = 0;
+    virtual void apply(BulletWorld& world, size_t index) = 0;
 };
 using pBulletMovementAction = std::unique_ptr<BulletMovementAction>;
 
@@ -83,59 +83,62 @@ public:
     }
 
     bool update(double deltaTime) override;
-    void apply(Bullet* bullet) override;
+    void apply(BulletWorld& world, size_t index) override;
 };
 
 
-// Ļ Action - һӵ
+// 弹幕 Action - 负责发射一组子弹
 class DanmakuAction : public Action {
 private:
-    // 
+    // 基础配置
     BulletConfig mBulletConfig;
     DanmakuPattern mPattern = DanmakuPattern::LINEAR;
 
-    // 
-    int mBulletCount = 1;           // ÿηӵ
-    int mRounds = 1;                // -1ʾޣ
-    double mRoundInterval = 1.0;    // ִμ
+    // 发射参数
+    int mBulletCount = 1;           // 每次发射的子弹数量
+    int mRounds = 1;                // 发射轮数（-1表示无限）
+    double mRoundInterval = 1.0;    // 轮次间隔
     double mElapsedTime = 0;
     int mCurrentRound = 0;
     double mLastShootTime = 0;
-    bool mUsePlayerTarget = false;  // ǷңʱһΣ
-    std::vector<int> mColorVector;  // ÿηӵɫбѭ
-    // ģʽض
-    float mAngleStep = 0;           // /ΣǶȼ
-    float mAnglePerRound = 0;       // ÿֽǶ
-    float mSpeedVariation = 0;      // ٶȱ仯
-    glm::vec2 mPositionOffset{0,0}; // λƫ
-    float mShootRadius = 0.0f;      // 뾶0ʾķ䣩
-    bool mAlignToRadius = true;     // Ƿӵ뵽뾶
-    bool mColorVectorUsed = false;  // Ƿʹӵɫб
-    int mColorIndex = -1;            // ʹб
-
-    // ӵ˶б
+    bool mUsePlayerTarget = false;  // 是否朝向玩家（发射时计算一次）
+    std::vector<int> mColorVector;  // 每次发射子弹的颜色列表（循环）
+    // 模式特定参数
+    float mAngleStep = 0;           // 环形/扇形：角度间隔
+    float mAnglePerRound = 0;       // 每轮角度增量（螺旋）
+    float mSpeedVariation = 0;      // 速度变化
+    glm::vec2 mPositionOffset{0,0}; // 发射位置偏移
+    float mShootRadius = 0.0f;      // 发射半径（0表示从中心发射）
+    bool mAlignToRadius = true;     // 是否将子弹方向对齐到半径方向
+    bool mColorVectorUsed = false;  // 是否使用子弹颜色列表
+    int mColorIndex = -1;            // 若使用列表的序号
+
+    // 子弹运动配置列表
     std::vector<std::function<pBulletMovementAction()>> mMovementBuilders;
 
     float mBulletAcceleration = 0.0f;
-    float mAccelerationDuration = -1.0f;  // ٳʱ䣨-1ʾã
+    float mAccelerationDuration = -1.0f;  // 加速持续时间（-1表示永久）
     float mBulletAngularVelocity = 0.0f;
     float mBulletAngularAccel = 0.0f;
     double mBulletMoveDuration = 10.0;
     bool mBulletNeverStop = false;
-    bool mSyncRotationWithDirection = false;  // ӵǷ˶ת
+    bool mSyncRotationWithDirection = false;  // 子弹精灵是否跟随运动方向旋转
+    BulletProgram mBulletProgram;             // 所有子弹共用的运动程序
 
-    // Ŀȡ
+    // 目标获取器
     std::function<glm::vec2()> mTargetGetter;
 
-    // Ⱦ
-    esl::Window* mRenderer = nullptr;
-    std::function<glm::vec2()> mPlayerPosGetter;  // 
+    // 子弹存放位置
+    BulletWorld* mBulletWorld = nullptr;
+    std::function<glm::vec2()> mPlayerPosGetter;  // 保留兼容性
     std::function<bool()> mFinishCondition = []()->bool{ return false; };
-    // ڲ
+    // 内部方法
     void shootLinear(class Enemy* enemy, glm::vec2 startPos);
     void shootCircle(class Enemy* enemy, glm::vec2 startPos);
     void shootFan(class Enemy* enemy, glm::vec2 startPos);
     void shootSpiral(class Enemy* enemy, glm::vec2 startPos);
+    // 按 pattern 一次生成 count 颗子弹并附加运动配置
+    void emit(class Enemy* enemy, PatternDesc pattern, int count);
     void nextColor() {
         mColorIndex = (mColorIndex + 1) % mColorVector.size();
         mBulletConfig.color = mColorVector[mColorIndex];
@@ -147,85 +150,85 @@ public:
     bool update(double deltaTime) override;
     void apply(class Enemy* enemy) override;
 
-    // ==========  API ==========
+    // ========== 构建器 API ==========
 
-    // ӵͺɫ
+    // 设置子弹类型和颜色
     DanmakuAction& bullet(int type, int color) {
         mBulletConfig.type = type;
         mBulletConfig.color = color;
         return *this;
     }
-    // ÷ģʽ
+    // 设置发射模式
     DanmakuAction& pattern(DanmakuPattern p) {
         mPattern = p;
         return *this;
     }
-    // ӵ
+    // 设置子弹数量
     DanmakuAction& count(int n) {
         mBulletCount = n;
         return *this;
     }
-    // ÿӵɫ
+    // 设置每轮子弹颜色
     DanmakuAction& colors(std::vector<int> colors) {
         mColorVectorUsed = true;
         mColorVector = colors;
         return *this;
     }
-    // ÷ͼ
+    // 设置发射轮数和间隔
     DanmakuAction& rounds(int n, double interval = 1.0) {
         mRounds = n;
         mRoundInterval = interval;
         return *this;
     }
-    // ִη
+    // 设置无限轮次发射
     DanmakuAction& infiniteRounds(double interval = 1.0) {
-        mRounds = -1;  // -1 ʾִ
+        mRounds = -1;  // -1 表示无限轮次
         mRoundInterval = interval;
         return *this;
     }
-    // ֻüֵǰ
+    // 只设置间隔（保持当前轮数）
     DanmakuAction& interval(double interval) {
         mRoundInterval = interval;
         return *this;
     }
-    // ÿֽǶȣ
+    // 设置每轮角度增量（用于螺旋等）
     DanmakuAction& rotatePerRound(float angleDelta) {
         mAnglePerRound = angleDelta;
         return *this;
     }
-    // ÷
+    // 设置方向
     DanmakuAction& direction(float angle) {
         mBulletConfig.baseAngle = angle;
         return *this;
     }
-    // Ŀ꣨ʱ㷽
+    // 朝向目标（发射时计算方向）
     DanmakuAction& toTarget(std::function<glm::vec2()> targetGetter) {
         mTargetGetter = targetGetter;
         mUsePlayerTarget = true;
         return *this;
     }
-    // ңݷ - ʹ toTarget 棩
+    // 朝向玩家（便捷方法，已弃用 - 使用 toTarget 代替）
     DanmakuAction& towardPlayer() {
-        // ע⣺Ҫȵ setPlayerPosGetter
+        // 注意：需要先调用 setPlayerPosGetter
         mUsePlayerTarget = true;
         return *this;
     }
-    // ٶ
+    // 设置速度
     DanmakuAction& speed(float s) {
         mBulletConfig.baseSpeed = s;
         return *this;
     }
-    // ýǶȼ/Σ
+    // 设置角度间隔（环形/扇形）
     DanmakuAction& angleStep(float step) {
         mAngleStep = step;
         return *this;
     }
-    // ٶȱ仯
+    // 设置速度变化
     DanmakuAction& speedVariation(float variation) {
         mSpeedVariation = variation;
         return *this;
     }
-    // λƫ
+    // 设置位置偏移
     DanmakuAction& offset(glm::vec2 off) {
         mPositionOffset = off;
         return *this;
@@ -234,7 +237,7 @@ public:
         mBulletAcceleration = accel;
         return *this;
     }
-    // üٳʱ䣨룩
+    // 设置加速持续时间（秒）
     DanmakuAction& accelerateDuring(float duration) {
         mAccelerationDuration = duration;
         return *this;
@@ -251,23 +254,29 @@ public:
         mBulletNeverStop = true;
         return *this;
     }
-    // ӵ˶ת
+    // 设置子弹精灵跟随运动方向旋转
     DanmakuAction& syncRotation(bool enable = true) {
         mSyncRotationWithDirection = enable;
         return *this;
     }
 
-    // ӵ˶
+    // 设置所有子弹共用的运动程序（优先于 acceleration 等参数）
+    DanmakuAction& program(const BulletProgram& program) {
+        mBulletProgram = program;
+        return *this;
+    }
+
+    // 设置子弹运动配置
     DanmakuAction& withMovement(std::function<pBulletMovementAction()> builder) {
         mMovementBuilders.push_back(builder);
         return *this;
     }
-    // ӣ˶
+    // 添加：清除所有运动配置
     DanmakuAction& clearMovements() {
         mMovementBuilders.clear();
         return *this;
     }
-    // ÷뾶ӵİ뾶RԲϷ䣩
+    // 设置发射半径（从敌人中心半径R的圆周上发射）
     DanmakuAction& shootFromRadius(float radius) {
         mShootRadius = radius;
         return *this;
@@ -278,28 +287,28 @@ public:
         return *this;
     }
 
-    // Ƿӵ뵽뾶Ĭtrue
+    // 设置是否将子弹方向对齐到半径（默认true）
     DanmakuAction& alignToRadius(bool align = true) {
         mAlignToRadius = align;
         return *this;
     }
 
-    //  unique_ptr addAction
+    // 构建并返回 unique_ptr（用于 addAction）
     std::unique_ptr<DanmakuAction> build() {
         auto action = std::make_unique<DanmakuAction>();
-        // 
+        // 复制所有配置
         *action = *this;
         return action;
     }
 
-    // ñҪ
-    void setRenderer(esl::Window* renderer) { mRenderer = renderer; }
+    // 设置必要的引用
+    void setBulletWorld(BulletWorld* world) { mBulletWorld = world; }
     void setPlayerPosGetter(std::function<glm::vec2()> getter) { mPlayerPosGetter = getter; }
 };
 
 
 
-// ========== ͨ˶ Action ==========
+// ========== 通用运动 Action ==========
 class GenericMovementAction : public Action {
 private:
     MovementState mState;
@@ -323,7 +332,7 @@ public:
     void apply(Enemy* enemy) override;
 };
 
-// ========== ֹͣƶܾ룩==========
+// ========== 距离停止条件（已移动的总距离）==========
 class DistanceTraveledStop : public IStopCondition {
 private:
     float mTargetDistance;
@@ -336,14 +345,14 @@ public:
     }
 
     bool shouldStop(const MovementState& state) const override {
-        // һεʱ¼ʼλ
+        // 第一次调用时记录起始位置
         if (!mInitialized) {
             const_cast<DistanceTraveledStop*>(this)->mStartPosition = state.position;
             const_cast<DistanceTraveledStop*>(this)->mInitialized = true;
             return false;
         }
 
-        // ƶľ
+        // 计算已移动的距离
         float distanceTraveled = glm::distance(mStartPosition, state.position);
         return distanceTraveled >= mTargetDistance;
     }
@@ -356,12 +365,12 @@ public:
     }
 };
 
-// ڶɶȵֹͣ
+// 基于动画完成度的停止条件
 
 class CompletionStop : public IStopCondition {
 public:
     bool shouldStop(const MovementState& state) const override {
-        // Ƿ񵽴Ŀ㣨С1أ
+        // 检查是否到达目标点（误差小于1像素）
         if (state.useTargetMode) {
             return glm::distance(state.position, state.targetPosition) < 1.0f;
         }
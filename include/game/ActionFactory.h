@@ -5,23 +5,23 @@
 #include "MovementBuilder.h"
 class Enemy;
 
-// Action ࣬𴴽͵ Action
+// Action 工厂类，负责创建所有类型的 Action
 class ActionFactory {
 public:
     using pAction = std::unique_ptr<Action>;
 
-    // ========== ƶ Action ==========
+    // ========== 移动类 Action ==========
 
-    // ֱ˶ Builder
+    // 直线运动 Builder
     static class LinearMovement createLinearMovement();
 
-    // Բ˶ Builder
+    // 圆周运动 Builder
     static class CircularMovement createCircularMovement();
 
-    // Բ˶ Builder
+    // 椭圆运动 Builder
     static class EllipticalMovement createEllipticalMovement();
 
-    // ȴ
+    // 等待
     static pAction createAwait(double awaitTime);
 
     
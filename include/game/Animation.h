@@ -1,13 +1,13 @@
 #pragma once
 #include <CircleShape.hpp>
 #include <Sprite.hpp>
-#include <Texture.hpp>
+#include <ResourceCache.hpp>
 #include <array>
 class Animation {
 	
 protected:
 	using pSprite = std::unique_ptr<esl::Sprite>;
-	using pTexture = std::unique_ptr<esl::Texture>;
+	using pTexture = std::shared_ptr<esl::Texture>;
 
 	double animationTimer = 0;
 	virtual void start(glm::vec2 pos) = 0;
@@ -16,12 +16,12 @@ protected:
 	virtual void finish() = 0;
 };
 
-// ʱ4+2Բ
+// 死亡动画时的4+2个圆环
 class DeathCircle : public Animation {
-	// Բλλ
+	// 大圆位于死亡位置
 	esl::CircleShape bigCircle;
 	esl::CircleShape bigCircle2;
-	// 4СԲλradiusλ
+	// 4个小圆位于正左右上下radius位置
 	esl::CircleShape smallCircle;
 	glm::vec2 deathPosition = { 0,0 };
 	float radius = 48;
@@ -74,11 +74,11 @@ public:
 };
 
 class PauseMenu : public Animation {
-	// ͣ˵
-	std::unique_ptr<esl::Texture> mPauseTexture;
-	std::unique_ptr<esl::Texture> mPauseTitleTexture;
-	std::unique_ptr<esl::Texture> mPauseBackTexture;
-	// ͣ˵
+	// 暂停菜单纹理
+	pTexture mPauseTexture;
+	pTexture mPauseTitleTexture;
+	pTexture mPauseBackTexture;
+	// 暂停菜单精灵
 	std::vector<std::unique_ptr<esl::Sprite>> mPauseSprites;
 	std::vector<std::unique_ptr<esl::Sprite>> mPauseTitleSprites;
 	std::unique_ptr<esl::Sprite> mPauseBackSprite;
@@ -97,7 +97,7 @@ public:
 		FINISHED
 	}state = PauseMenuState::FINISHED;
 	PauseMenu() {
-		mPauseTexture = std::make_unique<esl::Texture>(".\\Assets\\ascii\\pause.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
+		mPauseTexture = esl::TextureCache::get(".\\Assets\\ascii\\pause.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
 		
 		for (int i = 0; i < 13; i++) {
 			std::unique_ptr<esl::Sprite> sprite = std::make_unique<esl::Sprite>(mPauseTexture.get());
@@ -106,14 +106,14 @@ public:
 			mPauseSprites.push_back(std::move(sprite));
 		}
 
-		mPauseTitleTexture = std::make_unique<esl::Texture>(".\\Assets\\ascii\\pause_title.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
+		mPauseTitleTexture = esl::TextureCache::get(".\\Assets\\ascii\\pause_title.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
 		for (int i = 0; i < 4; i++) {
 			std::unique_ptr<esl::Sprite> sprite = std::make_unique<esl::Sprite>(mPauseTitleTexture.get());
 			sprite->setTextureRectFlip({ 0.f, i * 96.f }, { 256.f,64.f });
 			sprite->setPosition(basePos - glm::vec2{225,-120});
 			mPauseTitleSprites.push_back(std::move(sprite));
 		}
-		mPauseBackTexture = std::make_unique<esl::Texture>(".\\Assets\\ascii\\pause_back.png");
+		mPauseBackTexture = esl::TextureCache::get(".\\Assets\\ascii\\pause_back.png");
 		mPauseBackSprite = std::make_unique<esl::Sprite>(mPauseBackTexture.get());
 		mPauseBackSprite->setColor(glm::uvec4{ 30,120,80,255 });
 		
@@ -242,7 +242,7 @@ class SwitchScreenAnimation : public Animation {
 	bool finished = false;
 public:
 	SwitchScreenAnimation() {
-		mSwitchTexture = std::make_unique<esl::Texture>(path);
+		mSwitchTexture = esl::TextureCache::get(path);
 		mSwitchSprite = std::make_unique<esl::Sprite>(mSwitchTexture.get());
 		mSwitchSprite->setRepeat({ 4,4 });
 	}
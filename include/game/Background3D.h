@@ -6,7 +6,7 @@ class Background3D {
 	
 protected:
 	using pSprite3D = std::unique_ptr<esl::Sprite3D>;
-	using pTexture = std::unique_ptr<esl::Texture>;
+	using pTexture = std::shared_ptr<esl::Texture>;
 	using pSprite = std::unique_ptr<esl::Sprite>;
 	esl::Camera mCamera;
 	static esl::Window* mRenderer;
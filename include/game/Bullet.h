@@ -1,40 +1,55 @@
 #pragma once
 #include <iostream>
 #include <memory>
-#include <deque>
-#include <functional>
+#include <vector>
 #include <glm/glm.hpp>
 #include <Sprite.hpp>
 #include <Texture.hpp>
+#include <TextureAtlas.hpp>
 #include <Window.hpp>
-#include <GameObject.h> 
-#include "MovementState.h"    
-#include "MovementUpdater.h"
+#include <SpriteBatch.hpp>
+#include "BulletWorld.h"
 extern std::string bullet_texture_path;
-class BulletMovementAction; // Forward declaration
-class Bullet;
-// ǰ
+// 前向声明
 using pSprite = std::unique_ptr<esl::Sprite>;
-using pTexture = std::unique_ptr<esl::Texture>;
-using pBullet = std::unique_ptr<Bullet>;
-using pBulletMovementAction = std::unique_ptr<BulletMovementAction>; // Added alias
+using pTexture = std::shared_ptr<esl::Texture>;
 
 class Player;
+struct BulletSnapshot;
+struct BulletDrawList;
+
+// ========== 子弹外观 ==========
+// 由 type 和 color 决定的纹理区域与判定半径，同款子弹共享一份
+struct BulletStyle {
+	int type = 0;
+	int color = 0;
+	esl::Texture* texture = nullptr;  // 图集页，源图片加载失败时为空
+	glm::vec2 rectPos = { 0,0 };      // 源图片内的像素坐标
+	glm::vec2 rectSize = { 0,0 };
+	glm::vec4 uvRect = { 0,0,1,1 };  // 归一化纹理坐标 u1, v1, u2, v2
+	float radius = 0;  // 已按绘制缩放换算后的判定半径
+};
 
-
-// ========== ӵ ==========
-class Bullet : public GameObject {
+// ========== 子弹资源 ==========
+// 敌方子弹的数据都存放在 BulletWorld 中，这里只负责共享的纹理、外观表、绘制和消弹特效。
+// 六张子弹图与消弹特效打包进同一个图集，全部子弹只需一次实例化绘制
+class Bullet {
 protected:
 	struct EtBreakEffect {
 		glm::vec2 position = { 0,0 };
 		double lifetime = 0;
 		size_t current_index = 0;
 	};
-	static pTexture etbreakTexture;
 	static pSprite etbreakSprite;
 	static std::vector<EtBreakEffect> etbreaks;
 	static const glm::vec2 etbreakFrames[8];
 
+	static std::unique_ptr<esl::TextureAtlas> sAtlas;
+	static std::vector<BulletStyle> sStyles;
+	static std::unique_ptr<esl::SpriteBatch> sBatch;  // 全部子弹共用的实例化批次
+
+	static void setupBulletProperties(BulletStyle& style);
+
 public:
 static void createEtBreakEffect(glm::vec2 pos);
 static void updateEtBreaks(double deltaTime);
@@ -42,50 +57,18 @@ static void drawEtBreaks(esl::Window& renderer);
 static void initEtBreak();
 static void cleanupEtBreak();
 
-	double mCollisionRadius = 10;
-	std::deque<pBulletMovementAction> mMovementActions; // Changed type
-	double lastGrazeTime = 0.0;
-
-	Bullet() = default;
-	virtual ~Bullet();
-
-	void update(double delta) override {};
-
-	void render() override {};
-	virtual void addMovementAction(pBulletMovementAction action) = 0; // Changed signature
-};
-
-// ========== Bullet_1 ʵ ==========
-class Bullet_1 : public Bullet {
-	static pTexture sTexture[6];
-	esl::Window& mRenderer;
-	void updateMovementActions(double deltaTime);
-
-public:
 	static void init();
 	static void cleanup();
-	float mAngle = 0;
-	float mSpeed = 0;
-	bool mSyncRotation = false;
-
-	static void setupBulletProperties(
-		esl::Sprite* sprite,
-		double& collisionRadius,
-		int type,
-		int color
-	);
-	static esl::Texture* selectTexture(int type);
-
-	Bullet_1(int type, int color, glm::vec2 pos, esl::Window& render, float angle, float speed);
-
-	void update(double delta) override;
-	void render() override;
-	void addMovementAction(pBulletMovementAction action) override;
-	void clearMovementActions();
-
-	static void renderBatch(esl::Window& renderer, const std::vector<pBullet>& bullets);
-
-	friend class BulletPool;
+	static const esl::TextureRegion& selectRegion(int type);
+
+	// 查找（必要时登记）type/color 对应的外观编号
+	static uint16_t styleOf(int type, int color);
+	static const BulletStyle& style(uint16_t id) { return sStyles[id]; }
+
+	// 模拟线程：把 BulletWorld 的当前状态写入快照（复用快照已有的内存）
+	static void capture(const BulletWorld& world, BulletSnapshot& snapshot);
+	// 主线程：提交渲染线程整理好的实例数据
+	static void render(esl::Window& renderer, const BulletDrawList& list);
+	// 消除子弹并在原位置播放消弹特效；owner 为空时消除全部子弹
+	static size_t clearWithEffect(BulletWorld& world, const BulletOwner* owner = nullptr);
 };
-
-
@@ -1,66 +0,0 @@
-#pragma once
-#include <memory>
-#include <vector>
-#include <queue>
-#include <mutex>
-#include <Bullet.h>
-
-// ӵأڸӵ󣬼ڴ俪
-class BulletPool {
-private:
-    static std::unique_ptr<BulletPool> s_instance;
-    static std::mutex s_mutex;
-    
-    std::queue<std::unique_ptr<Bullet_1>> m_availableBullets;
-    mutable std::mutex m_poolMutex;
-    size_t m_maxPoolSize;
-    size_t m_initialPoolSize;
-    
-    // ˽й캯ʵֵģʽ
-    BulletPool(size_t initialSize = 100, size_t maxSize = 500);
-public:
-    // ȡʵ
-    static BulletPool& getInstance();
-    
-    // ÿ͸ֵ
-    BulletPool(const BulletPool&) = delete;
-    BulletPool& operator=(const BulletPool&) = delete;
-    
-    // Ӷػȡӵ
-    std::unique_ptr<Bullet_1> getBullet(int type, int color, glm::vec2 pos, esl::Window& render, float angle, float speed);
-    
-    // ӵ黹
-    void returnBullet(std::unique_ptr<Bullet_1> bullet);
-    
-    // Ԥӵ󵽳УҪã
-    void preallocate(size_t count, esl::Window& render);
-    
-    // ȡص״̬Ϣ
-    size_t getAvailableCount() const;
-    size_t getMaxPoolSize() const { return m_maxPoolSize; }
-    
-    // 
-    void clear();
-    
-    // 
-    ~BulletPool();
-    
-private:
-    // ³ʼӵ
-    void reinitializeBullet(Bullet_1* bullet, int type, int color, glm::vec2 pos, esl::Window& render, float angle, float speed);
-};
-
-// ʹõȫֺ
-namespace BulletPoolHelper {
-    // ȡӵ
-    std::unique_ptr<Bullet_1> getBullet(int type, int color, glm::vec2 pos, esl::Window& render, float angle, float speed);
-    
-    // 黹ӵ
-    void returnBullet(std::unique_ptr<Bullet_1> bullet);
-    
-    // Ԥ
-    void preallocateBullets(size_t count, esl::Window& render);
-    
-    // ȡ״̬
-    size_t getAvailableBulletCount();
-}
\ No newline at end of file
@@ -0,0 +1,58 @@
+﻿#pragma once
+#include <vector>
+#include <cstdint>
+
+// ========== 子弹运动程序 ==========
+// 用一段只读的小程序描述子弹运动，同一弹幕发射的子弹共用一份。
+// 每颗子弹只保存 程序编号 + 程序计数器 + 当前指令已执行的时间，
+// 由 BulletWorld::update 在同一个循环里统一解释执行，没有虚函数和堆分配。
+// 程序执行完毕后子弹保持当前速度匀速直线运动。
+
+enum class BulletOp : uint8_t {
+	LINEAR,         // 匀速直线运动 time 秒
+	ACCELERATE,     // 沿运动方向以 a 加速 time 秒
+	TURN,           // 以 a 度/秒 改变方向 time 秒
+	WAIT_UNTIL,     // 匀速运动直到子弹存活时间达到 a 秒
+	AIM_AT_PLAYER,  // 立即转向玩家，再加上 a 度偏移
+	SET_SPEED,      // 立即把速度设为 a
+	SET_ANGLE,      // 立即把方向设为 a 度
+	JUMP,           // 跳转到第 a 条指令（用于循环）
+};
+
+// time 小于 0 表示持续到永远（之后的指令不再执行）
+struct BulletInstruction {
+	BulletOp op = BulletOp::LINEAR;
+	float a = 0.0f;
+	float time = 0.0f;
+
+	bool operator==(const BulletInstruction& other) const {
+		return op == other.op && a == other.a && time == other.time;
+	}
+};
+
+class BulletProgram {
+public:
+	BulletProgram& linear(float seconds) { return push(BulletOp::LINEAR, 0.0f, seconds); }
+	BulletProgram& accelerate(float acceleration, float seconds) { return push(BulletOp::ACCELERATE, acceleration, seconds); }
+	BulletProgram& turn(float degreesPerSecond, float seconds) { return push(BulletOp::TURN, degreesPerSecond, seconds); }
+	BulletProgram& waitUntil(float lifetime) { return push(BulletOp::WAIT_UNTIL, lifetime, 0.0f); }
+	BulletProgram& aimAtPlayer(float offsetDegrees = 0.0f) { return push(BulletOp::AIM_AT_PLAYER, offsetDegrees, 0.0f); }
+	BulletProgram& setSpeed(float speed) { return push(BulletOp::SET_SPEED, speed, 0.0f); }
+	BulletProgram& setAngle(float degrees) { return push(BulletOp::SET_ANGLE, degrees, 0.0f); }
+	BulletProgram& jump(uint16_t target) { return push(BulletOp::JUMP, static_cast<float>(target), 0.0f); }
+
+	// 当前末尾的位置，配合 jump 写循环
+	uint16_t label() const { return static_cast<uint16_t>(mCode.size()); }
+	const std::vector<BulletInstruction>& code() const { return mCode; }
+	bool empty() const { return mCode.empty(); }
+
+	bool operator==(const BulletProgram& other) const { return mCode == other.mCode; }
+
+private:
+	std::vector<BulletInstruction> mCode;
+
+	BulletProgram& push(BulletOp op, float a, float time) {
+		mCode.push_back({ op, a, time });
+		return *this;
+	}
+};
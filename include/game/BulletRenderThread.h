@@ -0,0 +1,75 @@
+﻿#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <glm/glm.hpp>
+#include <SpriteBatch.hpp>
+#include <TripleBuffer.hpp>
+
+// ========== 子弹渲染快照 ==========
+// 模拟线程每步结束时从 BulletWorld 拷贝出绘制所需的最少数据，发布后不再修改
+struct BulletSnapshot {
+	struct Entry {
+		float x, y;
+		float dx, dy;      // 上一逻辑步中的位移，用于插值
+		float rotation;    // 度
+		uint16_t style;
+	};
+	// 外观表只增不改，每个快照只追加自己还没有的部分，渲染线程因此不读取 Bullet 的静态表
+	struct Style {
+		esl::Texture* texture = nullptr;  // 只用作分组的键，渲染线程不访问纹理
+		glm::vec2 scale = { 0,0 };
+		glm::vec4 uvRect = { 0,0,1,1 };
+	};
+	uint64_t step = 0;
+	std::vector<Entry> bullets;
+	std::vector<Style> styles;
+};
+
+// 渲染线程整理好的实例数据，按纹理分组，主线程直接交给 SpriteBatch
+struct BulletDrawList {
+	struct Group {
+		esl::Texture* texture = nullptr;
+		std::vector<esl::SpriteBatch::Instance> instances;
+	};
+	uint64_t step = 0;
+	std::vector<Group> groups;
+};
+
+// ========== 子弹渲染线程 ==========
+// 模拟线程 publish 快照，渲染线程经三缓冲取得最新的快照并生成实例数据，
+// 再经第二个三缓冲交给持有 GL 上下文的主线程提交。
+// 模拟从不等待渲染线程，来不及处理的快照直接被更新的快照覆盖
+class BulletRenderThread {
+public:
+	BulletRenderThread();
+	~BulletRenderThread();
+	BulletRenderThread(const BulletRenderThread&) = delete;
+	BulletRenderThread& operator=(const BulletRenderThread&) = delete;
+
+	// 模拟线程：写好 snapshot() 后调用 publish
+	BulletSnapshot& snapshot() { return mSnapshots.back(); }
+	void publish();
+	// 主线程：等到最近一次发布的快照整理完成，返回其实例数据；stop 之后不再等待
+	const BulletDrawList& latest();
+	// 通知线程退出并 join，可以重复调用
+	void stop();
+
+private:
+	void run();
+	static void build(const BulletSnapshot& snapshot, BulletDrawList& list);
+
+	esl::TripleBuffer<BulletSnapshot> mSnapshots;
+	esl::TripleBuffer<BulletDrawList> mDrawLists;
+	uint64_t mNextStep = 0;             // 只由模拟线程访问
+	// 以下三项受 mMutex 保护
+	std::mutex mMutex;
+	std::condition_variable mPublished; // 有新快照
+	std::condition_variable mBuilt;     // 有新实例数据
+	uint64_t mPublishedStep = 0;
+	uint64_t mBuiltStep = 0;
+	bool mStopping = false;
+	std::thread mThread;                // 最后构造，其他成员就绪后才启动
+};
@@ -0,0 +1,194 @@
+﻿#pragma once
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "BulletProgram.h"
+
+namespace esl { class JobSystem; }
+
+class BulletMovementAction;
+using pBulletMovementAction = std::unique_ptr<BulletMovementAction>;
+
+// ========== 子弹归属者 ==========
+// 记录仍然存活的子弹数量，Enemy 据此判断自己能否被销毁
+struct BulletOwner {
+	uint32_t mLiveBullets = 0;
+};
+
+// ========== 子弹句柄 ==========
+// 槽位编号 + 代数。子弹被删除后槽位的代数加一，旧句柄随即失效
+struct BulletHandle {
+	static constexpr uint32_t INVALID = 0xFFFFFFFFu;
+	uint32_t slot = INVALID;
+	uint32_t generation = 0;
+	bool valid() const { return slot != INVALID; }
+};
+
+// ========== 批量发射描述 ==========
+// 第 k 颗子弹：角度 baseAngle + k * angleStep，速度 speed + k * speedStep
+struct PatternDesc {
+	glm::vec2 origin = { 0, 0 };
+	float baseAngle = 0.0f;          // 度
+	float angleStep = 0.0f;          // 度
+	float speed = 0.0f;
+	float speedStep = 0.0f;
+	float spawnRadius = 0.0f;        // 在 origin 周围该半径处生成
+	bool radialSpawn = true;         // true: 沿各自角度偏移；false: 全部沿 spawnAngle 偏移
+	float spawnAngle = 0.0f;
+	uint16_t style = 0;
+	float radius = 0.0f;
+	uint8_t flags = 0;
+	uint16_t program = 0;            // registerProgram 返回的编号，0 表示匀速直线
+	BulletOwner* owner = nullptr;
+};
+
+// ========== 敌方子弹存储（SoA） ==========
+// 所有敌方子弹按字段分别存放在连续数组中，下标 i 的各项共同描述第 i 颗子弹。
+// 更新、剔除、碰撞与渲染都只需线性遍历其中用到的几列，不再为每颗子弹持有对象和精灵。
+// 删除采用稳定压缩，子弹的相对顺序（即绘制顺序）保持不变。
+// 稠密数组之外另有一张槽位表：空闲槽位串成侵入式空闲链表，
+// 句柄通过槽位找到子弹当前的下标，并用代数检测句柄是否过期。
+// 容量按 CHUNK_SIZE 整块增长，生成子弹时不做其他分配。
+class BulletWorld {
+public:
+	enum Flag : uint8_t {
+		FLAG_SYNC_ROTATION = 1 << 0,  // 精灵朝向跟随运动方向
+		FLAG_SCRIPTED = 1 << 1,       // 由运动 Action 队列驱动
+		FLAG_RELEASED = 1 << 2,       // 已释放：在下一次压缩前仍占着下标，更新、绘制与碰撞都跳过它
+	};
+	static constexpr uint32_t CHUNK_SIZE = 512;
+	static constexpr size_t NPOS = static_cast<size_t>(-1);
+	// 并行更新时每个任务处理的子弹数，子弹少于两块时不并行
+	static constexpr size_t PARALLEL_GRAIN = 1024;
+
+	// 运行统计，代替热路径上的打印
+	struct Stats {
+		uint64_t spawned = 0;     // 累计生成数
+		uint64_t released = 0;    // 累计删除数
+		uint32_t growths = 0;     // 容量不足时自动扩容的次数
+		uint32_t peak = 0;        // 同时存活的最大数量
+		uint32_t capacity = 0;    // 当前槽位数
+	};
+
+	// ---------- 热数据：每帧都会被遍历 ----------
+	std::vector<float> mX, mY;          // 位置
+	std::vector<float> mPrevX, mPrevY;  // 上一逻辑步结束时的位置，用于插值绘制
+	std::vector<float> mVelX, mVelY;    // 速度（像素/秒），由角度和速度换算并缓存
+	std::vector<float> mRadius;         // 判定半径
+	std::vector<float> mGrazeTimer;     // 距上次擦弹的时间
+
+	// ---------- 温数据：运动与渲染 ----------
+	std::vector<float> mAngle;          // 运动方向（度）
+	std::vector<float> mSpeed;          // 速度标量
+	std::vector<float> mRotation;       // 精灵旋转角度
+	std::vector<float> mLifetime;       // 已存活时间
+	std::vector<uint16_t> mStyle;       // 外观编号，见 Bullet::styleOf
+	std::vector<uint16_t> mProgram;     // 运动程序编号，见 registerProgram
+	std::vector<uint16_t> mPc;          // 运动程序计数器
+	std::vector<float> mOpTime;         // 当前指令已执行的时间
+	std::vector<uint8_t> mFlags;
+
+	// ---------- 冷数据：只有少数子弹会用到 ----------
+	std::vector<BulletOwner*> mOwner;
+	std::vector<std::vector<pBulletMovementAction>> mActions;
+	std::vector<uint32_t> mSlot;        // 子弹所在的槽位
+
+	BulletWorld() = default;
+	~BulletWorld();
+	BulletWorld(const BulletWorld&) = delete;
+	BulletWorld& operator=(const BulletWorld&) = delete;
+
+	size_t size() const { return mX.size(); }
+	bool empty() const { return mX.empty(); }
+	size_t capacity() const { return mSlotGeneration.size(); }
+	// 把容量扩充到至少 capacity（按整块向上取整），通常在关卡开始时按弹幕密度调用
+	void reserve(size_t capacity);
+	const Stats& stats() const { return mStats; }
+	void resetStats();
+
+	// 生成一颗子弹。容量用尽时自动扩充一块并计入 Stats::growths
+	BulletHandle spawn(uint16_t style, float radius, glm::vec2 pos, float angle, float speed,
+		uint8_t flags = 0, BulletOwner* owner = nullptr);
+	void addMovementAction(BulletHandle handle, pBulletMovementAction action);
+
+	// 一次生成 count 颗子弹：一次性取出槽位，用角度递推代替逐颗三角函数，
+	// 按列写入初始状态。返回第一颗的下标，其余紧随其后（在下一次删除前有效）
+	size_t spawnBatch(const PatternDesc& pattern, uint32_t count);
+
+	// 登记一个运动程序并返回编号，相同的程序返回同一编号；空程序为 0
+	uint16_t registerProgram(const BulletProgram& program);
+	const BulletProgram& program(uint16_t id) const { return mPrograms[id]; }
+	// AIM_AT_PLAYER 指令瞄准的位置，每帧 update 之前设置
+	void setAimTarget(glm::vec2 target) { mAimTarget = target; }
+
+	// 句柄仍指向存活的子弹时返回 true
+	bool alive(BulletHandle handle) const;
+	// 句柄对应的当前下标，过期时返回 NPOS（下标在下一次删除前有效）
+	size_t indexOf(BulletHandle handle) const;
+	BulletHandle handleOf(size_t index) const;
+	// O(1) 释放：只做标记，句柄随即失效，子弹在下一次压缩（compact 或 cullOutside）时删除
+	bool release(BulletHandle handle);
+	bool released(size_t index) const { return (mFlags[index] & FLAG_RELEASED) != 0; }
+	// 已释放但尚未压缩的子弹数
+	size_t pendingReleases() const { return mPendingReleases; }
+	// 删除全部已释放的子弹，每个逻辑步结束时调用一次
+	size_t compact();
+
+	// 设置后 update 与 cullOutside 会把子弹分块交给任务系统并行处理。
+	// 运动程序和运动 Action 只读写自己那颗子弹，可以安全并行
+	void setJobSystem(esl::JobSystem* jobs) { mJobs = jobs; }
+
+	// 推进所有子弹
+	void update(double deltaTime);
+	// 删除位于矩形区域外的子弹
+	size_t cullOutside(glm::vec2 min, glm::vec2 max);
+	// 删除所有子弹
+	void clear();
+
+	// 删除所有满足 pred(i) 的子弹以及已释放的子弹，返回删除数量。
+	// pred 只对未释放的子弹调用，此时下标 i 上的数据仍然完整，可以在其中读取位置生成特效等
+	template<typename Pred>
+	size_t releaseIf(Pred&& pred) {
+		const size_t count = size();
+		size_t write = 0;
+		for (size_t read = 0; read < count; ++read) {
+			if ((mFlags[read] & FLAG_RELEASED) || pred(read)) {
+				if (mOwner[read]) mOwner[read]->mLiveBullets--;
+				freeSlot(mSlot[read]);
+				continue;
+			}
+			if (write != read) moveSlot(write, read);
+			++write;
+		}
+		truncate(write);
+		mPendingReleases = 0;
+		mStats.released += count - write;
+		return count - write;
+	}
+
+	glm::vec2 position(size_t index) const { return { mX[index], mY[index] }; }
+	// 按当前角度和速度重新计算缓存的速度向量
+	void refreshVelocity(size_t index);
+
+private:
+	// 槽位表：存活时为子弹下标，空闲时为下一个空闲槽位
+	std::vector<uint32_t> mSlotIndex;
+	std::vector<uint32_t> mSlotGeneration;
+	uint32_t mFreeHead = BulletHandle::INVALID;
+	size_t mPendingReleases = 0;
+	Stats mStats;
+	// 编号 0 保留为空程序
+	std::vector<BulletProgram> mPrograms = { BulletProgram() };
+	glm::vec2 mAimTarget = { 0, 0 };
+	esl::JobSystem* mJobs = nullptr;
+
+	void growChunk();
+	void freeSlot(uint32_t slot);
+	uint32_t allocateSlot();
+	void updateRange(size_t begin, size_t end, double deltaTime);
+	void runProgram(size_t index, float dt);
+	void updateMovementActions(size_t index, double deltaTime);
+	void moveSlot(size_t dst, size_t src);
+	void truncate(size_t count);
+};
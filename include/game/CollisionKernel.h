@@ -0,0 +1,26 @@
+﻿#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <glm/glm.hpp>
+
+// 敌弹 vs 玩家 的批量圆形检测
+// 输入为连续存放的 x / y / 半径 数组（SpatialGrid 排序后的数组），
+// 每次迭代检测一组子弹：AVX2 8 颗，SSE2 4 颗，其余平台逐颗检测。
+// 判定公式与 CollisionManager::circleCollision 一致：d^2 < r1^2 + r2^2
+namespace CollisionKernel {
+
+    struct Result {
+        bool hit = false;          // 是否有子弹命中判定点
+        uint32_t hitIndex = 0;     // 第一颗命中子弹在输入数组中的下标
+        size_t grazeCount = 0;     // 写入 grazeOut 的数量
+    };
+
+    // 检测 [begin, end) 范围内的子弹。
+    // grazeOut 需能容纳 end - begin 个元素，写入的是输入数组中的下标
+    Result testCircles(const float* xs, const float* ys, const float* radii,
+        uint32_t begin, uint32_t end, glm::vec2 center,
+        float hitRadius, float grazeRadius, uint32_t* grazeOut);
+
+    // 当前编译使用的实现，便于调试输出
+    const char* implementation();
+}
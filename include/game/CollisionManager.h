@@ -7,38 +7,35 @@
 #include <Clock.hpp>
 class Player;
 class Enemy;
-class Bullet;
+class BulletWorld;
+class SpatialGrid;
 struct TraceBullet;
-// pSpriteͶ
+// pSprite的类型定义
 using pSprite = std::unique_ptr<esl::Sprite>;
 
-// ײ
+// 碰撞检测管理器
 class CollisionManager {
 public:
-    // ײ¼ص
+    // 碰撞事件回调函数类型
     using CollisionCallback = std::function<void()>;
     
     CollisionManager() = default;
     ~CollisionManager() = default;
-    // EnemyӵPlayerײ
-    bool checkEnemyBulletsVsPlayer(const std::vector<Bullet*>& bullets, Player& player);
-    bool checkEnemyBulletsVsPlayer(
-        const std::vector<std::unique_ptr<Bullet>>& bullets,
-        Player& player
-    );
-    // PlayerӵEnemyײ
+    // 检测Enemy子弹与Player的碰撞，grid 须为本帧用 bullets 的位置构建的网格
+    bool checkEnemyBulletsVsPlayer(BulletWorld& bullets, const SpatialGrid& grid, Player& player);
+    // 检测Player子弹与Enemy的碰撞
     bool checkPlayerBulletsVsEnemy(std::vector<pSprite>& bullets, Enemy& enemy);
     bool checkPlayerBulletsVsEnemy(std::vector<std::unique_ptr<TraceBullet>>& bullets, Enemy& enemy);
 
-    // PlayerEnemyײ
+    // 检测Player与Enemy的碰撞
     bool checkPlayerVsEnemy(Player& player, Enemy& enemy);
 
-    // ײ¼ص
+    // 设置碰撞事件回调
     void setEnemyBulletHitPlayerCallback(CollisionCallback callback);
     void setPlayerBulletHitEnemyCallback(CollisionCallback callback);
     void setPlayerHitEnemyCallback(CollisionCallback callback);
 	void setPlayerGrazeEnemyBulletCallback(CollisionCallback callback);
-    //ȡص
+    //新增：获取回调函数
     const CollisionCallback& getEnemyBulletHitPlayerCallback() const {
         return mEnemyBulletHitPlayerCallback;
     }
@@ -47,15 +44,18 @@ public:
         return mPlayerGrazeEnemyBulletCallback;
     }
 private:
-    // Բײ
+    // 基础的圆形碰撞检测
     bool circleCollision(const glm::vec2& pos1, float radius1, const glm::vec2& pos2, float radius2);
 
-    // ľײ
+    // 基础的矩形碰撞检测
     bool rectCollision(const glm::vec2& pos1, const glm::vec2& size1, const glm::vec2& pos2, const glm::vec2& size2);
 
-    // ײ¼ص
+    // 碰撞事件回调
     CollisionCallback mEnemyBulletHitPlayerCallback;
     CollisionCallback mPlayerBulletHitEnemyCallback;
     CollisionCallback mPlayerHitEnemyCallback;
 	CollisionCallback mPlayerGrazeEnemyBulletCallback;
+
+    // 批量检测输出的擦弹候选，复用以避免每帧分配
+    std::vector<uint32_t> mGrazeCandidates;
 };
\ No newline at end of file
@@ -5,12 +5,12 @@ class Dialogue_Illustration
 {
 public:
 	void init(const std::string& path,const std::string& index,bool reverse);
-	std::unique_ptr<esl::Texture> full_illustration = nullptr;
+	std::shared_ptr<esl::Texture> full_illustration = nullptr;
 	std::unique_ptr<esl::Sprite> full_sprite = nullptr;
-	std::vector<std::unique_ptr<esl::Texture>> face_textures;
-	int face_index=-1; // ʾͼ
+	std::vector<std::shared_ptr<esl::Texture>> face_textures;
+	int face_index=-1; // 正在显示的脸部表情贴图索引
 	std::vector<std::unique_ptr<esl::Sprite>> face_sprites;
-	std::unique_ptr<esl::Texture> name_flavor = nullptr;
+	std::shared_ptr<esl::Texture> name_flavor = nullptr;
 	std::unique_ptr<esl::Sprite> name_flavor_sprite = nullptr;
 	glm::vec2 face_pos{ 0,0 };
 	float offsetY = 0;
@@ -45,9 +45,9 @@ class Dialogue
 	esl::Window* renderer;
 	// test
 	esl::Font* font;
-	// ˳״̬
+	// 退出状态跟踪
 	bool mIsExiting = false;
-	double mExitDuration = 0.6;  // ˳ʱ
+	double mExitDuration = 0.6;  // 退出动画时长
 	double mExitTimer = 0.0;
 public:
 	void init(esl::Window& renderer);
@@ -2,7 +2,7 @@
 #include <iostream>
 #include <Player.h>
 #include <Bullet.h>
-#include <GameObject.h>  // 
+#include <GameObject.h>  // 引入基类
 #include <ProgressSprite.hpp>
 #include <Sprite3D.hpp>
 #include <deque>
@@ -15,15 +15,14 @@
 #endif
 
 using pSprite = std::unique_ptr<esl::Sprite>;
-using pTexture = std::unique_ptr<esl::Texture>;
+using pTexture = std::shared_ptr<esl::Texture>;
 extern std::string enemy_texture_path;
 class Action;
 class ScriptSystem;
 using pAction = std::unique_ptr<Action>;
-using pBullet = std::unique_ptr<Bullet>;
 
-// Enemy  - ̳ GameObject
-class Enemy : public GameObject {
+// Enemy 类 - 继承自 GameObject，并作为其发射子弹的归属者
+class Enemy : public GameObject, public BulletOwner {
 private:
 
 protected:
@@ -31,10 +30,11 @@ protected:
 	size_t mSpriteIndex = 0;
 	static esl::Window* mRenderer;
 	std::function<glm::vec2()> mGetPlayerPos;
+	glm::vec2 mPrevPos = { 0,0 };  // 上一逻辑步的位置，用于插值绘制
 
-	// Enemy ¼
-	std::deque<pAction> mMovementActions;  // Լƶ¼
-	std::deque<pAction> mDanmakuActions;   // ӵ¼ÿ¼һӵ
+	// Enemy 的事件队列
+	std::deque<pAction> mMovementActions;  // 敌人自己的移动事件
+	std::deque<pAction> mDanmakuActions;   // 发射子弹的事件（每个事件发射一组子弹）
 	pAction mDeathAction = nullptr;
 	pAction mSpawnAction = nullptr;
 	void updateActionQueue(std::deque<pAction>& actions, double delta);
@@ -56,24 +56,27 @@ protected:
 	double hitAnimationTimer = 0.0;
 
 	static ScriptSystem* sScriptSystem;
+	static BulletWorld* sBulletWorld;
 public:	
 	
 	virtual void DeathSoundEffect();
 	enum class EnemyType {
 		NORMAL, BOSS, EMITTER
 	}mEnemyType = EnemyType::NORMAL;
-	std::vector<pBullet> mBullets;  // Enemy ӵб
 	double mCollisionRadius = 10;
 	static void init(esl::Window* renderer);
 	static void cleanup();
 	static void setSystem(ScriptSystem* system) {
 		sScriptSystem = system;
 	}
+	static void setBulletWorld(BulletWorld* world) {
+		sBulletWorld = world;
+	}
 	enum class ActionType {
-		SPAWN,		// 
-		MOVEMENT,  // Լƶ
-		DANMAKU,   // ӵÿActionһӵ
-		DEATH      // 
+		SPAWN,		// 出场
+		MOVEMENT,  // 敌人自己的移动
+		DANMAKU,   // 发射子弹（每个Action发射一组子弹）
+		DEATH      // 死亡动作
 	};
 	
 	int mMaxHP = 0;
@@ -84,32 +87,36 @@ public:
 	bool mSpwaned = false;
 	bool mFinished = false;
 	bool mHitable = true;
-	// Ƿڵ䵯Ļ
+	// 是否在敌人死亡后清除其弹幕
 	bool mClearBulletAfterDeath = false;
 	Enemy() = default;
 	virtual ~Enemy() = default;
 	int getHP() { return mEnemyHP; }
-	// ʵ GameObject ӿ
+	// 直接设置位置视为瞬移，上一步位置一并设置，避免从旧位置插值过来
+	void setPosition(glm::vec2 pos) override {
+		GameObject::setPosition(pos);
+		mPrevPos = pos;
+	}
+	// 实现 GameObject 接口
 	void update(double delta) override;
 	void render() override;
 	float getHPRatio() { return float(mEnemyHP) / float(mMaxHP); }
-	// Enemy з
+	// Enemy 特有方法
 	void setBonus(int powerUp, int power, int lifeUp, int life, int spellCard, int fullPower, int point, int radius = 16);
-	void updateBullets(double deltaTime);
 	void clearBullets();
 	virtual void onBulletHit(int damage = 10);
 	virtual void setLifeBarVisiable(bool visiable) {};
 	pSprite& getSprite();
 
-	// Action 
+	// Action 管理
 	void addAction(pAction action, ActionType type);
 	void addAwait(double awaitTime);
 	void clearAction();
 	
-	// µʽ API
+	// 新的流式 API
 	LinearMovement& moveTo() {
 		static thread_local LinearMovement builder;
-		builder = LinearMovement(); // 
+		builder = LinearMovement(); // 重置
 		return builder;
 	}
 
@@ -128,19 +135,19 @@ public:
 
 	void setPlayerPosGetter(std::function<glm::vec2()> getter);
 
-	// ========== µĵĻ API ==========
-	// Ļ Action 
+	// ========== 新的弹幕 API ==========
+	// 创建弹幕 Action 构建器
 	DanmakuAction& shoot();
 
 };
 
-// ͳһĵ࣬ AnimalSpirit  EnemyNormal Ĺ
+// 统一的敌人类，整合了 AnimalSpirit 和 EnemyNormal 的功能
 class EnemyUnit : public Enemy {
 private:
 	static pTexture sAnimalTexture;
 	static pTexture sNormalTexture;
 	
-	friend class Enemy;  //  Enemy::cleanup ˽о̬Ա
+	friend class Enemy;  // 允许 Enemy::cleanup 访问私有静态成员
 
 	std::vector<glm::vec2> mRect;
 	glm::vec2 mSize;
@@ -148,22 +155,22 @@ private:
 	bool mIsAnimalSpirit;
 
 public:
-	// ﾫö
+	// 动物精灵类型枚举
 	enum class AnimalType {
 		BLUE, GREEN, RED
 	};
 	
-	// ͨö  
+	// 普通敌人类型枚举  
 	enum class NormalType {
 		TYPE1 = 1, TYPE2, TYPE3, TYPE4, TYPE5, TYPE6, TYPE7, TYPE8, TYPE9
 	};
 
 	void texture_init();
 
-	// ﾫĹ캯
+	// 创建动物精灵的构造函数
 	EnemyUnit(AnimalType type, bool isHorizon, glm::vec2 pos = {0, 0}, int HP = 100);
 	
-	// ͨ˵Ĺ캯
+	// 创建普通敌人的构造函数
 	EnemyUnit(NormalType type, glm::vec2 pos = {0, 0}, int HP = 100);
 
 	virtual void update(double delta) override;
@@ -208,24 +215,24 @@ public:
 	void loadFromFile(const std::string& path);
 };
 
-//  Enemy.h ĩβBoss ֮
+// 在 Enemy.h 的末尾，Boss 类之后添加
 
-// ========== ĻɼҲɽĵ ==========
-// ;ӵĵĻϣԼ˶켣
+// ========== 弹幕发射器：不可见且不可交互的敌人 ==========
+// 用途：创建复杂的弹幕组合，发射器可以有自己的运动轨迹
 class DanmakuEmitter : public Enemy {
 private:
 	Enemy* mParentEnemy = nullptr;
 public:
 	DanmakuEmitter(glm::vec2 startPos);
 
-	// д render ʲô
+	// 重写 render 方法：什么都不绘制（子弹由 BulletWorld 统一绘制）
 	void render() override;
 	void update(double delta) override;
 
-	// д onBulletHitɱ
+	// 重写 onBulletHit：不可被击中
 	void onBulletHit(int damage = 10) override {}
 
-	// ݷԶʱ
+	// 便捷方法：设置自动销毁时间
 	void setLifetime(double seconds);
 
 	void bindLifetimeTo(Enemy* parent) {
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <climits>
 #include <Window.hpp>
 #include <Sprite.hpp>
 #include <CharacterMap.hpp>
@@ -12,7 +13,7 @@ class Front {
 	const float TOP = 896 + 32;
 	const float BOTTOM = 32.0f;
 	using pSprite = std::unique_ptr<esl::Sprite>;
-	using pTexture = std::unique_ptr<esl::Texture>;
+	using pTexture = std::shared_ptr<esl::Texture>;
 	using pText = std::unique_ptr<esl::Text>;
 	struct Data {
 		unsigned int* score;
@@ -35,14 +36,14 @@ class Front {
 	glm::vec2 mRect;
 	pSprite mSpellCards[7];
 
-	// Ѷͼ
+	// 难度图标
 	pSprite mDifficultyIcons = nullptr;
-	// ȡ
+	// 收取线
 	pSprite mItemGetBorderLine = nullptr;
 	pSprite mItemGetBorderText = nullptr;
 	bool mItemGetAnimationStarted = false;
 	double mItemGetAnimationTime = 0.0;
-	// лλָʾ
+	// 敌机横坐标位置指示
 	pSprite mBossXPosIndicator = nullptr;
 	double mBossXPosIndicatorAnimationTime = 0.0;
 	bool mBossXPosIndicatorEnabled = false;
@@ -55,6 +56,8 @@ class Front {
 	pText mScoreText[2];
 	pText mPowerText[2];
 	pText mMoneyText[2];
+	// 文本当前显示的数值，数值不变时不重建文本
+	unsigned int mShownScore = UINT_MAX, mShownHighScore = UINT_MAX, mShownPower = UINT_MAX, mShownMoney = UINT_MAX;
 	void char_map_init();
 	void text_update();
 public:
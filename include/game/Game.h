@@ -1,8 +1,9 @@
-#pragma once
+﻿#pragma once
 #include <ESL.hpp>
 #include <Window.hpp>
 #include <iostream>
 #include <Scene.h>
+#include <Replay.h>
 
 class Game {
 	
@@ -10,7 +11,17 @@ class Game {
 	Scene* mScene=nullptr;
 	bool mShouldQuit = false;
 	esl::Clock mMainClock;
-	ScriptSystem mScriptSystem;
+	// 持有对白立绘等纹理，需在 OpenGL 上下文销毁前释放，见 ~Game
+	std::unique_ptr<ScriptSystem> mScriptSystem = std::make_unique<ScriptSystem>();
+	// 录像：在 MainGame 中按逻辑步记录或回放输入
+	enum class ReplayMode { NONE, RECORD, PLAYBACK };
+	ReplayMode mReplayMode = ReplayMode::NONE;
+	Replay mReplay;
+	std::string mReplayPath;
+	size_t mReplayFrame = 0;
+	bool mInGame = false;  // 当前场景是否为 MainGame
+	void startGame();
+	void finishGame();
 public:
 	Game();
 	~Game();
@@ -20,5 +31,9 @@ public:
 	void handle_event(esl::Event& e);
 	void pause();
 	void destory();
+	// 在 init 之前调用：把下一局的输入录制到 path（离开关卡时保存）
+	void recordReplay(const std::string& path);
+	// 在 init 之前调用：下一局按录像回放
+	bool playReplay(const std::string& path);
 	
 };
\ No newline at end of file
@@ -7,7 +7,7 @@ using pSprite = std::unique_ptr<esl::Sprite>;
 
 /**
  * 游戏对象基类
- * Enemy 和 Bullet 都继承自这个类，使它们在结构上处于同一层次
+ * Enemy 等场景对象继承自这个类（敌方子弹改由 BulletWorld 以 SoA 形式存放）
  */
 class GameObject {
 public:
@@ -0,0 +1,54 @@
+﻿#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <Event.hpp>
+
+class MainGame;
+
+// ========== 无窗口模拟 ==========
+// 不打开窗口、不需要 GPU，以固定步长尽可能快地运行关卡脚本，
+// 用于在 CI 机器上做弹幕性能基准和回归测试
+struct HeadlessOptions {
+	uint64_t frames = 60 * 60;        // 最多运行的逻辑步数（关卡结束时提前停止）
+	double step = 1.0 / 60.0;         // 逻辑步长
+	bool seeded = false;              // 为 true 时使用 seed 播种随机数
+	uint32_t seed = 0;
+	bool render = false;              // 每步之后是否走一遍渲染路径（进入 NullGL）
+	bool hashState = false;           // 每步计算状态哈希（hashOutput/hashCheck 不为空时自动开启）
+	std::string hashOutput;           // 把每步的状态哈希写入该文件
+	std::string hashCheck;            // 与该文件中先前记录的哈希逐步比较
+	std::string profileOutput;        // 开启 esl::Profiler，结束时导出 Chrome trace 并打印各区段耗时
+	bool trackAllocations = false;    // 开启 esl::AllocTracker，结束时打印分配报告（需以 ESL_TRACK_ALLOCATIONS 编译）
+	int64_t allocationBudget = -1;    // 每步 MainGame::update 允许的分配次数，超出时终止；-1 表示不检查
+	// 每步更新前调用，用于写入脚本化或录制的按键状态
+	std::function<void(uint64_t frame, esl::Event& e)> input;
+	// 每步更新后调用
+	std::function<void(uint64_t frame, MainGame& game)> afterStep;
+};
+
+struct HeadlessReport {
+	uint64_t frames = 0;
+	uint32_t seed = 0;
+	double seconds = 0;               // 模拟总耗时（不含加载）
+	double framesPerSecond = 0;
+	uint32_t peakBullets = 0;
+	uint64_t spawnedBullets = 0;
+	uint64_t drawCalls = 0;           // render 为 true 时的绘制调用数
+	uint64_t finalHash = 0;           // 最后一步的状态哈希（开启哈希时有效）
+	uint64_t hashMismatch = UINT64_MAX; // 第一个与 hashCheck 不一致的步，UINT64_MAX 表示全部一致
+	uint64_t hashChecked = 0;         // 实际比较过的步数
+	uint64_t hashExpected = 0;        // hashCheck 文件中记录的步数
+	bool hashFileError = false;       // hashCheck 文件无法读取或为空，此时不运行模拟
+	uint64_t allocations = 0;         // 开启分配跟踪时，模拟期间的分配次数
+	uint64_t peakFrameAllocations = 0; // 单步最多的分配次数
+	// 各子系统平均每步耗时（毫秒）
+	double enemiesMs = 0, bulletsMs = 0, playerMs = 0, collisionMs = 0, otherMs = 0;
+};
+
+class HeadlessRunner {
+public:
+	// 初始化无窗口环境、创建 MainGame 并运行，结束后释放全部资源
+	static HeadlessReport run(const HeadlessOptions& options);
+	static void print(const HeadlessReport& report);
+};
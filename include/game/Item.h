@@ -1,20 +1,24 @@
-#pragma once
+﻿#pragma once
 #include <iostream>
 #include <deque>
 #include <Sprite.hpp>
 #include <Window.hpp>
+#include <SpriteBatch.hpp>
 #include <functional>
-using pTexture = std::unique_ptr<esl::Texture>;
+using pTexture = std::shared_ptr<esl::Texture>;
 using pSprite = std::unique_ptr<esl::Sprite>;
 
 class Player;
+class StateHash;
 
 class Item {
 
 protected:
 	static esl::Window* mRenderer;
 	static pTexture itemTexture;
+	static std::unique_ptr<esl::SpriteBatch> sBatch;
 	pSprite mSprite;
+	glm::vec2 mPrevPos = { 0,0 };  // 上一逻辑步的位置，用于插值绘制
 	float mSpeed = -100;
 	unsigned int mBonus = 0;
 	static const float mAcc;
@@ -50,4 +54,6 @@ public:
 	static void UpdateAll(double delta, float playerPosY);
 	static void SetCollectLine(float y);
 	static void cleanup();
+	// 把全部道具的类型、位置、速度与收集状态混入哈希
+	static void HashAll(StateHash& hash);
 };
\ No newline at end of file
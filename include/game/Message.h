@@ -7,7 +7,7 @@
 #include <deque>
 class Message {
 	static esl::Window* renderer;
-	static esl::Texture* balloon_texture;
+	static std::shared_ptr<esl::Texture> balloon_texture;
 	static std::deque<Message*> message_queue;
 	esl::Font* font = nullptr;
 	glm::vec2 pos{};
@@ -39,13 +39,13 @@ public:
 	int getFace() const { return face; }
 	void update(double deltaTime);
 	void setPosition(glm::vec2 pos);
-	void setLineSpacing(float spacing);// м
-	void textLine1(const std::wstring& text);// õһı
-	void textLine2(const std::wstring& text);// õڶı
-	void addText(const std::wstring& text);// һı
+	void setLineSpacing(float spacing);// 设置行间距
+	void textLine1(const std::wstring& text);// 设置第一行文本
+	void textLine2(const std::wstring& text);// 设置第二行文本
+	void addText(const std::wstring& text);// 设置下一行文本
 	void setBalloonStyle(int style);
 	void setFont(esl::Font& font);
-	void clearText();// ı
+	void clearText();// 清除文本
 	void endEdit();
 	void render();
 };
\ No newline at end of file
@@ -4,7 +4,7 @@
 #include "Action.h"
 #include <memory>
 
-// ========== ֱ˶ Builder ==========
+// ========== 直线运动 Builder ==========
 class LinearMovement {
 private:
     MovementState mState;
@@ -13,13 +13,13 @@ private:
     bool mUseEasing = false;
 
 public:
-    // Ŀ
+    // 设置目标点
     LinearMovement& to(glm::vec2 target) {
         mState.targetPosition = target;
         mState.useTargetMode = true;
         return *this;
     }
-    // ̬Ŀ꣨Ŀ壩
+    // 新增：动态目标（跟踪目标物体）
     LinearMovement& toTarget(std::function<glm::vec2()> targetGetter) {
         mState.targetGetter = targetGetter;
         mState.useDynamicTarget = true;
@@ -39,7 +39,7 @@ public:
         return enableTracking();
     }
 
-    // ݷĿ + ƫ
+    // 便捷方法：跟踪目标 + 偏移
     LinearMovement& toTarget(std::function<glm::vec2()> targetGetter, glm::vec2 offset) {
         mState.targetGetter = [targetGetter, offset]() {
             return targetGetter() + offset;
@@ -48,7 +48,7 @@ public:
         mState.useTargetMode = true;
         return *this;
     }
-    // ÷ٶ
+    // 设置方向和速度
     LinearMovement& direction(float angleDegrees) {
         mState.direction = angleDegrees;
         mState.useTargetMode = false;
@@ -60,40 +60,40 @@ public:
         return *this;
     }
 
-    // üٶ
+    // 设置加速度
     LinearMovement& accelerate(float acc) {
-        // Ѿ˷ʹ÷
-        // ע⣺ֻ¼ٶȣڸнϷʹ
-        // ǿʱUpdater
-        // ĿǰStateṹacceleration
+        // 如果已经设置了方向，使用方向计算向量
+        // 注意：这里我们只记录标量加速度，在更新器中结合方向使用
+        // 或者我们可以在这里暂时不计算向量，留给Updater处理
+        // 但目前的State结构acceleration是向量
         
-        // 洢ٶȱUpdaterȥ㷽
-        // StateûaccelerationScalarֶ
-        // ʱdirection֪directionδ֪Target鷳
+        // 方案：存储加速度标量，让Updater去计算方向
+        // 但State没有accelerationScalar字段
+        // 临时方案：如果direction已知，就用direction；如果未知（比如依赖Target），这就麻烦了
         
-        // Ӧ޸Updaterʹܹٶŵǰٶȷ򣨻Target
-        // Stateֻacceleration
+        // 修正：我们应该修改Updater，使其能够处理标量加速度沿着当前速度方向（或Target方向）
+        // 但State里只有acceleration向量。
         
-        // Ǹıԣֻһǻֵ޸Stateṹ
-        // ΪСĶǼٶdirectionѾãڷTargetģʽ
-        // Targetģʽdirectioninitializeʱ
+        // 让我们改变策略：这里只设置一个标记或特殊值，或者修改State结构
+        // 为了最小改动，我们假定direction已经设置（对于非Target模式）
+        // 对于Target模式，direction会在initialize时计算
         
-        // õķMovementState accelerationScalar
-        // Ҫ޸Stateṹ
+        // 更好的方案：在MovementState中添加 accelerationScalar
+        // 但这需要修改State结构。
         
-        // UpdaterУaccelerationΪ0accelerationDurationҲ
+        // 替代方案：在Updater中，如果发现acceleration向量为0但有accelerationDuration，那也不对
         
-        // ޸MovementBuilderʹڹʱƳ
-        // źStateֱӴݵġ
+        // 让我们修改MovementBuilder，使其在构建时尽可能推迟向量计算
+        // 遗憾的是State是直接传递的。
         
-        // ۲ LinearMovementUpdater::update
+        // 观察 LinearMovementUpdater::update
         // state.velocity += state.acceleration * deltaTime;
-        // ֱӼζ acceleration ȷ
+        // 它是直接加向量。这意味着 acceleration 必须是正确的向量。
         
-        //  .toTarget() ... .accelerate(100)ʱ direction δ֪ targetGetter
-        //  acceleration ޷ȷ㡣
+        // 如果是 .toTarget() ... .accelerate(100)，此时 direction 未知（依赖 targetGetter）
+        // 因此 acceleration 向量无法在这里正确计算。
         
-        // ޸ MovementState  Updater ֧ "صǰ"
+        // 必须修改 MovementState 和 Updater 来支持 "沿当前方向加速"
         mState.accelerationScalar = acc;
         return *this;
     }
@@ -103,13 +103,13 @@ public:
         return *this;
     }
 
-    // : üٳʱ
+    // 新增: 设置加速持续时间
     LinearMovement& accelerateDuring(float duration) {
         mState.accelerationDuration = duration;
         return *this;
     }
 
-    // û
+    // 设置缓动函数
     LinearMovement& ease(std::function<float(float)> func) {
         mEaseFunc = func;
         mUseEasing = true;
@@ -120,7 +120,7 @@ public:
     LinearMovement& easeOut() { return ease(EaseFunctions::easeOut); }
     LinearMovement& easeInOut() { return ease(EaseFunctions::easeInOut); }
 
-    // ֹ
+    // 设置终止条件
     LinearMovement& stopAfter(double seconds) {
         mStopCondition = std::make_unique<TimeStop>(seconds);
         return *this;
@@ -135,31 +135,31 @@ public:
         mStopCondition = std::make_unique<VelocityStop>(threshold);
         return *this;
     }
-    // ֹƶָֹͣ
+    // 设置终止条件：移动指定距离后停止
     LinearMovement& stopWhenReachDistance(float distance) {
         mStopCondition = std::make_unique<DistanceTraveledStop>(distance);
         return *this;
     }
 
-    // : ֹͣ
+    // 新增: 永不停止
     LinearMovement& neverStop() {
         mStopCondition = std::make_unique<NeverStop>();
         return *this;
     }
     
-    //  Action
+    // 构建 Action
     std::unique_ptr<Action> build() {
-        // Ĭֹʱ
+        // 默认终止条件：时间或距离
         if (!mStopCondition) {
             if (mUseEasing && mState.useTargetMode) {
-                // ʹûʱӦõȵ
+                // 使用缓动时，应该等到动画完成
                 auto anyStop = std::make_unique<AnyStop>();
                 anyStop->add(std::make_unique<CompletionStop>());
-                anyStop->add(std::make_unique<TimeStop>(300.0)); // һܴʱΪȫ
+                anyStop->add(std::make_unique<TimeStop>(300.0)); // 设置一个很大的时间作为安全网
                 mStopCondition = std::move(anyStop);
             }
             else {
-                // ԭ߼
+                // 原有逻辑
                 auto anyStop = std::make_unique<AnyStop>();
                 anyStop->add(std::make_unique<TimeStop>(10.0));
                 if (mState.useTargetMode) {
@@ -169,7 +169,7 @@ public:
             }
         }
 
-        // ѡʵĸ
+        // 选择合适的更新器
         std::unique_ptr<IMovementUpdater> updater;
         if (mUseEasing) {
             updater = std::make_unique<TargetMovementUpdater>(mEaseFunc);
@@ -184,17 +184,17 @@ public:
     }
 
     std::unique_ptr<BulletMovementAction> buildBullet() {
-        // Ĭֹʱ
+        // 默认终止条件：时间或距离
         if (!mStopCondition) {
             if (mUseEasing && mState.useTargetMode) {
-                // ʹûʱӦõȵ
+                // 使用缓动时，应该等到动画完成
                 auto anyStop = std::make_unique<AnyStop>();
                 anyStop->add(std::make_unique<CompletionStop>());
-                anyStop->add(std::make_unique<TimeStop>(300.0)); // һܴʱΪȫ
+                anyStop->add(std::make_unique<TimeStop>(300.0)); // 设置一个很大的时间作为安全网
                 mStopCondition = std::move(anyStop);
             }
             else {
-                // ԭ߼
+                // 原有逻辑
                 auto anyStop = std::make_unique<AnyStop>();
                 anyStop->add(std::make_unique<TimeStop>(10.0));
                 if (mState.useTargetMode) {
@@ -204,7 +204,7 @@ public:
             }
         }
 
-        // ѡʵĸ
+        // 选择合适的更新器
         std::unique_ptr<IMovementUpdater> updater;
         if (mUseEasing) {
             updater = std::make_unique<TargetMovementUpdater>(mEaseFunc);
@@ -219,7 +219,7 @@ public:
     }
 };
 
-// ========== Բ˶ Builder ==========
+// ========== 圆周运动 Builder ==========
 class CircularMovement {
 private:
     MovementState mState;
@@ -233,25 +233,25 @@ public:
         mState.autoCalculateRadius = false;
         return *this;
     }
-    // ========== ģʽ2ָΪģ==========
+    // ========== 模式2：以指定点为中心（新增）==========
     CircularMovement& centerAt(glm::vec2 centerPos) {
         mState.center = centerPos;
-        mState.useCenterMode = true;  // Ϊ"ⲿΪ"
+        mState.useCenterMode = true;  // 标记为"以外部点为中心"
         mState.useTangentMode = false;
-        mState.autoCalculateRadius = true;  // Զ뾶ͽǶ
+        mState.autoCalculateRadius = true;  // 自动计算半径和角度
         return *this;
     }
 
-    // ========== ģʽ3ָĺͰ뾶ȫֶ==========
+    // ========== 模式3：指定中心和半径（完全手动）==========
     CircularMovement& centerAt(glm::vec2 centerPos, float r) {
         mState.center = centerPos;
         mState.radius = r;
         mState.useCenterMode = true;
         mState.useTangentMode = false;
-        mState.autoCalculateRadius = false;  // Զ㣬ʹֵָ
+        mState.autoCalculateRadius = false;  // 不自动计算，使用指定值
         return *this;
     }
-    // ٶȣٶȣ
+    // 设置切线速度（线速度）
     CircularMovement& tangentVelocity(float v) {
         mState.tangentVelocity = v;
         mState.useTangentMode = true;
@@ -259,7 +259,7 @@ public:
         return *this;
     }
 
-    // ߷򣨵ǰ˶򣬶ȣ
+    // 设置切线方向（当前运动方向，度）
     CircularMovement& tangentDirection(float degrees) {
         mState.tangentDirection = degrees;
         mState.useTangentMode = true;
@@ -267,13 +267,13 @@ public:
         return *this;
     }
 
-    // ð뾶裩
+    // 设置半径（必需）
     CircularMovement& withRadius(float r) {
         mState.radius = r;
         return *this;
     }
 
-    // ת
+    // 设置旋转方向
     CircularMovement& clockwise(bool cw = true) {
         mState.clockwise = cw;
         return *this;
@@ -283,7 +283,7 @@ public:
         mState.clockwise = false;
         return *this;
     }
-    // ========== ͨ÷ ==========
+    // ========== 通用方法 ==========
     CircularMovement& radiusSpeed(float v) {
         mState.radiusVelocity = v;
         return *this;
@@ -299,7 +299,7 @@ public:
         return *this;
     }
 
-    // ֹ
+    // 终止条件
     CircularMovement& stopAfter(double seconds) {
         mStopCondition = std::make_unique<TimeStop>(seconds);
         return *this;
@@ -322,7 +322,7 @@ public:
 
     std::unique_ptr<Action> build() {
         if (!mStopCondition) {
-            // Ĭϣ1Ȧ10
+            // 默认：1圈或10秒
             auto anyStop = std::make_unique<AnyStop>();
             anyStop->add(std::make_unique<TimeStop>(10.0));
             anyStop->add(std::make_unique<AngleRangeStop>(2.0f * glm::pi<float>()));
@@ -338,7 +338,7 @@ public:
 
     std::unique_ptr<BulletMovementAction> buildBullet() {
         if (!mStopCondition) {
-            // Ĭϣ1Ȧ10
+            // 默认：1圈或10秒
             auto anyStop = std::make_unique<AnyStop>();
             anyStop->add(std::make_unique<TimeStop>(10.0));
             anyStop->add(std::make_unique<AngleRangeStop>(2.0f * glm::pi<float>()));
@@ -353,7 +353,7 @@ public:
     }
 };
 
-// ========== Բ˶ Builder ==========
+// ========== 椭圆运动 Builder ==========
 class EllipticalMovement {
 private:
     MovementState mState;
@@ -366,7 +366,7 @@ public:
         mState.autoCalculateRadius = false;
         return *this;
     }
-    // ģʽ2ָΪ
+    // 模式2：以指定点为中心
     EllipticalMovement& centerAt(glm::vec2 centerPos) {
         mState.center = centerPos;
         mState.useCenterMode = true;
@@ -374,7 +374,7 @@ public:
         return *this;
     }
 
-    // ģʽ3ָĺͰ뾶
+    // 模式3：指定中心和半径
     EllipticalMovement& centerAt(glm::vec2 centerPos, float r) {
         mState.center = centerPos;
         mState.radius = r;
@@ -432,7 +432,7 @@ public:
     }
 };
 
-// ========== ˶ ==========
+// ========== 波动运动构建器 ==========
 class WaveMovement {
 private:
     MovementState mState;
@@ -444,46 +444,46 @@ private:
 public:
     WaveMovement() {
         mState.speed = 100.0f;
-        mState.direction = 270.0f;  // Ĭ
+        mState.direction = 270.0f;  // 默认向下
     }
 
-    // ò
+    // 设置波动幅度
     WaveMovement& amplitude(float amp) {
         mAmplitude = amp;
         return *this;
     }
 
-    // òƵʣÿ񵴴)
+    // 设置波动频率（每秒振荡次数)
     WaveMovement& frequency(float freq) {
         mFrequency = freq;
         return *this;
     }
 
-    // λƫƣȣ
+    // 设置相位偏移（弧度）
     WaveMovement& phase(float ph) {
         mPhase = ph;
         return *this;
     }
 
-    // ûƶ򣨽Ƕȣ
+    // 设置基础移动方向（角度）
     WaveMovement& direction(float deg) {
         mState.direction = deg;
         return *this;
     }
 
-    // ûٶ
+    // 设置基础速度
     WaveMovement& speed(float spd) {
         mState.speed = spd;
         return *this;
     }
 
-    // ֹͣʱ
+    // 停止条件：时间
     WaveMovement& stopAfter(double seconds) {
         mStopCondition = std::make_unique<TimeStop>(seconds);
         return *this;
     }
 
-    // ֹͣ
+    // 停止条件：距离
     WaveMovement& stopAfterDistance(float distance) {
         mStopCondition = std::make_unique<DistanceStop>(distance);
         return *this;
@@ -512,7 +512,7 @@ public:
     }
 };
 
-// ========== ˶ ==========
+// ========== 贝塞尔曲线运动构建器 ==========
 class BezierMovement {
 private:
     MovementState mState;
@@ -524,25 +524,25 @@ private:
 public:
     BezierMovement() = default;
 
-    // ӿƵ㣨ƫƣ
+    // 添加控制点（相对于起点的偏移）
     BezierMovement& controlPoint(glm::vec2 point) {
         mControlPoints.push_back(point);
         return *this;
     }
 
-    // ӿƵ㣨ʹƫ
+    // 添加控制点（使用偏移量）
     BezierMovement& controlPointOffset(float x, float y) {
         mControlPoints.push_back(glm::vec2(x, y));
         return *this;
     }
 
-    // յ㣨㣩
+    // 设置终点（相对于起点）
     BezierMovement& to(glm::vec2 endpoint) {
         mControlPoints.push_back(endpoint);
         return *this;
     }
 
-    // ٴα -> Ƶ -> յ㣩
+    // 快速创建：二次贝塞尔（起点 -> 控制点 -> 终点）
     BezierMovement& quadratic(glm::vec2 controlPoint, glm::vec2 endpoint) {
         mControlPoints.clear();
         mControlPoints.push_back(controlPoint);
@@ -550,7 +550,7 @@ public:
         return *this;
     }
 
-    // ٴα -> Ƶ1 -> Ƶ2 -> յ㣩
+    // 快速创建：三次贝塞尔（起点 -> 控制点1 -> 控制点2 -> 终点）
     BezierMovement& cubic(glm::vec2 cp1, glm::vec2 cp2, glm::vec2 endpoint) {
         mControlPoints.clear();
         mControlPoints.push_back(cp1);
@@ -559,13 +559,13 @@ public:
         return *this;
     }
 
-    // óʱ
+    // 设置持续时间
     BezierMovement& duration(float seconds) {
         mDuration = seconds;
         return *this;
     }
 
-    // û
+    // 设置缓动函数
     BezierMovement& ease(std::function<float(float)> func) {
         mEaseFunc = func;
         return *this;
@@ -600,12 +600,12 @@ public:
     }
 };
 
-// ========== ͨñ˶֧==========
+// ========== 通用贝塞尔曲线运动构建器（支持任意阶数）==========
 class GeneralBezierMovement {
 private:
     MovementState mState;
-    std::vector<glm::vec2> mControlPoints;//̬
-    std::vector<std::function<glm::vec2()>> mDynamicPoints;//̬
+    std::vector<glm::vec2> mControlPoints;//静态
+    std::vector<std::function<glm::vec2()>> mDynamicPoints;//动态
     float mDuration = 1.0f;
     std::function<float(float)> mEaseFunc = EaseFunctions::linear;
     std::unique_ptr<IStopCondition> mStopCondition;
@@ -613,28 +613,28 @@ private:
 public:
     GeneralBezierMovement() = default;
 
-    // ̬Ƶ
+    // 静态控制点
     GeneralBezierMovement& point(glm::vec2 p) {
         mControlPoints.push_back(p);
-        mDynamicPoints.push_back(nullptr);  // ռλ
+        mDynamicPoints.push_back(nullptr);  // 占位
         return *this;
     }
 
-    // ̬Ƶ㣨Ŀ꣩
+    // 动态控制点（跟踪目标）
     GeneralBezierMovement& pointAtTarget(std::function<glm::vec2()> getter) {
-        mControlPoints.push_back(glm::vec2(0, 0));  // ռλ
+        mControlPoints.push_back(glm::vec2(0, 0));  // 占位
         mDynamicPoints.push_back(getter);
         return *this;
     }
 
-    // ̬Ƶ + ƫ
+    // 动态控制点 + 偏移
     GeneralBezierMovement& pointAtTarget(std::function<glm::vec2()> getter, glm::vec2 offset) {
         mControlPoints.push_back(glm::vec2(0, 0));
         mDynamicPoints.push_back([getter, offset]() { return getter() + offset; });
         return *this;
     }
 
-    // ӣϾ̬Ͷ̬
+    // 批量添加（混合静态和动态）
     GeneralBezierMovement& points(std::initializer_list<glm::vec2> pts) {
         for (const auto& p : pts) {
             point(p);
@@ -642,13 +642,13 @@ public:
         return *this;
     }
 
-    // óʱ
+    // 设置持续时间
     GeneralBezierMovement& duration(float seconds) {
         mDuration = seconds;
         return *this;
     }
 
-    // 
+    // 缓动
     GeneralBezierMovement& ease(std::function<float(float)> func) {
         mEaseFunc = func;
         return *this;
@@ -666,10 +666,10 @@ public:
         return std::make_unique<GenericMovementAction>(
             mState,
             std::make_unique<GeneralBezierMovementUpdater>(
-                mControlPoints,      // 1
-                mDynamicPoints,      // 2
-                mDuration,           // 3
-                mEaseFunc            // 4
+                mControlPoints,      // 参数1
+                mDynamicPoints,      // 参数2
+                mDuration,           // 参数3
+                mEaseFunc            // 参数4
             ),
             std::move(mStopCondition)
         );
@@ -683,17 +683,17 @@ public:
         return std::make_unique<GenericBulletMovementAction>(
             mState,
             std::make_unique<GeneralBezierMovementUpdater>(
-                mControlPoints,      // 1
-                mDynamicPoints,      // 2
-                mDuration,           // 3
-                mEaseFunc            // 4
+                mControlPoints,      // 参数1
+                mDynamicPoints,      // 参数2
+                mDuration,           // 参数3
+                mEaseFunc            // 参数4
             ),
             std::move(mStopCondition)
         );
     }
 };
 
-// ========== ͨñ߹ ==========
+// ========== 复合通用贝塞尔曲线构建器 ==========
 class CompositeGeneralBezierMovement {
 private:
     MovementState mState;
@@ -707,7 +707,7 @@ public:
         mCurrentSegment.easeFunc = EaseFunctions::linear;
     }
 
-    // ӿƵ㵽ǰ
+    // 添加控制点到当前段
     CompositeGeneralBezierMovement& point(glm::vec2 p) {
         mCurrentSegment.controlPoints.push_back(p);
         return *this;
@@ -717,7 +717,7 @@ public:
         return point(glm::vec2(x, y));
     }
 
-    // һӶƵ
+    // 一次性添加多个控制点
     CompositeGeneralBezierMovement& points(std::initializer_list<glm::vec2> pts) {
         mCurrentSegment.controlPoints.insert(
             mCurrentSegment.controlPoints.end(), pts.begin(), pts.end()
@@ -725,13 +725,13 @@ public:
         return *this;
     }
 
-    // õǰγʱ
+    // 设置当前段持续时间
     CompositeGeneralBezierMovement& duration(float seconds) {
         mCurrentSegment.duration = seconds;
         return *this;
     }
 
-    // õǰλ
+    // 设置当前段缓动
     CompositeGeneralBezierMovement& ease(std::function<float(float)> func) {
         mCurrentSegment.easeFunc = func;
         return *this;
@@ -742,7 +742,7 @@ public:
     CompositeGeneralBezierMovement& easeInOut() { return ease(EaseFunctions::easeInOut); }
     CompositeGeneralBezierMovement& linear() { return ease(EaseFunctions::linear); }
 
-    // ʼ¶
+    // 开始新段
     CompositeGeneralBezierMovement& newSegment() {
         if (!mCurrentSegment.controlPoints.empty()) {
             mSegments.push_back(mCurrentSegment);
@@ -754,7 +754,7 @@ public:
     }
 
     std::unique_ptr<Action> build() {
-        // һ
+        // 保存最后一段
         if (!mCurrentSegment.controlPoints.empty()) {
             mSegments.push_back(mCurrentSegment);
         }
@@ -776,7 +776,7 @@ public:
     }
 
     std::unique_ptr<BulletMovementAction> buildBullet() {
-        // һ
+        // 保存最后一段
         if (!mCurrentSegment.controlPoints.empty()) {
             mSegments.push_back(mCurrentSegment);
         }
@@ -798,7 +798,7 @@ public:
     }
 };
 
-// ========== 壬ʹ buildBullet() ==========
+// ========== 别名定义，方便使用 buildBullet() ==========
 using BulletLinearMovement = LinearMovement;
 using BulletCircularMovement = CircularMovement;
 using BulletEllipticalMovement = EllipticalMovement;
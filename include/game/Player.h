@@ -2,6 +2,7 @@
 #include <iostream>
 #include <Window.hpp>
 #include <Sprite.hpp>
+#include <SpriteBatch.hpp>
 #include <algorithm>
 #include <random>
 #include <ScriptSystem.h>
@@ -11,25 +12,28 @@
 #include <functional>
 
 using pSprite = std::unique_ptr<esl::Sprite>;
-using pTexture = std::unique_ptr<esl::Texture>;
+using pTexture = std::shared_ptr<esl::Texture>;
 
 // Forward declaration
 class Enemy;
+class SpatialGrid;
+class StateHash;
 
-// ׷ٵṹ
+// 追踪弹结构
 struct TraceBullet {
 	pSprite sprite;
 	glm::vec2 velocity;
-	Enemy* target = nullptr;  // ǰ׷Ŀ
+	Enemy* target = nullptr;  // 当前追踪目标
 	bool hasTarget = false;
 	float speed = 600.0f;
-	float rotateSpeed = 5.0f;  // תٶȣ/֡
+	float rotateSpeed = 5.0f;  // 转向速度（度/帧）
+	glm::vec2 lastMove = { 0, 0 };  // 上一步的位移，用于插值绘制
 	
 	TraceBullet(pTexture& texture, glm::vec2 position) {
 		sprite = std::make_unique<esl::Sprite>(texture.get());
 		sprite->setPosition(position);
 		sprite->setScale({2, 2});
-		velocity = {0, 1}; // ϷY
+		velocity = {0, 1}; // 向上方向（正Y方向）
 	}
 };
 
@@ -48,19 +52,25 @@ protected:
 	pTexture mSlowEffectTexture;
 	pTexture mYinYangOrbTexture;
 	pTexture mTraceBulletTexture;
-	// ӵ
+	// 子弹纹理
 	std::vector<pTexture> mBulletTextures;
-	// ӵ
-	// 
+	// 子弹容器
+	// 射击间隔
 	size_t mShootInterval = 0;
 	size_t mYinYangOrbCount = 1;
 	std::vector<pSprite> mYinYangOrbs;
 	
-	// лб
+	// 敌机列表的引用
 	std::vector<Enemy*>* mEnemyList = nullptr;
-	// ޵״̬
+	// 按 mEnemyList 下标构建的敌人网格
+	const SpatialGrid* mEnemyGrid = nullptr;
+	// 无敌状态
 	bool mInvincible = false;
 	double mInvincibleTimer = 5.0;
+	// 上一逻辑步开始时的位置，用于插值绘制
+	glm::vec2 mPrevPos = { 0,0 };
+	// 插值后的绘制位置相对当前逻辑位置的偏移
+	glm::vec2 renderOffset(float alpha);
 
 	DeathCircle mDeathCircle;
 public:
@@ -81,8 +91,9 @@ public:
 	virtual void shoot();
 	virtual void render();
 	virtual void slowEffectRender();
-	// õлб
+	// 设置敌机列表引用
 	void setEnemyList(std::vector<Enemy*>* enemyList) { mEnemyList = enemyList; }
+	void setEnemyGrid(const SpatialGrid* enemyGrid) { mEnemyGrid = enemyGrid; }
 	static void setSystem(ScriptSystem* system) { mScriptSystem = system; }
 	static void getItemSoundEffect(){
 		if (mScriptSystem) {
@@ -92,19 +103,23 @@ public:
 	int mCollectRadius = 64;
 	void hitPlayer(glm::vec2 rebirthPos);
 	bool isInvincible() const { return mInvincible; }
+	// 把影响模拟结果的状态（位置、射击计时、无敌、自机子弹）混入哈希
+	virtual void hashState(StateHash& hash);
 };
 
 class Reimu :public Player {
 	esl::Window& mRenderer;
+	esl::SpriteBatch mShotBatch;  // 普通子弹与追踪弹的实例化批次
+	float mShotStep = 0;          // 普通子弹上一步的位移
 protected:
 	void update_bullets(double delta);
 	void update_trace_bullets(double delta);
-	// ѰĵлĿ
+	// 寻找最近的敌机目标
 	Enemy* findNearestEnemy(glm::vec2 bulletPos);
-	// ĿǷȻЧ
+	// 检查目标是否仍然有效
 	bool isTargetValid(Enemy* target);
 public:
-	// ׷ٵ - ƵpublicCollisionManager
+	// 追踪弹容器 - 移到public让CollisionManager访问
 	std::vector<std::unique_ptr<TraceBullet>> mTraceBullets;
 	
 	Reimu(esl::Window& renderer, unsigned int& power);
@@ -112,4 +127,5 @@ public:
 	virtual void shoot();
 	virtual void render();
 	virtual void slowEffectRender();
+	virtual void hashState(StateHash& hash);
 };
\ No newline at end of file
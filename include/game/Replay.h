@@ -0,0 +1,48 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <Event.hpp>
+
+// ========== 录像 ==========
+// 记录随机数种子和每个逻辑步的按键位图。按同样的种子和逐步输入重新运行，
+// 模拟结果逐位一致，可按正常速度回放，也可在无窗口模式下全速回放。
+// 文件格式（小端）：
+//   "THRP" | u16 版本 | u32 种子 | u32 步数 | 行程编码的按键流
+//   行程编码：u8 按键位图 + 变长整数（7 位一组）表示连续步数
+class Replay {
+public:
+	enum InputBit : uint8_t {
+		INPUT_UP = 1 << 0,
+		INPUT_DOWN = 1 << 1,
+		INPUT_LEFT = 1 << 2,
+		INPUT_RIGHT = 1 << 3,
+		INPUT_SLOW = 1 << 4,    // 左 Shift
+		INPUT_SHOT = 1 << 5,    // Z
+		INPUT_BOMB = 1 << 6,    // X
+		INPUT_PAUSE = 1 << 7,   // Esc
+	};
+	static constexpr uint16_t VERSION = 1;
+	// 读取时接受的最大步数（60 步/秒下 24 小时），超出按损坏的文件处理
+	static constexpr uint32_t MAX_STEPS = 60u * 60u * 60u * 24u;
+
+	// 从事件中读取游戏用到的按键
+	static uint8_t capture(esl::Event& e);
+	// 把按键位图写回事件，未按下的键设为释放
+	static void apply(uint8_t input, esl::Event& e);
+
+	void clear();
+	void setSeed(uint32_t seed) { mSeed = seed; }
+	uint32_t seed() const { return mSeed; }
+	void record(uint8_t input) { mInputs.push_back(input); }
+	size_t size() const { return mInputs.size(); }
+	// 超出录像长度时视为没有按键
+	uint8_t input(size_t frame) const { return frame < mInputs.size() ? mInputs[frame] : 0; }
+
+	bool save(const std::string& path) const;
+	bool load(const std::string& path);
+
+private:
+	uint32_t mSeed = 0;
+	std::vector<uint8_t> mInputs;
+};
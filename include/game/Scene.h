@@ -3,47 +3,58 @@
 #include <Window.hpp>
 #include <Sprite.hpp>
 #include <Clock.hpp>
+#include <JobSystem.hpp>
 #include <Player.h>
 #include <Enemy.h>
-#include <CollisionManager.h>  // ײͷļ
+#include <CollisionManager.h>  // 添加碰撞管理器头文件
+#include <SpatialGrid.h>
+#include <BulletRenderThread.h>
 #include <Front.h>
 #include <Background3D.h>
 #include <ScriptSystem.h>
 #include <Stage.h>
 #include <Animation.h>
 #include <BlurEffect.hpp>
+#include <Profiler.hpp>
+#include <ProfilerOverlay.hpp>
+#include <StateHash.h>
+#include <cstdio>
 
 using pSprite = std::unique_ptr<esl::Sprite>;
-using pTexture = std::unique_ptr<esl::Texture>;
-// 
+using pTexture = std::shared_ptr<esl::Texture>;
+// 场景基类
 class Scene {
 
 protected:
 	esl::Clock mSceneClock;
 	ScriptSystem& mScriptSystem;
+	// 最近一次 update 是否推进了模拟（暂停时不推进）
+	bool mAdvanced = false;
 public:
 	struct SceneInfo {
 		bool mSwitchToNextScene = false;
 		int mSwitchToSceneIndex = -1;
 	}mSceneInfo;
 	Scene(ScriptSystem& scriptSystem):mScriptSystem(scriptSystem){}
-	virtual ~Scene() = default;  // 
+	virtual ~Scene() = default;  // 添加虚析构函数
 	virtual void process_input(esl::Event& e);
 	virtual void render();
 	virtual void update(double deltaTime);
+	// 为 false 时上一步与当前步的状态相同，不应在两者之间插值绘制
+	bool advanced() const { return mAdvanced; }
 	void switchToScene(int index) {
 		mSceneInfo.mSwitchToNextScene = true;
 		mSceneInfo.mSwitchToSceneIndex = index;
 	}
 };
 
-// Ϸ
+// 游戏主界面
 class TitleScene :public Scene {
 	esl::Window& mRenderer;
-	// ͼƬ
+	// 背景图片
 	pTexture mTitleBackTexture;
 	pSprite mTitleBackgroundSprite;
-	// ѡ
+	// 主界面选项
 	std::vector<pTexture> mMenuSelectionTextures;
 	std::vector<pSprite> mMenuSelections;
 	int mSelectIndex = 0;
@@ -71,14 +82,21 @@ class MainGame :public Scene {
 	std::unique_ptr<Player> mPlayer;
 	double mDeltaTime = 0;
 	std::vector<Enemy*> mEnemys;
-	CollisionManager mCollisionManager;  // ײ
+	CollisionManager mCollisionManager;  // 添加碰撞管理器
 	Front* mFront;
 	Stage mStage;
 	Data mData;
 	Background3D* mBackground;
 	glm::vec2 mCenterPos { 768.0f / 2 + 64 ,128 };
 	bool mPause = false;
-	std::vector<Bullet*> mAllEnemyBullets;
+	esl::JobSystem mJobs;      // 工作线程，用于并行更新子弹
+	BulletWorld mBulletWorld;  // 全部敌方子弹
+	// 每个模拟步结束时发布子弹快照，由渲染线程整理成实例数据，render 绘制最近一步的结果
+	BulletRenderThread mBulletRender;
+	SpatialGrid mBulletGrid;   // 敌方子弹的空间网格，碰撞检测前重建
+	SpatialGrid mEnemyGrid;    // 敌人的空间网格，供追踪弹搜索目标
+	std::vector<float> mEnemyX, mEnemyY;
+	void buildEnemyGrid();
 	
 	// DeathCircle
 	DeathCircle mDeathCircle;
@@ -88,6 +106,40 @@ class MainGame :public Scene {
 
 	SwitchScreenAnimation mSwitchScreenAnimation;
 	bool mSwitchEffectEnabled = false;
+	esl::ProfilerOverlay mProfilerOverlay{ "C:\\Windows\\Fonts\\simhei.ttf" };  // F3 切换
+public:
+	// 每个逻辑步中各子系统的累计耗时（秒）
+	struct StepTimings {
+		uint64_t steps = 0;
+		double enemies = 0;     // 敌人更新与发射
+		double bullets = 0;     // 子弹更新与剔除
+		double player = 0;      // 敌人网格、玩家与关卡脚本
+		double collision = 0;   // 子弹网格与碰撞检测
+		double other = 0;       // 道具、对话、特效、HUD 等
+	};
+	const StepTimings& getStepTimings() const { return mStepTimings; }
+	const BulletWorld& getBulletWorld() const { return mBulletWorld; }
+	// 状态哈希：开启后每次 update 结束时计算一次整个模拟状态的哈希（暂停中也算一步），
+	// stream 不为空时每步写入一行 "<步数> <哈希>"。配合录像回放，
+	// 两次运行的输出逐行相同即说明优化没有改变游戏结果
+	void setStateHashing(bool enabled, std::FILE* stream = nullptr);
+	uint64_t stateHash() const { return mStateHash; }
+	uint64_t computeStateHash();
+private:
+	StepTimings mStepTimings;
+	esl::Clock mStepClock;
+	bool mStateHashing = false;
+	std::FILE* mHashStream = nullptr;
+	uint64_t mStateHash = 0;
+	uint64_t mHashedSteps = 0;
+	// 推进一个逻辑步
+	void simulate(double deltaTime);
+	// 返回距上次调用的时间并重新计时
+	double lap() {
+		double t = mStepClock.getElapsedTime();
+		mStepClock.restart();
+		return t;
+	}
 public:
 MainGame(esl::Window& render, ScriptSystem& system);
 ~MainGame();
@@ -111,20 +163,29 @@ void data_maintain();
 	glm::vec2 Position(glm::vec2 pos = {0,0}) {
 		return mCenterPos + pos;
 	}
+	// 全局随机数发生器（Mersenne Twister），默认用 random_device 播种；
+	// 在创建 MainGame 之前调用 SetSeed 可使整局游戏可复现
+	static std::mt19937 sRandom;
+	static uint32_t sSeed;
+	// 播种后的抽取次数，与种子一起确定发生器状态，供状态哈希使用
+	static uint64_t sRandomDraws;
+	static void SetSeed(uint32_t seed) {
+		sSeed = seed;
+		sRandomDraws = 0;
+		sRandom.seed(seed);
+	}
+	static uint32_t Seed() { return sSeed; }
 	static int Random(int min, int max) {
-
-		static std::random_device rd;
-		static std::mt19937 gen(rd()); // Mersenne Twister 
-
 		std::uniform_int_distribution<> distrib(min, max);
+		sRandomDraws++;
 
-		// һ
-		return distrib(gen);
+		// 生成一个随机数
+		return distrib(sRandom);
 	}
 	static glm::vec2 RandomPos(int radius, glm::vec2 center) {
 		if (radius <= 0) return center;
-		float angle = static_cast<float>(Random(0, 360)) * 3.1415926f / 180.0f; // ǶȣתΪ
-		float r = static_cast<float>(Random(0, radius)); // 뾶
+		float angle = static_cast<float>(Random(0, 360)) * 3.1415926f / 180.0f; // 随机角度，转换为弧度
+		float r = static_cast<float>(Random(0, radius)); // 随机半径
 		float x = center.x + r * cos(angle);
 		float y = center.y + r * sin(angle);
 		return { x,y };
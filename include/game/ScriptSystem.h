@@ -10,24 +10,24 @@
 class ScriptSystem
 {
 private:
-	// Իϵͳ
+	// 对话系统
 	Dialogue* pDialogue = nullptr;
 	std::string mCurrentSection;
-	// 洢ĶԻ
+	// 存储解析后的对话段落
 	std::map<std::string, std::vector<Message*>> mDialogueSections;
-	// Ƶϵͳ
+	// 音频系统
 	esl::Audio* pAudio = nullptr;
 	esl::AudioEngine* pAudioEngine = nullptr;
 
 	struct AudioInfo 
 	{
 		std::wstring musicTitle{};
-		ma_uint64 start = 0;        // ʼʱ
-		ma_uint64 prelude = 0;      // ǰ೤
-		ma_uint64 loopStart = 0;    // ѭʼ
-		ma_uint64 loopLength = 0;   // ѭ
-		esl::Sprite* titleSprite = nullptr;// ֱ
-		esl::Texture* texture = nullptr;
+		ma_uint64 start = 0;        // 起始时间
+		ma_uint64 prelude = 0;      // 前奏长度
+		ma_uint64 loopStart = 0;    // 循环开始
+		ma_uint64 loopLength = 0;   // 循环长度
+		esl::Sprite* titleSprite = nullptr;// 音乐标题
+		std::shared_ptr<esl::Texture> texture;
 	};
 	int mCurrentAudio = 0;
 	std::deque<AudioInfo*> mAudioFmts;
@@ -39,20 +39,20 @@ private:
 
 	bool mStageCleared = false;
 	bool mStageClearAnimationRev = false;
-	esl::Texture* mStageClearTexture = nullptr;
+	std::shared_ptr<esl::Texture> mStageClearTexture;
 	esl::Sprite* mStageClearSprite = nullptr;
 	double mStageClearTimer = 0.0;
 
-	// Ч
+	// 音效表
 	std::unordered_map<std::string,std::unique_ptr<esl::Audio>> mSoundEffects;
 public:
 	ScriptSystem();
 	~ScriptSystem();
-	// ========== ʼϵͳ ==========
+	// ========== 初始化系统 ==========
 	void initDialogueSystem(esl::Window& renderer);
 	void initAudioSystem(esl::Window& renderer);
 
-	// ========== Ƶϵͳ ==========
+	// ========== 音频系统 ==========
 	void setAudio(int audio);
 	void loadAudioScript(const std::string& path);
 	void nextAudio();
@@ -64,29 +64,29 @@ public:
 		mCenterPos = pos; 
 		mStageClearSprite->setPosition(pos+glm::vec2{0,600});
 	}
-	// ========== Իϵͳ ==========
+	// ========== 对话系统 ==========
 	bool mDialogueActived = false;
-	// ԤԻļ
+	// 预加载整个对话文件，但不激活
 	void preloadDialogueScript(const std::string& path);
-	// ضĶԻ
+	// 激活特定段落的对话
 	void activateDialogueSection(const std::string& sectionName);
 
-	// ǷпõĶԻ
+	// 检查是否有可用的对话段落
 	bool hasDialogueSection(const std::string& sectionName) const;
-	// ========== Чϵͳ ==========
+	// ========== 音效系统 ==========
 	bool preloadSoundEffect(const std::string& dirPath);
 	void playSoundEffect(const std::string& soundName);
 	void setSoundEffectVolume(float volume);
-	// ==========  ==========
+	// ========== 场景清理 ==========
 	void stageClear();
-	// ==========  ==========
+	// ========== 符卡吟诵 ==========
 	
-	// ========== ºȾ ==========
+	// ========== 更新和渲染 ==========
 	void render();
 	void update(double deltaTime);
 	void processInput(esl::Event& e);
 
-	// ==========  ==========
+	// ========== 辅助方法 ==========
 	void trim(std::wstring& str);
 	std::string parseStrVal(std::wstring& wstr);
 	std::wstring fileConvertToWideString(const std::string& path);
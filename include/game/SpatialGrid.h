@@ -1,65 +1,113 @@
 #pragma once
+#include <array>
 #include <vector>
-#include <unordered_map>
+#include <cstdint>
+#include <limits>
 #include <glm/glm.hpp>
-#include "Bullet.h"
 
-// ռٽṹ
+// 均匀网格加速结构
+// 覆盖整个游戏区域（768x896，64 像素一格），所有格子存放在一个平坦数组中。
+// 每帧用计数排序重建：物体按 行优先 的格子顺序连续存放，
+// 因此同一行里相邻的若干格子在数组中也是连续的一段。
+// 查询只返回这些连续区间，不做任何内存分配。
 class SpatialGrid {
-private:
-    struct Cell {
-        std::vector<Bullet*> bullets;
-    };
-    
-    std::unordered_map<int, Cell> mGrid;
-    float mCellSize;
-    int mGridWidth, mGridHeight;
-    
-    // 
-    int getCellIndex(const glm::vec2& pos) const {
-        int x = static_cast<int>(pos.x / mCellSize);
-        int y = static_cast<int>(pos.y / mCellSize);
-        return y * mGridWidth + x;
-    }
-    
 public:
-    SpatialGrid(float cellSize = 64.0f, int gridW = 14, int gridH = 16)
-        : mCellSize(cellSize), mGridWidth(gridW), mGridHeight(gridH) {}
-    
-    void clear() {
-        for (auto& [key, cell] : mGrid) {
-            cell.bullets.clear();
-        }
-    }
-    
-    // ӵ
-    void insert(Bullet* bullet) {
-        int idx = getCellIndex(bullet->getPosition());
-        mGrid[idx].bullets.push_back(bullet);
+    static constexpr float CELL_SIZE = 64.0f;
+    static constexpr int COLS = 12;   // 768 / 64
+    static constexpr int ROWS = 14;   // 896 / 64
+    static constexpr int CELL_COUNT = COLS * ROWS;
+
+    // 排序后数组中的一段 [begin, end)
+    struct Span {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        uint32_t size() const { return end - begin; }
+    };
+    // 一次矩形查询覆盖的每一行对应一段
+    struct Query {
+        std::array<Span, ROWS> rows;
+        int count = 0;
+        const Span* begin() const { return rows.data(); }
+        const Span* end() const { return rows.data() + count; }
+    };
+
+    // origin 为游戏区域左下角的世界坐标
+    explicit SpatialGrid(glm::vec2 origin = { 64.0f, 32.0f }) : mOrigin(origin) {}
+
+    // 以计数排序重建网格；radii 可以为空（全部视为 0）
+    void build(const float* xs, const float* ys, const float* radii, size_t count);
+
+    // 返回与矩形 [min, max] 重叠的所有格子，区域外的物体被归入边缘格子
+    Query query(glm::vec2 min, glm::vec2 max) const;
+    Query query(glm::vec2 center, float radius) const {
+        return query(center - glm::vec2(radius), center + glm::vec2(radius));
     }
-    
-    // ѯӵ
-    std::vector<Bullet*> query(const glm::vec2& pos, float radius) {
-        std::vector<Bullet*> results;
-        
-        // ҪΧ
-        int minX = static_cast<int>((pos.x - radius) / mCellSize);
-        int maxX = static_cast<int>((pos.x + radius) / mCellSize);
-        int minY = static_cast<int>((pos.y - radius) / mCellSize);
-        int maxY = static_cast<int>((pos.y + radius) / mCellSize);
-        
-        for (int y = minY; y <= maxY; ++y) {
-            for (int x = minX; x <= maxX; ++x) {
-                int idx = y * mGridWidth + x;
-                auto it = mGrid.find(idx);
-                if (it != mGrid.end()) {
-                    results.insert(results.end(), 
-                                   it->second.bullets.begin(), 
-                                   it->second.bullets.end());
+
+    // 由近到远逐圈搜索，返回满足 pred(原始下标) 的最近物体的原始下标，找不到返回 -1
+    template<typename Pred>
+    int64_t nearest(glm::vec2 pos, Pred&& pred) const {
+        if (mIndex.empty()) return -1;
+        const int cx = cellX(pos.x);
+        const int cy = cellY(pos.y);
+        int64_t best = -1;
+        float bestDist2 = std::numeric_limits<float>::max();
+        const int maxRing = COLS > ROWS ? COLS : ROWS;
+        for (int ring = 0; ring < maxRing; ++ring) {
+            // 第 ring 圈的格子离 pos 至少有 (ring - 1) 个格子宽，已找到更近的就停止
+            if (best >= 0) {
+                float reach = (ring - 1) * CELL_SIZE;
+                if (reach > 0 && reach * reach > bestDist2) break;
+            }
+            for (int y = cy - ring; y <= cy + ring; ++y) {
+                if (y < 0 || y >= ROWS) continue;
+                const bool edgeRow = (y == cy - ring || y == cy + ring);
+                for (int x = cx - ring; x <= cx + ring; x += (edgeRow ? 1 : 2 * ring)) {
+                    if (x >= 0 && x < COLS) {
+                        const int cell = y * COLS + x;
+                        for (uint32_t k = mCellStart[cell]; k < mCellStart[cell + 1]; ++k) {
+                            float dx = mX[k] - pos.x;
+                            float dy = mY[k] - pos.y;
+                            float d2 = dx * dx + dy * dy;
+                            if (d2 < bestDist2 && pred(mIndex[k])) {
+                                bestDist2 = d2;
+                                best = mIndex[k];
+                            }
+                        }
+                    }
                 }
             }
         }
-        
-        return results;
+        return best;
+    }
+
+    size_t size() const { return mIndex.size(); }
+    float maxRadius() const { return mMaxRadius; }
+
+    // 排序后第 k 个物体的原始下标与数据
+    uint32_t index(uint32_t k) const { return mIndex[k]; }
+    float x(uint32_t k) const { return mX[k]; }
+    float y(uint32_t k) const { return mY[k]; }
+    float radius(uint32_t k) const { return mRadius[k]; }
+    // 排序后的连续数组，供批量检测使用
+    const float* xData() const { return mX.data(); }
+    const float* yData() const { return mY.data(); }
+    const float* radiusData() const { return mRadius.data(); }
+
+private:
+    int cellX(float x) const {
+        int c = static_cast<int>((x - mOrigin.x) / CELL_SIZE);
+        return c < 0 ? 0 : (c >= COLS ? COLS - 1 : c);
     }
-};
\ No newline at end of file
+    int cellY(float y) const {
+        int c = static_cast<int>((y - mOrigin.y) / CELL_SIZE);
+        return c < 0 ? 0 : (c >= ROWS ? ROWS - 1 : c);
+    }
+
+    glm::vec2 mOrigin;
+    // mCellStart[c] .. mCellStart[c + 1] 为格子 c 在排序数组中的范围
+    std::array<uint32_t, CELL_COUNT + 1> mCellStart{};
+    std::vector<uint16_t> mCellOf;   // 构建时缓存每个物体所在的格子
+    std::vector<uint32_t> mIndex;    // 排序后的原始下标
+    std::vector<float> mX, mY, mRadius;
+    float mMaxRadius = 0.0f;
+};
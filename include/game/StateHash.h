@@ -0,0 +1,50 @@
+﻿#pragma once
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <type_traits>
+
+// ========== 模拟状态哈希 ==========
+// FNV-1a 64 位哈希，用于逐步比较两次运行的模拟状态是否完全一致。
+// 大块数据（子弹的各列）按 8 字节一组混入，比逐字节快约 8 倍，
+// 足以在基准测试中一直开启；只用于判等，不追求抗碰撞。
+// 浮点数按位参与哈希，因此 -0 与 +0、不同的 NaN 都视为不同状态
+class StateHash {
+public:
+	static constexpr uint64_t OFFSET = 14695981039346656037ull;
+	static constexpr uint64_t PRIME = 1099511628211ull;
+
+	void reset() { mHash = OFFSET; }
+	uint64_t value() const { return mHash; }
+
+	void add(const void* data, size_t bytes) {
+		const unsigned char* p = static_cast<const unsigned char*>(data);
+		uint64_t h = mHash;
+		for (; bytes >= 8; bytes -= 8, p += 8) {
+			uint64_t word;
+			std::memcpy(&word, p, 8);
+			h = (h ^ word) * PRIME;
+		}
+		for (; bytes > 0; bytes--, p++) {
+			h = (h ^ *p) * PRIME;
+		}
+		mHash = h;
+	}
+
+	template<typename T>
+	void add(const T& value) {
+		static_assert(std::is_trivially_copyable<T>::value, "StateHash::add needs a trivially copyable type");
+		add(&value, sizeof(T));
+	}
+
+	// 先混入长度，避免 [a][b] 与 [ab] 得到相同结果
+	template<typename T>
+	void add(const std::vector<T>& column) {
+		static_assert(std::is_trivially_copyable<T>::value, "StateHash::add needs a trivially copyable type");
+		add(static_cast<uint64_t>(column.size()));
+		add(column.data(), column.size() * sizeof(T));
+	}
+
+private:
+	uint64_t mHash = OFFSET;
+};
@@ -1,9 +1,81 @@
-#include <Game.h>
+﻿#include <Game.h>
+#include <HeadlessRunner.h>
+#include <Replay.h>
+#include <AssetPack.hpp>
+#include <cstring>
+#include <cstdlib>
 
-int main() {
+// 解析无窗口模式末尾的可选参数：--hash-out <文件>、--hash-check <文件>、--profile <文件>、
+// --alloc-report、--alloc-budget <次数>
+static void ParseHeadlessOptions(int argc, char** argv, int first, HeadlessOptions& options)
+{
+	for (int i = first; i < argc; i++) {
+		if (std::strcmp(argv[i], "--alloc-report") == 0) options.trackAllocations = true;
+		else if (i + 1 >= argc) break;
+		else if (std::strcmp(argv[i], "--hash-out") == 0) options.hashOutput = argv[++i];
+		else if (std::strcmp(argv[i], "--hash-check") == 0) options.hashCheck = argv[++i];
+		else if (std::strcmp(argv[i], "--profile") == 0) options.profileOutput = argv[++i];
+		else if (std::strcmp(argv[i], "--alloc-budget") == 0) options.allocationBudget = std::strtoll(argv[++i], nullptr, 10);
+	}
+}
+
+// 哈希文件无法读取或比较不一致时返回非零，便于在 CI 中使用
+static int RunHeadless(const HeadlessOptions& options)
+{
+	HeadlessReport report = HeadlessRunner::run(options);
+	HeadlessRunner::print(report);
+	if (report.hashFileError) return 3;
+	return report.hashMismatch == UINT64_MAX ? 0 : 2;
+}
+
+// 用法：
+//   OpenGL_test                              正常启动游戏
+//   OpenGL_test --record <文件>               正常游戏，并把第一局录制到文件
+//   OpenGL_test --replay <文件>               按录像以正常速度回放
+//   OpenGL_test --headless [帧数] [种子]      无窗口运行第一关并输出性能报告
+//   OpenGL_test --headless-replay <文件>      无窗口全速回放录像并输出性能报告
+// 两种无窗口模式都可以在末尾追加 --hash-out <文件> 记录每步的状态哈希，
+// 或 --hash-check <文件> 与之前记录的哈希逐步比较，--profile <文件> 导出 Chrome trace，
+// --alloc-report 打印分配报告，--alloc-budget <次数> 在某一步分配超出预算时终止
+// （后两项需以 ESL_TRACK_ALLOCATIONS 编译）
+// 工作目录下存在 Assets.pak（由 asset_packer 生成）时，纹理从资源包加载
+int main(int argc, char** argv) {
+	esl::AssetPack::mount("Assets.pak");
+	if (argc > 1 && std::strcmp(argv[1], "--headless") == 0) {
+		HeadlessOptions options;
+		int next = 2;
+		if (argc > next && std::strncmp(argv[next], "--", 2) != 0) {
+			options.frames = std::strtoull(argv[next++], nullptr, 10);
+		}
+		if (argc > next && std::strncmp(argv[next], "--", 2) != 0) {
+			options.seeded = true;
+			options.seed = static_cast<uint32_t>(std::strtoul(argv[next++], nullptr, 10));
+		}
+		ParseHeadlessOptions(argc, argv, next, options);
+		return RunHeadless(options);
+	}
+	if (argc > 2 && std::strcmp(argv[1], "--headless-replay") == 0) {
+		Replay replay;
+		if (!replay.load(argv[2])) return 1;
+		HeadlessOptions options;
+		options.frames = replay.size();
+		options.seeded = true;
+		options.seed = replay.seed();
+		options.input = [&replay](uint64_t frame, esl::Event& e) {
+			Replay::apply(replay.input(frame), e);
+		};
+		ParseHeadlessOptions(argc, argv, 3, options);
+		return RunHeadless(options);
+	}
 	Game game;
+	if (argc > 2 && std::strcmp(argv[1], "--record") == 0) {
+		game.recordReplay(argv[2]);
+	}
+	else if (argc > 2 && std::strcmp(argv[1], "--replay") == 0) {
+		if (!game.playReplay(argv[2])) return 1;
+	}
 	game.init();
 	game.run();
 	game.update();
 	game.destory();
-}
\ No newline at end of file
+}
@@ -0,0 +1,469 @@
+﻿#include"AllocTracker.hpp"
+#include<algorithm>
+#include<atomic>
+#include<cstdlib>
+#include<cstring>
+#include<new>
+#include<thread>
+#ifdef _WIN32
+#define NOMINMAX
+#include<windows.h>
+#include<dbghelp.h>
+#include<malloc.h>
+#elif defined(__GLIBC__)
+#include<cxxabi.h>
+#include<dlfcn.h>
+#include<execinfo.h>
+#endif
+
+#ifdef _MSC_VER
+#define ESL_NOINLINE __declspec(noinline)
+#else
+#define ESL_NOINLINE __attribute__((noinline))
+#endif
+
+namespace esl
+{
+	namespace
+	{
+		// 调用栈中要跳过的帧：AllocTracker::record 与 operator new 本身
+		constexpr int SKIP_FRAMES = 2;
+		static_assert((AllocTracker::MAX_SITES & (AllocTracker::MAX_SITES - 1)) == 0, "MAX_SITES must be a power of two");
+
+		struct ZoneSlot
+		{
+			const char* name;
+			AllocTracker::Counter counter;
+		};
+
+		struct SiteSlot
+		{
+			uint64_t hash;	// 0 表示空位
+			AllocTracker::Site site;
+		};
+
+		const char* const NO_ZONE = "(no zone)";
+		const char* const OTHER_ZONES = "(other zones)";
+
+		// 以下数据都是常量初始化的，operator new 在静态构造之前被调用也是安全的
+		std::atomic<bool> g_Enabled{ false };
+		std::atomic_flag g_Lock = ATOMIC_FLAG_INIT;
+		// 以下由 g_Lock 保护
+		ZoneSlot g_Zones[AllocTracker::MAX_ZONES];
+		size_t g_ZoneCount = 0;
+		ZoneSlot g_LastZones[AllocTracker::MAX_ZONES];
+		size_t g_LastZoneCount = 0;
+		SiteSlot g_Sites[AllocTracker::MAX_SITES];
+		size_t g_SiteCount = 0;
+		AllocTracker::Counter g_Frame, g_LastFrame, g_Total;
+		// 预算在开始跟踪前设置
+		uint64_t g_Budget = 0;
+		AllocTracker::BudgetMode g_BudgetMode = AllocTracker::BudgetMode::Off;
+
+		// 跟踪器自身（以及它调用的系统函数）的分配不计入统计，也避免重入时死锁
+		thread_local bool t_Busy = false;
+		// 本线程的分配次数，预算作用域只统计打开它的线程，
+		// 同时运行的纹理解码、任务和音频线程不影响结果
+		thread_local uint64_t t_Allocations = 0;
+
+		struct BusyScope
+		{
+			bool previous;
+			BusyScope() : previous(t_Busy) { t_Busy = true; }
+			~BusyScope() { t_Busy = previous; }
+		};
+
+		struct LockScope
+		{
+			BusyScope busy;
+			LockScope() {
+				while (g_Lock.test_and_set(std::memory_order_acquire)) std::this_thread::yield();
+			}
+			~LockScope() { g_Lock.clear(std::memory_order_release); }
+		};
+
+		int captureStack(void** frames)
+		{
+#ifdef _WIN32
+			return RtlCaptureStackBackTrace(SKIP_FRAMES, AllocTracker::STACK_DEPTH, frames, nullptr);
+#elif defined(__GLIBC__)
+			void* buffer[AllocTracker::STACK_DEPTH + SKIP_FRAMES];
+			int depth = backtrace(buffer, AllocTracker::STACK_DEPTH + SKIP_FRAMES) - SKIP_FRAMES;
+			if (depth <= 0) return 0;
+			std::memcpy(frames, buffer + SKIP_FRAMES, depth * sizeof(void*));
+			return depth;
+#else
+			(void)frames;
+			return 0;
+#endif
+		}
+
+		void add(AllocTracker::Counter& counter, size_t bytes)
+		{
+			counter.allocations++;
+			counter.bytes += bytes;
+		}
+
+		ZoneSlot& zoneSlot(const char* name)
+		{
+			if (!name) name = NO_ZONE;
+			for (size_t i = 0; i < g_ZoneCount; i++) {
+				if (g_Zones[i].name == name || std::strcmp(g_Zones[i].name, name) == 0) return g_Zones[i];
+			}
+			if (g_ZoneCount == AllocTracker::MAX_ZONES) {
+				g_Zones[g_ZoneCount - 1].name = OTHER_ZONES;
+				return g_Zones[g_ZoneCount - 1];
+			}
+			g_Zones[g_ZoneCount] = ZoneSlot{ name, {} };
+			return g_Zones[g_ZoneCount++];
+		}
+
+		// 开放寻址；表填到四分之三后新的调用位置不再登记
+		AllocTracker::Site* siteSlot(void** frames, int depth)
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for (int i = 0; i < depth; i++) {
+				hash ^= static_cast<uint64_t>(reinterpret_cast<uintptr_t>(frames[i]));
+				hash *= 1099511628211ull;
+			}
+			hash |= 1;
+			for (size_t probe = 0; probe < AllocTracker::MAX_SITES; probe++) {
+				SiteSlot& slot = g_Sites[(hash + probe) & (AllocTracker::MAX_SITES - 1)];
+				if (slot.hash == hash && slot.site.depth == depth &&
+					std::equal(frames, frames + depth, slot.site.frames)) {
+					return &slot.site;
+				}
+				if (slot.hash == 0) {
+					if (g_SiteCount >= AllocTracker::MAX_SITES * 3 / 4) return nullptr;
+					slot.hash = hash;
+					slot.site.depth = depth;
+					std::copy(frames, frames + depth, slot.site.frames);
+					g_SiteCount++;
+					return &slot.site;
+				}
+			}
+			return nullptr;
+		}
+
+		std::vector<AllocTracker::ZoneStats> sortedZones(const ZoneSlot* zones, size_t count)
+		{
+			std::vector<AllocTracker::ZoneStats> result;
+			for (size_t i = 0; i < count; i++) {
+				result.push_back(AllocTracker::ZoneStats{ zones[i].name, zones[i].counter });
+			}
+			std::sort(result.begin(), result.end(), [](const AllocTracker::ZoneStats& a, const AllocTracker::ZoneStats& b) {
+				return a.counter.allocations > b.counter.allocations;
+			});
+			return result;
+		}
+
+		void writeZones(std::FILE* file, const AllocTracker::Counter& frame, const std::vector<AllocTracker::ZoneStats>& zones)
+		{
+			std::fprintf(file, "[Alloc] %llu allocations, %llu bytes\n",
+				static_cast<unsigned long long>(frame.allocations), static_cast<unsigned long long>(frame.bytes));
+			for (const auto& zone : zones) {
+				std::fprintf(file, "[Alloc]   %-28s %8llu %12llu bytes\n", zone.name,
+					static_cast<unsigned long long>(zone.counter.allocations), static_cast<unsigned long long>(zone.counter.bytes));
+			}
+		}
+
+		void writeFrame(std::FILE* file, void* address)
+		{
+#ifdef _WIN32
+			static bool initialized = false;
+			HANDLE process = GetCurrentProcess();
+			if (!initialized) {
+				SymSetOptions(SYMOPT_UNDNAME | SYMOPT_DEFERRED_LOADS | SYMOPT_LOAD_LINES);
+				SymInitialize(process, nullptr, TRUE);
+				initialized = true;
+			}
+			char buffer[sizeof(SYMBOL_INFO) + 256];
+			SYMBOL_INFO* symbol = reinterpret_cast<SYMBOL_INFO*>(buffer);
+			symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+			symbol->MaxNameLen = 255;
+			DWORD64 displacement = 0;
+			const DWORD64 value = reinterpret_cast<DWORD64>(address);
+			if (SymFromAddr(process, value, &displacement, symbol)) {
+				IMAGEHLP_LINE64 line = {};
+				line.SizeOfStruct = sizeof(line);
+				DWORD lineDisplacement = 0;
+				if (SymGetLineFromAddr64(process, value, &lineDisplacement, &line)) {
+					std::fprintf(file, "        %s (%s:%lu)\n", symbol->Name, line.FileName, line.LineNumber);
+				}
+				else {
+					std::fprintf(file, "        %s+0x%llx\n", symbol->Name, static_cast<unsigned long long>(displacement));
+				}
+				return;
+			}
+#elif defined(__GLIBC__)
+			Dl_info info;
+			if (dladdr(address, &info)) {
+				if (info.dli_sname) {
+					int status = 0;
+					char* name = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+					std::fprintf(file, "        %s+0x%zx\n", status == 0 && name ? name : info.dli_sname,
+						static_cast<size_t>(static_cast<char*>(address) - static_cast<char*>(info.dli_saddr)));
+					std::free(name);
+				}
+				else {
+					// 未导出的符号，可用 addr2line -e <模块> <偏移> 解析
+					std::fprintf(file, "        %s+0x%zx\n", info.dli_fname,
+						static_cast<size_t>(static_cast<char*>(address) - static_cast<char*>(info.dli_fbase)));
+				}
+				return;
+			}
+#endif
+			std::fprintf(file, "        %p\n", address);
+		}
+	}
+
+	bool AllocTracker::available()
+	{
+#ifdef ESL_TRACK_ALLOCATIONS
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void AllocTracker::setEnabled(bool enabled)
+	{
+		if (enabled && !available()) {
+			std::fprintf(stderr, "[AllocTracker] not compiled in, build with ESL_TRACK_ALLOCATIONS\n");
+			return;
+		}
+		// 区段归类需要 Profiler 的区段生效
+		if (enabled) Profiler::setEnabled(true);
+		g_Enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	bool AllocTracker::enabled()
+	{
+		return g_Enabled.load(std::memory_order_relaxed);
+	}
+
+	ESL_NOINLINE void AllocTracker::record(size_t bytes)
+	{
+		if (!g_Enabled.load(std::memory_order_relaxed) || t_Busy) return;
+		BusyScope busy;
+		void* frames[STACK_DEPTH];
+		const int depth = captureStack(frames);
+		const char* zone = Profiler::currentZone();
+		{
+			LockScope lock;
+			add(zoneSlot(zone).counter, bytes);
+			add(g_Frame, bytes);
+			add(g_Total, bytes);
+			if (Site* site = siteSlot(frames, depth)) add(site->counter, bytes);
+		}
+		t_Allocations++;
+	}
+
+	void AllocTracker::frame()
+	{
+		if (!enabled()) return;
+		LockScope lock;
+		std::copy(g_Zones, g_Zones + g_ZoneCount, g_LastZones);
+		g_LastZoneCount = g_ZoneCount;
+		g_ZoneCount = 0;
+		g_LastFrame = g_Frame;
+		g_Frame = Counter();
+	}
+
+	AllocTracker::Counter AllocTracker::lastFrame()
+	{
+		LockScope lock;
+		return g_LastFrame;
+	}
+
+	std::vector<AllocTracker::ZoneStats> AllocTracker::lastFrameZones()
+	{
+		LockScope lock;
+		return sortedZones(g_LastZones, g_LastZoneCount);
+	}
+
+	AllocTracker::Counter AllocTracker::total()
+	{
+		LockScope lock;
+		return g_Total;
+	}
+
+	std::vector<AllocTracker::Site> AllocTracker::topSites(size_t count)
+	{
+		LockScope lock;
+		std::vector<Site> sites;
+		for (const SiteSlot& slot : g_Sites) {
+			if (slot.hash != 0) sites.push_back(slot.site);
+		}
+		std::sort(sites.begin(), sites.end(), [](const Site& a, const Site& b) {
+			return a.counter.allocations > b.counter.allocations;
+		});
+		if (sites.size() > count) sites.resize(count);
+		return sites;
+	}
+
+	void AllocTracker::reset()
+	{
+		LockScope lock;
+		g_ZoneCount = 0;
+		g_LastZoneCount = 0;
+		std::fill(g_Sites, g_Sites + MAX_SITES, SiteSlot{});
+		g_SiteCount = 0;
+		g_Frame = g_LastFrame = g_Total = Counter();
+	}
+
+	void AllocTracker::writeReport(std::FILE* file, size_t siteCount)
+	{
+		BusyScope busy;
+		const Counter all = total();
+		std::fprintf(file, "[Alloc] total %llu allocations, %llu bytes; last frame:\n",
+			static_cast<unsigned long long>(all.allocations), static_cast<unsigned long long>(all.bytes));
+		writeZones(file, lastFrame(), lastFrameZones());
+		const std::vector<Site> sites = topSites(siteCount);
+		for (size_t i = 0; i < sites.size(); i++) {
+			std::fprintf(file, "[Alloc] site #%zu: %llu allocations, %llu bytes\n", i + 1,
+				static_cast<unsigned long long>(sites[i].counter.allocations), static_cast<unsigned long long>(sites[i].counter.bytes));
+			for (int k = 0; k < sites[i].depth; k++) {
+				writeFrame(file, sites[i].frames[k]);
+			}
+		}
+	}
+
+	void AllocTracker::setBudget(uint64_t allocations, BudgetMode mode)
+	{
+		g_Budget = allocations;
+		g_BudgetMode = mode;
+	}
+
+	AllocBudgetScope::AllocBudgetScope(const char* name)
+		: m_Name(name), m_Active(AllocTracker::enabled() && g_BudgetMode != AllocTracker::BudgetMode::Off)
+	{
+		if (m_Active) m_Begin = t_Allocations;
+	}
+
+	AllocBudgetScope::~AllocBudgetScope()
+	{
+		if (!m_Active) return;
+		const uint64_t used = t_Allocations - m_Begin;
+		if (used <= g_Budget) return;
+		BusyScope busy;
+		std::fprintf(stderr, "[Alloc] %s: %llu allocations, budget %llu\n", m_Name,
+			static_cast<unsigned long long>(used), static_cast<unsigned long long>(g_Budget));
+		if (g_BudgetMode == AllocTracker::BudgetMode::Assert) {
+			// 打印本帧到目前为止的各区段，再给出累计最多的调用位置
+			std::vector<AllocTracker::ZoneStats> zones;
+			AllocTracker::Counter frame;
+			{
+				LockScope lock;
+				zones = sortedZones(g_Zones, g_ZoneCount);
+				frame = g_Frame;
+			}
+			std::fprintf(stderr, "[Alloc] current frame:\n");
+			writeZones(stderr, frame, zones);
+			AllocTracker::writeReport(stderr);
+			std::fflush(stderr);
+			std::abort();
+		}
+	}
+}
+
+#ifdef ESL_TRACK_ALLOCATIONS
+// 替换全局 operator new/delete。每个分配函数直接调用 record，
+// 使 record 看到的调用栈固定为 record <- operator new <- 调用者
+void* operator new(std::size_t size)
+{
+	void* p = std::malloc(size ? size : 1);
+	if (!p) throw std::bad_alloc();
+	esl::AllocTracker::record(size);
+	return p;
+}
+
+void* operator new[](std::size_t size)
+{
+	void* p = std::malloc(size ? size : 1);
+	if (!p) throw std::bad_alloc();
+	esl::AllocTracker::record(size);
+	return p;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	void* p = std::malloc(size ? size : 1);
+	if (p) esl::AllocTracker::record(size);
+	return p;
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	void* p = std::malloc(size ? size : 1);
+	if (p) esl::AllocTracker::record(size);
+	return p;
+}
+
+namespace
+{
+	void* alignedMalloc(std::size_t size, std::align_val_t align)
+	{
+		const std::size_t alignment = static_cast<std::size_t>(align);
+		size = size ? size : 1;
+#ifdef _WIN32
+		return _aligned_malloc(size, alignment);
+#else
+		// aligned_alloc 要求大小是对齐的整数倍
+		return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+	}
+
+	void alignedFree(void* p)
+	{
+#ifdef _WIN32
+		_aligned_free(p);
+#else
+		std::free(p);
+#endif
+	}
+}
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+	void* p = alignedMalloc(size, align);
+	if (!p) throw std::bad_alloc();
+	esl::AllocTracker::record(size);
+	return p;
+}
+
+void* operator new[](std::size_t size, std::align_val_t align)
+{
+	void* p = alignedMalloc(size, align);
+	if (!p) throw std::bad_alloc();
+	esl::AllocTracker::record(size);
+	return p;
+}
+
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+	void* p = alignedMalloc(size, align);
+	if (p) esl::AllocTracker::record(size);
+	return p;
+}
+
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+	void* p = alignedMalloc(size, align);
+	if (p) esl::AllocTracker::record(size);
+	return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(p); }
+#endif
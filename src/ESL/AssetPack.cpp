@@ -0,0 +1,173 @@
+﻿#include"AssetPack.hpp"
+#include<algorithm>
+#include<cstring>
+#include<iostream>
+#include<string_view>
+#ifdef _WIN32
+#define NOMINMAX
+#include<windows.h>
+#else
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#endif
+
+namespace esl
+{
+	namespace
+	{
+		struct Mapping {
+			const unsigned char* data = nullptr;
+			size_t size = 0;
+#ifdef _WIN32
+			HANDLE file = INVALID_HANDLE_VALUE;
+			HANDLE mapping = nullptr;
+#endif
+		};
+		Mapping s_Mapping;
+		const AssetPackHeader* s_Header = nullptr;
+		const AssetPackEntry* s_Entries = nullptr;
+		const char* s_Names = nullptr;
+
+		bool mapFile(const std::string& path, Mapping& mapping)
+		{
+#ifdef _WIN32
+			mapping.file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (mapping.file == INVALID_HANDLE_VALUE) return false;
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(mapping.file, &size) || size.QuadPart == 0) {
+				CloseHandle(mapping.file);
+				mapping.file = INVALID_HANDLE_VALUE;
+				return false;
+			}
+			mapping.mapping = CreateFileMappingA(mapping.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping.mapping) {
+				mapping.data = static_cast<const unsigned char*>(MapViewOfFile(mapping.mapping, FILE_MAP_READ, 0, 0, 0));
+			}
+			if (!mapping.data) {
+				if (mapping.mapping) CloseHandle(mapping.mapping);
+				CloseHandle(mapping.file);
+				mapping = Mapping();
+				return false;
+			}
+			mapping.size = static_cast<size_t>(size.QuadPart);
+			return true;
+#else
+			int fd = open(path.c_str(), O_RDONLY);
+			if (fd < 0) return false;
+			struct stat info;
+			if (fstat(fd, &info) != 0 || info.st_size == 0) {
+				close(fd);
+				return false;
+			}
+			void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			// 映射建立后即可关闭文件描述符
+			close(fd);
+			if (data == MAP_FAILED) return false;
+			mapping.data = static_cast<const unsigned char*>(data);
+			mapping.size = static_cast<size_t>(info.st_size);
+			return true;
+#endif
+		}
+		void unmapFile(Mapping& mapping)
+		{
+			if (!mapping.data) return;
+#ifdef _WIN32
+			UnmapViewOfFile(mapping.data);
+			CloseHandle(mapping.mapping);
+			CloseHandle(mapping.file);
+#else
+			munmap(const_cast<unsigned char*>(mapping.data), mapping.size);
+#endif
+			mapping = Mapping();
+		}
+
+		// 检查索引与每个像素块都落在文件范围内，之后的查找不再检查
+		bool validate(const Mapping& mapping)
+		{
+			if (mapping.size < sizeof(AssetPackHeader)) return false;
+			auto header = reinterpret_cast<const AssetPackHeader*>(mapping.data);
+			if (std::memcmp(header->magic, AssetPack::MAGIC, 4) != 0 || header->version != AssetPack::VERSION) return false;
+			uint64_t indexSize = static_cast<uint64_t>(header->entryCount) * sizeof(AssetPackEntry);
+			if (header->indexOffset % alignof(AssetPackEntry) != 0
+				|| header->indexOffset > mapping.size || indexSize > mapping.size - header->indexOffset
+				|| header->namesOffset > mapping.size) return false;
+			auto entries = reinterpret_cast<const AssetPackEntry*>(mapping.data + header->indexOffset);
+			uint64_t namesSize = mapping.size - header->namesOffset;
+			for (uint32_t i = 0; i < header->entryCount; i++) {
+				const AssetPackEntry& entry = entries[i];
+				uint64_t bytes = static_cast<uint64_t>(entry.width) * entry.height * 4;
+				if (static_cast<uint64_t>(entry.nameOffset) + entry.nameLength > namesSize) return false;
+				if (entry.dataOffset > mapping.size || bytes > mapping.size - entry.dataOffset) return false;
+			}
+			return true;
+		}
+
+		std::string_view nameOf(const AssetPackEntry& entry)
+		{
+			return std::string_view(s_Names + entry.nameOffset, entry.nameLength);
+		}
+	}
+
+	bool AssetPack::mount(const std::string& path)
+	{
+		unmount();
+		Mapping mapping;
+		if (!mapFile(path, mapping)) return false;
+		if (!validate(mapping)) {
+			std::cout << "AssetPack: invalid pack file " << path << std::endl;
+			unmapFile(mapping);
+			return false;
+		}
+		s_Mapping = mapping;
+		s_Header = reinterpret_cast<const AssetPackHeader*>(mapping.data);
+		s_Entries = reinterpret_cast<const AssetPackEntry*>(mapping.data + s_Header->indexOffset);
+		s_Names = reinterpret_cast<const char*>(mapping.data + s_Header->namesOffset);
+		return true;
+	}
+	void AssetPack::unmount()
+	{
+		unmapFile(s_Mapping);
+		s_Header = nullptr;
+		s_Entries = nullptr;
+		s_Names = nullptr;
+	}
+	bool AssetPack::mounted()
+	{
+		return s_Header != nullptr;
+	}
+	uint32_t AssetPack::size()
+	{
+		return s_Header ? s_Header->entryCount : 0;
+	}
+
+	bool AssetPack::findImage(const std::string& path, Image& image)
+	{
+		if (!s_Header) return false;
+		std::string key = normalize(path);
+		const AssetPackEntry* end = s_Entries + s_Header->entryCount;
+		const AssetPackEntry* it = std::lower_bound(s_Entries, end, std::string_view(key),
+			[](const AssetPackEntry& entry, std::string_view name) { return nameOf(entry) < name; });
+		if (it == end || nameOf(*it) != key) return false;
+		image.pixels = s_Mapping.data + it->dataOffset;
+		image.width = static_cast<int>(it->width);
+		image.height = static_cast<int>(it->height);
+		return true;
+	}
+
+	std::string AssetPack::normalize(const std::string& path)
+	{
+		std::string result;
+		result.reserve(path.size());
+		for (char c : path) {
+			if (c == '\\') c = '/';
+			else if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+			// 合并重复的分隔符
+			if (c == '/' && !result.empty() && result.back() == '/') continue;
+			result.push_back(c);
+		}
+		while (result.compare(0, 2, "./") == 0) result.erase(0, 2);
+		return result;
+	}
+}
@@ -56,7 +56,7 @@ namespace esl
 	{
 		if (m_Initialized) {
 			ma_sound_seek_to_pcm_frame(&m_Sound, frame);
-			// ͣλ
+			// 更新暂停光标位置
 			m_PausedCurser = frame;
 		}
 	}
@@ -1,14 +1,26 @@
-#include "AudioEngine.hpp"
+﻿#include "AudioEngine.hpp"
+#include "ESL.hpp"
 namespace esl
 {
+	// 无窗口模式下不打开音频设备：声音照常加载和播放，但不输出，也不创建设备线程
+	static void applyHeadless(ma_engine_config& engineConfig)
+	{
+		if (!IsHeadless()) return;
+		engineConfig.noDevice = MA_TRUE;
+		engineConfig.channels = 2;
+		if (engineConfig.sampleRate == 0) engineConfig.sampleRate = 44100;
+	}
 	AudioEngine::AudioEngine()
 	{
-		ma_engine_init(nullptr, &m_Engine);
+		ma_engine_config engineConfig = ma_engine_config_init();
+		applyHeadless(engineConfig);
+		ma_engine_init(&engineConfig, &m_Engine);
 	}
 	AudioEngine::AudioEngine(ma_uint64 sampleRate)
 	{
 		ma_engine_config engineConfig = ma_engine_config_init();
 		engineConfig.sampleRate = static_cast<ma_uint32>(sampleRate);
+		applyHeadless(engineConfig);
 		ma_engine_init(&engineConfig, &m_Engine);
 	}
 	AudioEngine::~AudioEngine()
@@ -1,10 +1,11 @@
 #include "BlurEffect.hpp"
+#include "ShaderLibrary.hpp"
 #include <iostream>
 #include <glad/glad.h>
 namespace esl
 {
-    // ȫ Quad  (process ׶ר)
-    //  NDC (-1, -1)  (1, 1)UV (0, 0)  (1, 1)
+    // 定义全屏 Quad 数据 (process 阶段专用)
+    // 覆盖 NDC (-1, -1) 到 (1, 1)，UV (0, 0) 到 (1, 1)
     static const float g_quadVertices[] = {
         // positions   // texCoords
         -1.0f,  1.0f,  0.0f, 1.0f,
@@ -20,8 +21,8 @@ namespace esl
     {
         initFrameBuffers();
         initShader();
-        initProcessQuad(); // ʼõ Quad
-        // Ĭȫף֤ʱȾɫ
+        initProcessQuad(); // 新增：初始化处理用的 Quad
+        // 默认全白，保证混合时不染色
         m_Color = glm::vec4(1.0f);
     }
 
@@ -52,7 +53,7 @@ namespace esl
             glBindFramebuffer(GL_FRAMEBUFFER, m_pingPongFBO[i]);
             glBindTexture(GL_TEXTURE_2D, m_pingPongColorbuffers[i]);
 
-            // ڴ
+            // 分配内存
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, (int)m_effectSize.x, (int)m_effectSize.y, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
 
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -68,7 +69,7 @@ namespace esl
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
     }
 
-    // ʼȫ Quad
+    // 新增：初始化全屏 Quad
     void BlurEffect::initProcessQuad()
     {
         glGenVertexArrays(1, &m_processVAO);
@@ -87,7 +88,7 @@ namespace esl
 
     void BlurEffect::initShader()
     {
-        //  Vertex Shader
+        // 简化 Vertex Shader
         const std::string vertexCode = R"(
             #version 460 core
             layout (location = 0) in vec3 aPos;
@@ -111,7 +112,7 @@ namespace esl
             }
         )";
 
-        // Fragment Shader ֲ
+        // Fragment Shader 保持不变
         const std::string fragmentCode = R"(
             #version 460 core
             out vec4 FragColor;
@@ -120,22 +121,22 @@ namespace esl
             uniform sampler2D image;
             uniform bool horizontal;
             uniform bool isProcess; 
-            uniform vec4 spriteColor; // []  Sprite ɫ/͸
-            uniform float spread;     // [] ɢϵ
+            uniform vec4 spriteColor; // [新增] 接收 Sprite 的颜色/透明度
+            uniform float spread;     // [新增] 扩散系数
             
             uniform float weight[5] = float[] (0.227027, 0.1945946, 0.1216216, 0.054054, 0.016216);
 
             void main()
             {             
                 if (!isProcess) {
-                    // [޸] ԭʼɫ * spriteColor
+                    // [修改] 混合原始颜色 * spriteColor
                     vec4 texColor = texture(image, TexCoord);
                     FragColor = texColor * spriteColor;
                     return;
                 }
 
-                // Process ׶Σ˹ģ (ⲿֲҪ spriteColorΪӦǴݵ)
-                // ֻ draw ׶βҪӦ͸
+                // Process 阶段：高斯模糊 (这部分不需要乘以 spriteColor，因为处理过程应该是纯数据的)
+                // 只有最终 draw 阶段才需要应用透明度
                 vec2 tex_offset = spread / textureSize(image, 0); 
                 vec3 result = texture(image, TexCoord).rgb * weight[0]; 
                 
@@ -155,12 +156,12 @@ namespace esl
                         result += texture(image, TexCoord - vec2(0.0, tex_offset.y * i)).rgb * weight[i];
                     }
                 }
-                FragColor = vec4(result, 1.0); //  Alpha = 1.0
+                FragColor = vec4(result, 1.0); // 过程纹理保持 Alpha = 1.0
             }
         )";
 
-        if (m_Shader) delete m_Shader;
-        m_Shader = new Shader(vertexCode, fragmentCode);
+        m_Shader = ShaderLibrary::get(vertexCode, fragmentCode);
+        resolveUniforms();
     }
 
     void BlurEffect::captureScreen(esl::Window& window, const glm::vec2& regionPos, const glm::vec2& regionSize) {
@@ -168,16 +169,16 @@ namespace esl
         glReadBuffer(GL_BACK);
         glActiveTexture(GL_TEXTURE0);
         
-        // ȡ buffer [0]
+        // 读取到 buffer [0]
         glBindTexture(GL_TEXTURE_2D, m_pingPongColorbuffers[0]);
         glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, (GLint)regionPos.x, (GLint)regionPos.y, (GLint)regionSize.x, (GLint)regionSize.y);
         glBindTexture(GL_TEXTURE_2D, 0);
 
         m_Size = regionSize;
-        //  Sprite λΪģȷ draw ʱλȷ
-        //  regionPos ½
-        //  Sprite ΪԭģҪ Sprite õ
-        // 򵥼: Sprite ԭ m_Origin  (0,0) (Quad)
+        // 设置 Sprite 位置为区域中心，确保 draw 时位置正确
+        // 假设 regionPos 是左下角
+        // 假设 Sprite 绘制是以中心为原点的，或者你需要根据 Sprite 设置调整
+        // 简单假设: Sprite 的原点 m_Origin 是 (0,0) (Quad中心)
         glm::vec2 centerPos = regionPos + regionSize * 0.5f;
         m_Position = glm::vec3(centerPos.x, centerPos.y, 0.0f);
     }
@@ -200,7 +201,7 @@ namespace esl
         bool horizontal = true;
         bool first_iteration = true;
 
-        // ʹרõȫ Quad VAO
+        // 使用专用的全屏 Quad VAO
         glBindVertexArray(m_processVAO);
 
         for (int i = 0; i < m_iterations; i++)
@@ -208,18 +209,18 @@ namespace esl
             glBindFramebuffer(GL_FRAMEBUFFER, m_pingPongFBO[horizontal]);
             m_Shader->setInt("horizontal", horizontal);
 
-            // Դ: һ buffer[0] (capture)֮ buffer[!horizontal]
-            // ע⣺һд buffer[1] (Horiz: true)Ҳǽ buffer[0] д buffer[1]
+            // 绑定源: 第一次是 buffer[0] (capture内容)，之后是 buffer[!horizontal]
+            // 注意：第一次写入 buffer[1] (Horiz: true)，也就是将 buffer[0] 处理后写入 buffer[1]
             glBindTexture(GL_TEXTURE_2D, first_iteration ? m_pingPongColorbuffers[0] : m_pingPongColorbuffers[!horizontal]);
 
-            // ȫƣ6㣬Ϊ triangles
+            // 全屏绘制（6个点，因为是 triangles）
             glDrawArrays(GL_TRIANGLES, 0, 6);
 
             horizontal = !horizontal;
             if (first_iteration) first_iteration = false;
         }
 
-        glBindFramebuffer(GL_FRAMEBUFFER, 0); // ָĻ FBO
+        glBindFramebuffer(GL_FRAMEBUFFER, 0); // 恢复屏幕 FBO
         m_Shader->setInt("isProcess", 0);
 
         m_Shader->unload();
@@ -232,7 +233,7 @@ namespace esl
         if (!m_Shader) return;
 
         m_Shader->load();
-        m_Shader->setInt("isProcess", 0); // ƽ׶
+        m_Shader->setInt("isProcess", 0); // 绘制阶段
         m_Shader->setVec4("spriteColor", m_Color);
         glActiveTexture(GL_TEXTURE0);
 
@@ -11,7 +11,7 @@ void esl::Rectangle::setSize(const glm::vec2& size)
 	setupGeometry();
 }
 
-// д߼
+// 重写绘制逻辑
 void esl::Rectangle::draw(float right, float top)
 {
 	if (!m_shapeShader) {
@@ -20,18 +20,18 @@ void esl::Rectangle::draw(float right, float top)
 	GLboolean depthTestEnabled = glIsEnabled(GL_DEPTH_TEST);
 	GLboolean cullFaceEnabled = glIsEnabled(GL_CULL_FACE);
 
-	// 1. رȲԣȷ˾ϲ
+	// 1. 关闭深度测试，确保滤镜覆盖在最上层
 	glDisable(GL_DEPTH_TEST);
-	// 2. ر޳ֹ˳µĲʾ
+	// 2. 关闭面剔除，防止顶点顺序导致的不显示
 	glDisable(GL_CULL_FACE);
 
-	// 3. ûϲ÷
+	// 3. 启用混合并设置反相
 	glEnable(GL_BLEND);
 	
 
 	m_shapeShader->load();
 
-	// 4. þ
+	// 4. 设置矩阵
 	glm::mat4 model = glm::mat4(1.0f);
 	model = glm::translate(model, glm::vec3(m_position, 0.0f));
 	model = glm::rotate(model, glm::radians(m_rotation), glm::vec3(0.0f, 0.0f, 1.0f));
@@ -51,13 +51,13 @@ void esl::Rectangle::draw(float right, float top)
 		m_color
 	);
 
-	// 5. 
+	// 5. 绘制
 	glBindVertexArray(VAO);
-	if (!VAO) setupGeometry(); // Լ
+	if (!VAO) setupGeometry(); // 防御性检查
 	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 	glBindVertexArray(0);
 
-	// 6. ָ״̬
+	// 6. 恢复状态
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	if (depthTestEnabled) glEnable(GL_DEPTH_TEST);
@@ -68,23 +68,23 @@ void esl::Rectangle::draw(float right, float top)
 
 void esl::Rectangle::setupGeometry()
 {
-	//  (0,0) Ϊĵľζ
+	// 定义以 (0,0) 为中心的矩形顶点
 	float w = m_size.x / 2.0f;
 	float h = m_size.y / 2.0f;
 
 	float vertices[] = {
-		w,  h,  // 
-		w, -h,  // 
-		-w, -h,  // 
-		-w,  h   // 
+		w,  h,  // 右上
+		w, -h,  // 右下
+		-w, -h,  // 左下
+		-w,  h   // 左上
 	};
 
 	unsigned int indices[] = {
-		0, 1, 3, // һ
-		1, 2, 3  // ڶ
+		0, 1, 3, // 第一个三角形
+		1, 2, 3  // 第二个三角形
 	};
 
-	// ʼ Shape ж protected Ա VAO/VBO/EBO
+	// 初始化 Shape 类中定义的 protected 成员 VAO/VBO/EBO
 	glGenVertexArrays(1, &VAO);
 	glGenBuffers(1, &VBO);
 	glGenBuffers(1, &EBO);
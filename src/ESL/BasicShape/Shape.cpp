@@ -1,4 +1,5 @@
 #include<Shape.hpp>
+#include<ShaderLibrary.hpp>
 
 namespace esl
 {
@@ -23,15 +24,11 @@ namespace esl
 			fragColor = color;
 		}
 	)";
-		m_shapeShader = new Shader(vertexShader, fragmentShader);
+		m_shapeShader = ShaderLibrary::get(vertexShader, fragmentShader);
 	}
 
 	Shape::~Shape()
 	{
-		if (this->m_shapeShader)
-		{
-			delete m_shapeShader;
-		}
 	}
 
 	void Shape::setColor(glm::vec4 color)
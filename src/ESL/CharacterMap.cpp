@@ -1,4 +1,5 @@
 #include "CharacterMap.hpp"
+#include "ResourceCache.hpp"
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
 
@@ -6,12 +7,12 @@ namespace esl
 {
 	void CharacterMap::loadFromFile(const std::string& filePath)
 	{
-		m_MapTexture = std::make_unique<Texture>(filePath.c_str());
+		m_MapTexture = TextureCache::get(filePath);
 	}
 
-	void CharacterMap::loadFromTexture(const esl::Texture& texture)
+	void CharacterMap::loadFromTexture(std::shared_ptr<Texture> texture)
 	{
-		m_MapTexture = std::make_unique<Texture>(texture);
+		m_MapTexture = std::move(texture);
 	}
 
 
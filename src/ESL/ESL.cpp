@@ -1,8 +1,10 @@
-#include "ESL.hpp"
+﻿#include "ESL.hpp"
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
 #include "Text.hpp"
 #include "Font.hpp"
+#include "ShaderLibrary.hpp"
+#include "Sprite.hpp"
 namespace esl
 {
 	void Initialize()
@@ -19,8 +21,36 @@ namespace esl
 		Font::init();
 		isInitialized = true;
 	}
+	static bool s_Headless = false;
+
+	void InitializeHeadless()
+	{
+		static bool isInitialized = false;
+		if (isInitialized)
+		{
+			return;
+		}
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+		if (!glfwInit())
+		{
+			std::cout << "Failed to initialize GLFW (null platform)" << std::endl;
+		}
+		glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+		Font::init();
+		s_Headless = true;
+		isInitialized = true;
+	}
+
+	bool IsHeadless()
+	{
+		return s_Headless;
+	}
+
 	void Terminate()
 	{
+		// 共享的 GL 资源必须在上下文销毁前释放
+		ShaderLibrary::clear();
+		Sprite::releaseSharedQuad();
 		glfwTerminate();
 	}
 
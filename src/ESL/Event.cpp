@@ -38,6 +38,11 @@ namespace esl
 		return m_Mouse.getMouseState(button);
 	}
 
+	void Event::setKeyState(Keyboard::KeyCode key, Keyboard::KeyState state)
+	{
+		m_Keyboard.setKeyState(key, state);
+	}
+
 	Mouse& Event::getMouse()
 	{
 		return m_Mouse;
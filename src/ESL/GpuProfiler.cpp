@@ -0,0 +1,101 @@
+﻿#include"GpuProfiler.hpp"
+
+namespace esl
+{
+	namespace
+	{
+		struct QuerySet
+		{
+			GLuint queries[GpuProfiler::MAX_ZONES] = {};
+			const char* names[GpuProfiler::MAX_ZONES] = {};
+			uint64_t cpuBegin[GpuProfiler::MAX_ZONES] = {};
+			size_t count = 0;
+		};
+
+		QuerySet g_Sets[GpuProfiler::FRAMES];
+		size_t g_Current = 0;
+		constexpr GLuint64 ELAPSED_LIMIT = 1000000000ull;	// 1 秒
+		bool g_Created = false;
+		bool g_Timing = false;
+		GpuProfiler::Stats g_Stats;
+
+		void createQueries()
+		{
+			for (auto& set : g_Sets) {
+				glGenQueries(static_cast<GLsizei>(GpuProfiler::MAX_ZONES), set.queries);
+			}
+			g_Created = true;
+		}
+	}
+
+	bool GpuProfiler::supported()
+	{
+		return glad_glBeginQuery != nullptr && glad_glGetQueryObjectui64v != nullptr;
+	}
+
+	bool GpuProfiler::beginZone(const char* name)
+	{
+		if (!Profiler::enabled() || !supported()) return false;
+		QuerySet& set = g_Sets[g_Current];
+		if (g_Timing || set.count >= MAX_ZONES) {
+			g_Stats.overflow++;
+			return false;
+		}
+		if (!g_Created) createQueries();
+		set.names[set.count] = name;
+		set.cpuBegin[set.count] = Profiler::now();
+		glBeginQuery(GL_TIME_ELAPSED, set.queries[set.count]);
+		set.count++;
+		g_Timing = true;
+		return true;
+	}
+
+	void GpuProfiler::endZone()
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		g_Timing = false;
+	}
+
+	void GpuProfiler::frame()
+	{
+		if (!g_Created) return;
+		g_Current = (g_Current + 1) % FRAMES;
+		// 这一组是 FRAMES - 1 帧之前发出的
+		QuerySet& set = g_Sets[g_Current];
+		for (size_t i = 0; i < set.count; i++) {
+			GLint available = 0;
+			glGetQueryObjectiv(set.queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available) {
+				g_Stats.dropped++;
+				continue;
+			}
+			GLuint64 elapsed = 0;
+			glGetQueryObjectui64v(set.queries[i], GL_QUERY_RESULT, &elapsed);
+			// llvmpipe 上下文中的第一个计时查询会返回从 0 开始计算的时间，
+			// 超过一秒的结果不可能是一个绘制阶段，按不可用处理
+			if (elapsed > ELAPSED_LIMIT) {
+				g_Stats.dropped++;
+				continue;
+			}
+			Profiler::recordGpu(set.names[i], set.cpuBegin[i], static_cast<uint64_t>(elapsed));
+			g_Stats.resolved++;
+		}
+		set.count = 0;
+	}
+
+	void GpuProfiler::release()
+	{
+		if (!g_Created) return;
+		for (auto& set : g_Sets) {
+			glDeleteQueries(static_cast<GLsizei>(MAX_ZONES), set.queries);
+			set.count = 0;
+		}
+		g_Created = false;
+		g_Timing = false;
+	}
+
+	const GpuProfiler::Stats& GpuProfiler::stats()
+	{
+		return g_Stats;
+	}
+}
@@ -0,0 +1,121 @@
+﻿#include"JobSystem.hpp"
+#include"Profiler.hpp"
+
+namespace esl
+{
+	// 当前线程在 m_Queues 中的下标，外部线程为 0
+	static thread_local size_t t_QueueIndex = 0;
+	static thread_local const JobSystem* t_Owner = nullptr;
+
+	JobSystem::JobSystem(unsigned workerCount)
+	{
+		if (workerCount == 0) {
+			unsigned hardware = std::thread::hardware_concurrency();
+			workerCount = hardware > 1 ? hardware - 1 : 0;
+		}
+		for (unsigned i = 0; i <= workerCount; i++) {
+			m_Queues.push_back(std::make_unique<Queue>());
+		}
+		for (unsigned i = 1; i <= workerCount; i++) {
+			m_Workers.emplace_back(&JobSystem::workerLoop, this, size_t(i));
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_SleepMutex);
+			m_Running = false;
+		}
+		m_Wake.notify_all();
+		for (auto& worker : m_Workers) {
+			worker.join();
+		}
+	}
+
+	size_t JobSystem::currentQueue() const
+	{
+		return t_Owner == this ? t_QueueIndex : 0;
+	}
+
+	void JobSystem::submit(Job job, JobCounter* counter)
+	{
+		if (counter) counter->pending.fetch_add(1, std::memory_order_relaxed);
+		if (m_Workers.empty()) {
+			// 没有工作线程，直接执行
+			job();
+			if (counter) counter->pending.fetch_sub(1, std::memory_order_release);
+			return;
+		}
+		Queue& queue = *m_Queues[currentQueue()];
+		{
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.jobs.emplace_back(std::move(job), counter);
+		}
+		{
+			// 与 workerLoop 中的检查同步，避免错过唤醒
+			std::lock_guard<std::mutex> lock(m_SleepMutex);
+			m_Queued.fetch_add(1, std::memory_order_release);
+		}
+		m_Wake.notify_one();
+	}
+
+	bool JobSystem::runOne(size_t index)
+	{
+		std::pair<Job, JobCounter*> item;
+		bool found = false;
+		{
+			Queue& own = *m_Queues[index];
+			std::lock_guard<std::mutex> lock(own.mutex);
+			if (!own.jobs.empty()) {
+				item = std::move(own.jobs.back());
+				own.jobs.pop_back();
+				found = true;
+			}
+		}
+		for (size_t i = 1; !found && i < m_Queues.size(); i++) {
+			Queue& victim = *m_Queues[(index + i) % m_Queues.size()];
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if (!victim.jobs.empty()) {
+				item = std::move(victim.jobs.front());
+				victim.jobs.pop_front();
+				found = true;
+			}
+		}
+		if (!found) return false;
+
+		m_Queued.fetch_sub(1, std::memory_order_relaxed);
+		{
+			ESL_PROFILE_ZONE("Job");
+			item.first();
+		}
+		if (item.second) item.second->pending.fetch_sub(1, std::memory_order_release);
+		return true;
+	}
+
+	void JobSystem::wait(JobCounter& counter)
+	{
+		const size_t index = currentQueue();
+		while (!counter.done()) {
+			if (!runOne(index)) {
+				// 剩下的任务正在其他线程上执行
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void JobSystem::workerLoop(size_t index)
+	{
+		t_QueueIndex = index;
+		t_Owner = this;
+		Profiler::setThreadName("Worker");
+		while (true) {
+			if (runOne(index)) continue;
+			std::unique_lock<std::mutex> lock(m_SleepMutex);
+			m_Wake.wait(lock, [this]() {
+				return !m_Running || m_Queued.load(std::memory_order_acquire) > 0;
+			});
+			if (!m_Running) return;
+		}
+	}
+}
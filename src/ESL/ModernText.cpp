@@ -25,7 +25,8 @@ namespace esl {
             "color = textColor * sampled;\n"
             "}\0"
         };
-        shader = new Shader(vertex, fragment);
+        // 所有文字共用同一个程序
+        shader = ShaderLibrary::get(vertex, fragment);
         glGenVertexArrays(1, &VAO);
         glGenBuffers(1, &VBO);
         glBindVertexArray(VAO);
@@ -84,7 +85,7 @@ namespace esl {
         this->size = size;
         if (font) {
             font->setFontSize(size);
-            // ַ
+            // 重新生成所有字符纹理
             charMap.clear();
             if (!text.empty()) {
                 updateMap();
@@ -137,7 +138,7 @@ namespace esl {
             GLfloat w = ch.Size.x * scale.x;
             GLfloat h = ch.Size.y * scale.y;
 
-            // VBO
+            // 更新VBO
             GLfloat vertices[6][4] = {
                 { xpos,     ypos + h,   0.0, 0.0 },
                 { xpos,     ypos,       0.0, 1.0 },
@@ -148,15 +149,15 @@ namespace esl {
                 { xpos + w, ypos + h,   1.0, 0.0 }
             };
 
-            // Ⱦַ
+            // 渲染字符纹理
             glBindTexture(GL_TEXTURE_2D, ch.TextureID);
             glBindBuffer(GL_ARRAY_BUFFER, VBO);
             glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
             glBindBuffer(GL_ARRAY_BUFFER, 0);
             glDrawArrays(GL_TRIANGLES, 0, 6);
 
-            // λõһַ
-            text_pos.x += (ch.Advance >> 6) * scale.x; // λƫ6λȡ1/64
+            // 更新位置到下一个字符
+            text_pos.x += (ch.Advance >> 6) * scale.x; // 位偏移6个单位来获取1/64像素
         }
         glBindVertexArray(0);
         glBindTexture(GL_TEXTURE_2D, 0);
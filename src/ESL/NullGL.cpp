@@ -0,0 +1,249 @@
+﻿#include"NullGL.hpp"
+#include"glad/glad.h"
+
+namespace esl
+{
+	static NullGL::Stats s_Stats;
+	static bool s_Loaded = false;
+	// 所有 glGen*/glCreate* 共用的名字计数器，0 保留为“无对象”
+	static GLuint s_NextName = 1;
+
+	// ---------- 无返回值、无输出的调用 ----------
+	static void APIENTRY NullBindVertexArray(GLuint) {}
+	static void APIENTRY NullBindBuffer(GLenum, GLuint) {}
+	static void APIENTRY NullVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) {}
+	static void APIENTRY NullTexParameteri(GLenum, GLenum, GLint) {}
+	static void APIENTRY NullEnableVertexAttribArray(GLuint) {}
+	static void APIENTRY NullBindTexture(GLenum, GLuint) {}
+	static void APIENTRY NullDeleteBuffers(GLsizei, const GLuint*) {}
+	static void APIENTRY NullBlendFunc(GLenum, GLenum) {}
+	static void APIENTRY NullEnable(GLenum) {}
+	static void APIENTRY NullDeleteVertexArrays(GLsizei, const GLuint*) {}
+	static void APIENTRY NullActiveTexture(GLenum) {}
+	static void APIENTRY NullViewport(GLint, GLint, GLsizei, GLsizei) {}
+	static void APIENTRY NullDeleteTextures(GLsizei, const GLuint*) {}
+	static void APIENTRY NullBindFramebuffer(GLenum, GLuint) {}
+	static void APIENTRY NullUseProgram(GLuint) {}
+	static void APIENTRY NullUniformMatrix4fv(GLint, GLsizei, GLboolean, const GLfloat*) {}
+	static void APIENTRY NullUniform3fv(GLint, GLsizei, const GLfloat*) {}
+	static void APIENTRY NullShaderSource(GLuint, GLsizei, const GLchar* const*, const GLint*) {}
+	static void APIENTRY NullLineWidth(GLfloat) {}
+	static void APIENTRY NullDisable(GLenum) {}
+	static void APIENTRY NullDeleteShader(GLuint) {}
+	static void APIENTRY NullDeleteFramebuffers(GLsizei, const GLuint*) {}
+	static void APIENTRY NullCompileShader(GLuint) {}
+	static void APIENTRY NullBlendFuncSeparate(GLenum, GLenum, GLenum, GLenum) {}
+	static void APIENTRY NullAttachShader(GLuint, GLuint) {}
+	static void APIENTRY NullVertexAttribDivisor(GLuint, GLuint) {}
+	static void APIENTRY NullUniform4fv(GLint, GLsizei, const GLfloat*) {}
+	static void APIENTRY NullUniform2fv(GLint, GLsizei, const GLfloat*) {}
+	static void APIENTRY NullUniform1i(GLint, GLint) {}
+	static void APIENTRY NullUniform1f(GLint, GLfloat) {}
+	static void APIENTRY NullReadBuffer(GLenum) {}
+	static void APIENTRY NullPixelStorei(GLenum, GLint) {}
+	static void APIENTRY NullLinkProgram(GLuint) {}
+	static void APIENTRY NullGenerateMipmap(GLenum) {}
+	static void APIENTRY NullFramebufferTexture2D(GLenum, GLenum, GLenum, GLuint, GLint) {}
+	static void APIENTRY NullDeleteProgram(GLuint) {}
+	static void APIENTRY NullCopyTexSubImage2D(GLenum, GLint, GLint, GLint, GLint, GLint, GLsizei, GLsizei) {}
+	static void APIENTRY NullClearColor(GLfloat, GLfloat, GLfloat, GLfloat) {}
+	static void APIENTRY NullClear(GLbitfield) {}
+	static void APIENTRY NullFinish() {}
+	static void APIENTRY NullFlush() {}
+	static void APIENTRY NullDeleteQueries(GLsizei, const GLuint*) {}
+	static void APIENTRY NullBeginQuery(GLenum, GLuint) {}
+	static void APIENTRY NullEndQuery(GLenum) {}
+
+	// ---------- 创建对象 ----------
+	static void generate(GLsizei n, GLuint* names)
+	{
+		for (GLsizei i = 0; i < n; i++) names[i] = s_NextName++;
+	}
+	static void APIENTRY NullGenBuffers(GLsizei n, GLuint* buffers) { generate(n, buffers); }
+	static void APIENTRY NullGenVertexArrays(GLsizei n, GLuint* arrays) { generate(n, arrays); }
+	static void APIENTRY NullGenTextures(GLsizei n, GLuint* textures) { generate(n, textures); }
+	static void APIENTRY NullGenFramebuffers(GLsizei n, GLuint* framebuffers) { generate(n, framebuffers); }
+	static void APIENTRY NullGenQueries(GLsizei n, GLuint* ids) { generate(n, ids); }
+	static GLuint APIENTRY NullCreateShader(GLenum) { return s_NextName++; }
+	static GLuint APIENTRY NullCreateProgram() { return s_NextName++; }
+
+	// ---------- 上传与绘制：只计数 ----------
+	static void APIENTRY NullBufferData(GLenum, GLsizeiptr size, const void* data, GLenum)
+	{
+		if (data) s_Stats.uploadBytes += static_cast<uint64_t>(size);
+	}
+	static void APIENTRY NullBufferSubData(GLenum, GLintptr, GLsizeiptr size, const void*)
+	{
+		s_Stats.uploadBytes += static_cast<uint64_t>(size);
+	}
+	static void APIENTRY NullTexImage2D(GLenum, GLint, GLint, GLsizei width, GLsizei height, GLint, GLenum, GLenum, const void* pixels)
+	{
+		// 按 RGBA8 估算
+		if (pixels) s_Stats.uploadBytes += static_cast<uint64_t>(width) * height * 4;
+	}
+	static void APIENTRY NullTexSubImage2D(GLenum, GLint, GLint, GLint, GLsizei width, GLsizei height, GLenum, GLenum, const void*)
+	{
+		s_Stats.uploadBytes += static_cast<uint64_t>(width) * height * 4;
+	}
+	static void APIENTRY NullDrawElements(GLenum, GLsizei, GLenum, const void*)
+	{
+		s_Stats.drawCalls++;
+		s_Stats.instances++;
+	}
+	static void APIENTRY NullDrawArrays(GLenum, GLint, GLsizei)
+	{
+		s_Stats.drawCalls++;
+		s_Stats.instances++;
+	}
+	static void APIENTRY NullDrawElementsInstancedBaseInstance(GLenum, GLsizei, GLenum, const void*, GLsizei instancecount, GLuint)
+	{
+		s_Stats.drawCalls++;
+		s_Stats.instances += static_cast<uint64_t>(instancecount);
+	}
+
+	// ---------- 查询：编译链接总是成功，没有活动的 uniform ----------
+	static void APIENTRY NullGetShaderiv(GLuint, GLenum pname, GLint* params)
+	{
+		*params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+	}
+	static void APIENTRY NullGetProgramiv(GLuint, GLenum pname, GLint* params)
+	{
+		*params = pname == GL_LINK_STATUS ? GL_TRUE : 0;
+	}
+	static void APIENTRY NullGetInfoLog(GLuint, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+	{
+		if (length) *length = 0;
+		if (infoLog && bufSize > 0) infoLog[0] = '\0';
+	}
+	static void APIENTRY NullGetActiveUniform(GLuint, GLuint, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+	{
+		if (length) *length = 0;
+		if (size) *size = 0;
+		if (type) *type = 0;
+		if (name && bufSize > 0) name[0] = '\0';
+	}
+	static GLint APIENTRY NullGetUniformLocation(GLuint, const GLchar*) { return -1; }
+	static void APIENTRY NullGetIntegerv(GLenum pname, GLint* data)
+	{
+		// 目前只有 GL_VIEWPORT 会被查询，它需要 4 个值
+		const int count = pname == GL_VIEWPORT ? 4 : 1;
+		for (int i = 0; i < count; i++) data[i] = 0;
+	}
+	static GLboolean APIENTRY NullIsEnabled(GLenum) { return GL_FALSE; }
+	static GLenum APIENTRY NullCheckFramebufferStatus(GLenum) { return GL_FRAMEBUFFER_COMPLETE; }
+	static const GLubyte* APIENTRY NullGetString(GLenum name)
+	{
+		static const char* version = "4.6 ESL Null";
+		static const char* other = "ESL Null";
+		return reinterpret_cast<const GLubyte*>(name == GL_VERSION ? version : other);
+	}
+	static GLenum APIENTRY NullGetError() { return GL_NO_ERROR; }
+	// 计时查询总是立即可用，耗时为 0
+	static void APIENTRY NullGetQueryObjectiv(GLuint, GLenum pname, GLint* params)
+	{
+		*params = pname == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+	}
+	static void APIENTRY NullGetQueryObjectui64v(GLuint, GLenum, GLuint64* params) { *params = 0; }
+	// 不支持程序二进制：GL_NUM_PROGRAM_BINARY_FORMATS 为 0，二进制长度为 0
+	static void APIENTRY NullProgramParameteri(GLuint, GLenum, GLint) {}
+	static void APIENTRY NullGetProgramBinary(GLuint, GLsizei, GLsizei* length, GLenum* binaryFormat, void*)
+	{
+		if (length) *length = 0;
+		if (binaryFormat) *binaryFormat = 0;
+	}
+	static void APIENTRY NullProgramBinary(GLuint, GLenum, const void*, GLsizei) {}
+
+	void NullGL::load()
+	{
+		glad_glBindVertexArray = NullBindVertexArray;
+		glad_glBindBuffer = NullBindBuffer;
+		glad_glVertexAttribPointer = NullVertexAttribPointer;
+		glad_glTexParameteri = NullTexParameteri;
+		glad_glEnableVertexAttribArray = NullEnableVertexAttribArray;
+		glad_glBindTexture = NullBindTexture;
+		glad_glDeleteBuffers = NullDeleteBuffers;
+		glad_glBlendFunc = NullBlendFunc;
+		glad_glEnable = NullEnable;
+		glad_glDeleteVertexArrays = NullDeleteVertexArrays;
+		glad_glActiveTexture = NullActiveTexture;
+		glad_glViewport = NullViewport;
+		glad_glDeleteTextures = NullDeleteTextures;
+		glad_glBindFramebuffer = NullBindFramebuffer;
+		glad_glUseProgram = NullUseProgram;
+		glad_glUniformMatrix4fv = NullUniformMatrix4fv;
+		glad_glUniform3fv = NullUniform3fv;
+		glad_glShaderSource = NullShaderSource;
+		glad_glLineWidth = NullLineWidth;
+		glad_glDisable = NullDisable;
+		glad_glDeleteShader = NullDeleteShader;
+		glad_glDeleteFramebuffers = NullDeleteFramebuffers;
+		glad_glCompileShader = NullCompileShader;
+		glad_glBlendFuncSeparate = NullBlendFuncSeparate;
+		glad_glAttachShader = NullAttachShader;
+		glad_glVertexAttribDivisor = NullVertexAttribDivisor;
+		glad_glUniform4fv = NullUniform4fv;
+		glad_glUniform2fv = NullUniform2fv;
+		glad_glUniform1i = NullUniform1i;
+		glad_glUniform1f = NullUniform1f;
+		glad_glReadBuffer = NullReadBuffer;
+		glad_glPixelStorei = NullPixelStorei;
+		glad_glLinkProgram = NullLinkProgram;
+		glad_glGenerateMipmap = NullGenerateMipmap;
+		glad_glFramebufferTexture2D = NullFramebufferTexture2D;
+		glad_glDeleteProgram = NullDeleteProgram;
+		glad_glCopyTexSubImage2D = NullCopyTexSubImage2D;
+		glad_glClearColor = NullClearColor;
+		glad_glClear = NullClear;
+		glad_glFinish = NullFinish;
+		glad_glFlush = NullFlush;
+		glad_glGenBuffers = NullGenBuffers;
+		glad_glGenVertexArrays = NullGenVertexArrays;
+		glad_glGenTextures = NullGenTextures;
+		glad_glGenFramebuffers = NullGenFramebuffers;
+		glad_glGenQueries = NullGenQueries;
+		glad_glDeleteQueries = NullDeleteQueries;
+		glad_glBeginQuery = NullBeginQuery;
+		glad_glEndQuery = NullEndQuery;
+		glad_glGetQueryObjectiv = NullGetQueryObjectiv;
+		glad_glGetQueryObjectui64v = NullGetQueryObjectui64v;
+		glad_glCreateShader = NullCreateShader;
+		glad_glCreateProgram = NullCreateProgram;
+		glad_glBufferData = NullBufferData;
+		glad_glBufferSubData = NullBufferSubData;
+		glad_glTexImage2D = NullTexImage2D;
+		glad_glTexSubImage2D = NullTexSubImage2D;
+		glad_glDrawElements = NullDrawElements;
+		glad_glDrawArrays = NullDrawArrays;
+		glad_glDrawElementsInstancedBaseInstance = NullDrawElementsInstancedBaseInstance;
+		glad_glGetShaderiv = NullGetShaderiv;
+		glad_glGetProgramiv = NullGetProgramiv;
+		glad_glGetShaderInfoLog = NullGetInfoLog;
+		glad_glGetProgramInfoLog = NullGetInfoLog;
+		glad_glGetActiveUniform = NullGetActiveUniform;
+		glad_glGetUniformLocation = NullGetUniformLocation;
+		glad_glGetIntegerv = NullGetIntegerv;
+		glad_glIsEnabled = NullIsEnabled;
+		glad_glCheckFramebufferStatus = NullCheckFramebufferStatus;
+		glad_glGetString = NullGetString;
+		glad_glProgramParameteri = NullProgramParameteri;
+		glad_glGetProgramBinary = NullGetProgramBinary;
+		glad_glProgramBinary = NullProgramBinary;
+		glad_glGetError = NullGetError;
+		s_Loaded = true;
+	}
+
+	bool NullGL::loaded()
+	{
+		return s_Loaded;
+	}
+
+	const NullGL::Stats& NullGL::stats()
+	{
+		return s_Stats;
+	}
+
+	void NullGL::resetStats()
+	{
+		s_Stats = Stats();
+	}
+}
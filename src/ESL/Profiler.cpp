@@ -0,0 +1,287 @@
+﻿#include"Profiler.hpp"
+#include"AllocTracker.hpp"
+#include<algorithm>
+#include<chrono>
+#include<cstdio>
+#include<cstring>
+#include<memory>
+#include<mutex>
+
+namespace esl
+{
+	std::atomic<bool> Profiler::s_Enabled{ false };
+
+	namespace
+	{
+		// 一个线程的区段环形缓冲区：所属线程写入后推进 head，
+		// 读取方按 head 读出最近 RING_SIZE 个区段。读取时若写入方恰好绕回覆盖，
+		// 最旧的几个区段可能不完整，这对统计和查看没有影响
+		struct ThreadRing
+		{
+			std::atomic<uint64_t> head{ 0 };
+			Profiler::Zone zones[Profiler::RING_SIZE];
+			uint32_t id = 0;
+			char name[32] = {};
+			std::atomic<bool> inUse{ true };
+			uint64_t cursor = 0;	// frame() 已汇总到的位置
+		};
+
+		struct ZoneHistory
+		{
+			const char* name;
+			uint32_t depth;
+			uint64_t firstBegin;	// 首次出现时的开始时间，用于按调用顺序排列
+			double current;			// 本帧累计耗时（毫秒）
+			float ms[Profiler::HISTORY];
+		};
+
+		const auto g_Epoch = std::chrono::steady_clock::now();
+		// 线程退出后其缓冲区留给之后新建的线程复用，数量不超过同时存在过的线程数
+		std::mutex g_RingMutex;
+		std::vector<std::unique_ptr<ThreadRing>> g_Rings;
+		// 以下只由主线程访问
+		std::vector<ZoneHistory> g_History;
+		uint64_t g_Frames = 0;
+		uint64_t g_FrameBegin = 0;
+
+		thread_local uint32_t t_Depth = 0;
+		thread_local const char* t_Zone = nullptr;
+
+		struct RingHolder
+		{
+			ThreadRing* ring = nullptr;
+			~RingHolder() {
+				if (ring) ring->inUse.store(false, std::memory_order_release);
+			}
+		};
+		thread_local RingHolder t_Ring;
+
+		ThreadRing& currentRing()
+		{
+			if (!t_Ring.ring) {
+				std::lock_guard<std::mutex> lock(g_RingMutex);
+				for (auto& ring : g_Rings) {
+					if (!ring->inUse.load(std::memory_order_acquire)) {
+						ring->inUse.store(true, std::memory_order_relaxed);
+						ring->name[0] = '\0';
+						t_Ring.ring = ring.get();
+						break;
+					}
+				}
+				if (!t_Ring.ring) {
+					g_Rings.push_back(std::make_unique<ThreadRing>());
+					g_Rings.back()->id = static_cast<uint32_t>(g_Rings.size());
+					t_Ring.ring = g_Rings.back().get();
+				}
+			}
+			return *t_Ring.ring;
+		}
+
+		// GPU 区段的轨道，只由主线程写入，不会被其他线程复用
+		ThreadRing& gpuRing()
+		{
+			static ThreadRing* ring = nullptr;
+			if (!ring) {
+				std::lock_guard<std::mutex> lock(g_RingMutex);
+				g_Rings.push_back(std::make_unique<ThreadRing>());
+				ring = g_Rings.back().get();
+				ring->id = static_cast<uint32_t>(g_Rings.size());
+				std::strcpy(ring->name, "GPU");
+			}
+			return *ring;
+		}
+
+		void push(ThreadRing& ring, const Profiler::Zone& zone)
+		{
+			const uint64_t head = ring.head.load(std::memory_order_relaxed);
+			ring.zones[head & (Profiler::RING_SIZE - 1)] = zone;
+			ring.head.store(head + 1, std::memory_order_release);
+		}
+
+		ZoneHistory& historyOf(const Profiler::Zone& zone)
+		{
+			for (auto& history : g_History) {
+				if (history.name == zone.name || std::strcmp(history.name, zone.name) == 0) return history;
+			}
+			g_History.push_back(ZoneHistory{ zone.name, zone.depth, zone.begin, 0.0, {} });
+			return g_History.back();
+		}
+
+		uint64_t firstRetained(uint64_t head)
+		{
+			return head > Profiler::RING_SIZE ? head - Profiler::RING_SIZE : 0;
+		}
+
+		void writeEscaped(std::FILE* file, const char* text)
+		{
+			for (; *text; ++text) {
+				if (*text == '"' || *text == '\\') std::fputc('\\', file);
+				std::fputc(*text, file);
+			}
+		}
+	}
+
+	void Profiler::setEnabled(bool enabled)
+	{
+		s_Enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	uint64_t Profiler::now()
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - g_Epoch).count());
+	}
+
+	void Profiler::setThreadName(const char* name)
+	{
+		ThreadRing& ring = currentRing();
+		std::strncpy(ring.name, name, sizeof(ring.name) - 1);
+		ring.name[sizeof(ring.name) - 1] = '\0';
+	}
+
+	const char* Profiler::currentZone()
+	{
+		return t_Zone;
+	}
+
+	void Profiler::record(const char* name, uint64_t begin, uint64_t end, uint32_t depth)
+	{
+		push(currentRing(), Zone{ name, begin, end, depth });
+	}
+
+	void Profiler::recordGpu(const char* name, uint64_t cpuBegin, uint64_t gpuNanoseconds)
+	{
+		push(gpuRing(), Zone{ name, cpuBegin, cpuBegin + gpuNanoseconds, 1 });
+	}
+
+	void Profiler::frame()
+	{
+		AllocTracker::frame();
+		if (!enabled()) {
+			g_FrameBegin = 0;
+			return;
+		}
+		const uint64_t time = now();
+		if (g_FrameBegin != 0) {
+			record("Frame", g_FrameBegin, time, 0);
+		}
+		g_FrameBegin = time;
+
+		for (auto& history : g_History) {
+			history.current = 0.0;
+		}
+		{
+			std::lock_guard<std::mutex> lock(g_RingMutex);
+			for (auto& ring : g_Rings) {
+				const uint64_t head = ring->head.load(std::memory_order_acquire);
+				for (uint64_t i = std::max(ring->cursor, firstRetained(head)); i < head; i++) {
+					const Zone& zone = ring->zones[i & (RING_SIZE - 1)];
+					historyOf(zone).current += static_cast<double>(zone.end - zone.begin) * 1e-6;
+				}
+				ring->cursor = head;
+			}
+		}
+		const size_t slot = static_cast<size_t>(g_Frames % HISTORY);
+		for (auto& history : g_History) {
+			history.ms[slot] = static_cast<float>(history.current);
+		}
+		g_Frames++;
+	}
+
+	std::vector<Profiler::ZoneStats> Profiler::stats()
+	{
+		std::vector<ZoneStats> result;
+		const size_t frames = static_cast<size_t>(std::min<uint64_t>(g_Frames, HISTORY));
+		if (frames == 0) return result;
+
+		std::vector<float> samples(frames);
+		auto percentile = [&samples, frames](double p) {
+			size_t index = static_cast<size_t>(p * static_cast<double>(frames - 1) + 0.5);
+			return static_cast<double>(samples[std::min(index, frames - 1)]);
+		};
+		// 整帧区段排在最前；其余父区段先于子区段开始，按首次开始时间排列即为调用层次的顺序
+		std::vector<const ZoneHistory*> order;
+		for (const auto& history : g_History) order.push_back(&history);
+		std::sort(order.begin(), order.end(), [](const ZoneHistory* a, const ZoneHistory* b) {
+			if ((a->depth == 0) != (b->depth == 0)) return a->depth == 0;
+			return a->firstBegin < b->firstBegin;
+		});
+		for (const ZoneHistory* entry : order) {
+			const ZoneHistory& history = *entry;
+			std::copy(history.ms, history.ms + frames, samples.begin());
+			std::sort(samples.begin(), samples.end());
+			ZoneStats stats;
+			stats.name = history.name;
+			stats.depth = history.depth;
+			double sum = 0.0;
+			for (float ms : samples) sum += ms;
+			stats.average = sum / static_cast<double>(frames);
+			stats.p50 = percentile(0.50);
+			stats.p95 = percentile(0.95);
+			stats.p99 = percentile(0.99);
+			stats.max = samples.back();
+			result.push_back(stats);
+		}
+		return result;
+	}
+
+	void Profiler::resetStats()
+	{
+		g_History.clear();
+		g_Frames = 0;
+	}
+
+	bool Profiler::writeChromeTrace(const std::string& path)
+	{
+		std::FILE* file = std::fopen(path.c_str(), "w");
+		if (!file) {
+			std::fprintf(stderr, "[Profiler] cannot write %s\n", path.c_str());
+			return false;
+		}
+		std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+		bool first = true;
+		std::lock_guard<std::mutex> lock(g_RingMutex);
+		for (auto& ring : g_Rings) {
+			if (ring->name[0] != '\0') {
+				std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+					first ? "" : ",\n", ring->id);
+				writeEscaped(file, ring->name);
+				std::fputs("\"}}", file);
+				first = false;
+			}
+			const uint64_t head = ring->head.load(std::memory_order_acquire);
+			for (uint64_t i = firstRetained(head); i < head; i++) {
+				const Zone& zone = ring->zones[i & (RING_SIZE - 1)];
+				std::fprintf(file, "%s{\"name\":\"", first ? "" : ",\n");
+				writeEscaped(file, zone.name);
+				std::fprintf(file, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+					ring->id, static_cast<double>(zone.begin) * 1e-3, static_cast<double>(zone.end - zone.begin) * 1e-3);
+				first = false;
+			}
+		}
+		std::fputs("\n]}\n", file);
+		std::fclose(file);
+		return true;
+	}
+
+	ProfileZone::ProfileZone(const char* name)
+		: m_Name(name), m_Active(Profiler::enabled())
+	{
+		if (m_Active) {
+			m_Depth = ++t_Depth;
+			m_Parent = t_Zone;
+			t_Zone = m_Name;
+			m_Begin = Profiler::now();
+		}
+	}
+
+	ProfileZone::~ProfileZone()
+	{
+		if (m_Active) {
+			const uint64_t end = Profiler::now();
+			--t_Depth;
+			t_Zone = m_Parent;
+			Profiler::record(m_Name, m_Begin, end, m_Depth);
+		}
+	}
+}
@@ -0,0 +1,86 @@
+﻿#include"ProfilerOverlay.hpp"
+#include"Profiler.hpp"
+#include"AllocTracker.hpp"
+#include"ResourceCache.hpp"
+#include"ShaderLibrary.hpp"
+#include<cstdio>
+
+namespace esl
+{
+	ProfilerOverlay::ProfilerOverlay(const std::string& fontPath)
+		: m_FontPath(fontPath)
+	{
+	}
+
+	void ProfilerOverlay::setVisible(bool visible)
+	{
+		m_Visible = visible;
+		// 显示时自动开启分析器
+		if (visible) Profiler::setEnabled(true);
+	}
+
+	void ProfilerOverlay::draw(float right, float top)
+	{
+		if (!m_Visible) return;
+		if (!m_Text) {
+			m_Font = std::make_unique<Font>();
+			m_Font->loadFromFile(m_FontPath);
+			m_Text = std::make_unique<SText>();
+			m_Text->setFont(*m_Font);
+			m_Text->setSize(m_FontSize);
+		}
+
+		// 同一个文本对象逐行设置内容后立即绘制，字形纹理在各行之间共用
+		const float lineHeight = static_cast<float>(m_FontSize) + 2.0f;
+		glm::vec2 pos = { 8.0f, top - lineHeight };
+		char line[128];
+		std::snprintf(line, sizeof(line), "%-24s %7s %7s %7s %7s", "zone (ms)", "avg", "p50", "p95", "p99");
+		m_Text->setColor(glm::vec4(1.0f, 1.0f, 0.4f, 1.0f));
+		m_Text->setText(line);
+		m_Text->setPosition(pos);
+		m_Text->draw(right, top);
+
+		m_Text->setColor(glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+		for (const auto& zone : Profiler::stats()) {
+			pos.y -= lineHeight;
+			std::string name(zone.depth * 2, ' ');
+			name += zone.name;
+			std::snprintf(line, sizeof(line), "%-24s %7.3f %7.3f %7.3f %7.3f",
+				name.c_str(), zone.average, zone.p50, zone.p95, zone.p99);
+			m_Text->setText(line);
+			m_Text->setPosition(pos);
+			m_Text->draw(right, top);
+		}
+
+		pos.y -= lineHeight * 1.5f;
+		m_Text->setText(TextureCache::summary());
+		m_Text->setPosition(pos);
+		m_Text->draw(right, top);
+		pos.y -= lineHeight;
+		m_Text->setText(ShaderLibrary::summary());
+		m_Text->setPosition(pos);
+		m_Text->draw(right, top);
+
+		// 开启分配跟踪时，列出上一帧分配最多的几个区段
+		if (!AllocTracker::enabled()) return;
+		const AllocTracker::Counter frame = AllocTracker::lastFrame();
+		pos.y -= lineHeight * 1.5f;
+		std::snprintf(line, sizeof(line), "%-24s %7llu %7.1f KB", "allocations",
+			static_cast<unsigned long long>(frame.allocations), static_cast<double>(frame.bytes) / 1024.0);
+		m_Text->setColor(glm::vec4(1.0f, 1.0f, 0.4f, 1.0f));
+		m_Text->setText(line);
+		m_Text->setPosition(pos);
+		m_Text->draw(right, top);
+
+		m_Text->setColor(glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+		const auto zones = AllocTracker::lastFrameZones();
+		for (size_t i = 0; i < zones.size() && i < ALLOC_ZONE_LINES; i++) {
+			pos.y -= lineHeight;
+			std::snprintf(line, sizeof(line), "  %-22s %7llu %7.1f KB", zones[i].name,
+				static_cast<unsigned long long>(zones[i].counter.allocations), static_cast<double>(zones[i].counter.bytes) / 1024.0);
+			m_Text->setText(line);
+			m_Text->setPosition(pos);
+			m_Text->draw(right, top);
+		}
+	}
+}
@@ -1,6 +1,7 @@
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
 #include "ProgressSprite.hpp"
+#include "ShaderLibrary.hpp"
 
 namespace esl
 {
@@ -16,11 +17,6 @@ namespace esl
 
     ProgressSprite::~ProgressSprite()
     {
-        if (m_ProgressShader)
-        {
-            delete m_ProgressShader;
-            m_ProgressShader = nullptr;
-        }
     }
 
     void ProgressSprite::setType(Type type)
@@ -64,9 +60,10 @@ namespace esl
             uniform mat4 projection;
             uniform mat4 view;
             uniform vec2 uvScale;
+            uniform vec4 uvRect;
             void main() {
                 gl_Position = projection * view * transform * vec4(aPos, 1.0);
-                uv = aUV * uvScale;
+                uv = mix(uvRect.xy, uvRect.zw, aUV) * uvScale;
             }
         )";
 
@@ -84,24 +81,24 @@ namespace esl
                 vec4 texColor = texture(sampler, uv) * spriteColor;
                 
                 if (progressType == 0) { // RADIAL
-                    // UVתΪԲ
+                    // 将UV坐标转换为圆形坐标
                     vec2 center = vec2(0.5, 0.5);
                     vec2 coord = uv - center;
                     float angle = atan(coord.y, coord.x);
                     
-                    // Ƕȴ [-PI, PI] ӳ䵽 [0, 1]
+                    // 将角度从 [-PI, PI] 映射到 [0, 1]
                     float normalizedAngle = (angle + 3.14159265359) / (2.0 * 3.14159265359);
                     
                     if (reverseDirection) {
                         normalizedAngle = 1.0 - normalizedAngle;
                     }
                     
-                    // 鵱ǰǶǷڽȷΧ
+                    // 检查当前角度是否在进度范围内
                     if (normalizedAngle > percentage) {
                         discard;
                     }
                     
-                    // ǷԲ
+                    // 检查是否在圆形区域内
                     float radius = length(coord);
                     if (radius > 0.5) {
                         discard;
@@ -129,13 +126,21 @@ namespace esl
             }
         )";
 
-        m_ProgressShader = new Shader(vertexShader, fragmentShader);
-        m_ProgressShader->setInt("sampler", 0);
+        m_ProgressShader = ShaderLibrary::get(vertexShader, fragmentShader);
+        m_ProgressUniforms.projection = m_ProgressShader->getUniform("projection");
+        m_ProgressUniforms.view = m_ProgressShader->getUniform("view");
+        m_ProgressUniforms.transform = m_ProgressShader->getUniform("transform");
+        m_ProgressUniforms.spriteColor = m_ProgressShader->getUniform("spriteColor");
+        m_ProgressUniforms.uvScale = m_ProgressShader->getUniform("uvScale");
+        m_ProgressUniforms.uvRect = m_ProgressShader->getUniform("uvRect");
+        m_PercentageUniform = m_ProgressShader->getUniform("percentage");
+        m_TypeUniform = m_ProgressShader->getUniform("progressType");
+        m_ReverseUniform = m_ProgressShader->getUniform("reverseDirection");
     }
 
     void ProgressSprite::draw(float right, float top)
     {
-        // ȻƱ߿У
+        // 先绘制边框（如果有）
         drawBorder(right, top);
 
         m_ProgressShader->load();
@@ -145,8 +150,8 @@ namespace esl
         glm::mat4 view(1.f);
         projection = glm::ortho(0.0f, right, 0.0f, top, -1.0f, 1.0f);
 
-        m_ProgressShader->setMat4("projection", projection);
-        m_ProgressShader->setMat4("view", view);
+        m_ProgressShader->set(m_ProgressUniforms.projection, projection);
+        m_ProgressShader->set(m_ProgressUniforms.view, view);
 
         glm::mat4 transform = glm::mat4(1.0f);
         transform = glm::translate(transform, m_Position);
@@ -157,14 +162,15 @@ namespace esl
         glm::vec2 scaledSize = m_Size * m_Scale * m_RectScale * m_RepeatScale;
         transform = glm::scale(transform, glm::vec3(scaledSize.x, scaledSize.y, 1.0f));
 
-        m_ProgressShader->setMat4("transform", transform);
-        m_ProgressShader->setVec4("spriteColor", m_Color);
-        m_ProgressShader->setVec2("uvScale", m_RepeatScale);
+        m_ProgressShader->set(m_ProgressUniforms.transform, transform);
+        m_ProgressShader->set(m_ProgressUniforms.spriteColor, m_Color);
+        m_ProgressShader->set(m_ProgressUniforms.uvScale, m_RepeatScale);
+        m_ProgressShader->set(m_ProgressUniforms.uvRect, m_TexRect);
 
-        // ýز
-        m_ProgressShader->setFloat("percentage", m_Percentage);
-        m_ProgressShader->setInt("progressType", static_cast<int>(m_Type));
-        m_ProgressShader->setBool("reverseDirection", m_ReverseDirection);
+        // 设置进度条相关参数
+        m_ProgressShader->set(m_PercentageUniform, m_Percentage);
+        m_ProgressShader->set(m_TypeUniform, static_cast<int>(m_Type));
+        m_ProgressShader->set(m_ReverseUniform, m_ReverseDirection);
 
         glBindVertexArray(m_VAO);
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
@@ -0,0 +1,39 @@
+﻿#include"ResourceCache.hpp"
+#include"AssetPack.hpp"
+#include<cstdio>
+
+namespace esl
+{
+	ResourceCache<Texture>& TextureCache::cache()
+	{
+		static ResourceCache<Texture> s_Cache([](const Texture& texture) {
+			return static_cast<size_t>(texture.getSize().w) * texture.getSize().h * 4;
+		}, DEFAULT_BUDGET);
+		return s_Cache;
+	}
+
+	std::shared_ptr<Texture> TextureCache::get(const std::string& path, Texture::Wrap wrap, Texture::Filter filter)
+	{
+		std::string key = AssetPack::normalize(path);
+		key += '#';
+		key += static_cast<char>('0' + static_cast<int>(wrap));
+		key += static_cast<char>('0' + static_cast<int>(filter));
+		return cache().acquire(key, [&]() { return std::make_unique<Texture>(path, wrap, filter); });
+	}
+
+	void TextureCache::purge()
+	{
+		cache().purge();
+	}
+
+	std::string TextureCache::summary()
+	{
+		const auto& stats = cache().stats();
+		char line[160];
+		std::snprintf(line, sizeof(line), "textures: %zu live, %zu cached (%.1f MiB), %llu hits, %llu reused, %llu loads",
+			stats.live, stats.released, stats.releasedBytes / (1024.0 * 1024.0),
+			static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.revivals),
+			static_cast<unsigned long long>(stats.misses));
+		return line;
+	}
+}
@@ -1,6 +1,8 @@
 #include"glad/glad.h"
 #include"GLFW/glfw3.h"
 #include"Shader.hpp"
+#include<algorithm>
+#include<cstring>
 
 namespace esl
 {
@@ -25,12 +27,17 @@ namespace esl
         catch (std::ifstream::failure e) {
             std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << std::endl;
         }
-        const char* vShaderCode = vertexCode.c_str();
-        const char* fShaderCode = fragmentCode.c_str();
+        link(vertexCode.c_str(), fragmentCode.c_str());
+    }
+    Shader::Shader(const std::string& vertexCode, const std::string& fragmentCode) {
+        link(vertexCode.c_str(), fragmentCode.c_str());
+    }
+    void Shader::link(const char* vShaderCode, const char* fShaderCode)
+    {
         unsigned int vertex, fragment;
         int success;
         char infoLog[512];
-        // ɫ
+        // 顶点着色器编译检查
         vertex = glCreateShader(GL_VERTEX_SHADER);
         glShaderSource(vertex, 1, &vShaderCode, NULL);
         glCompileShader(vertex);
@@ -40,7 +47,7 @@ namespace esl
             std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
         }
 
-        // Ƭɫ
+        // 片段着色器编译检查
         fragment = glCreateShader(GL_FRAGMENT_SHADER);
         glShaderSource(fragment, 1, &fShaderCode, NULL);
         glCompileShader(fragment);
@@ -53,6 +60,8 @@ namespace esl
         m_Program = glCreateProgram();
         glAttachShader(m_Program, vertex);
         glAttachShader(m_Program, fragment);
+        // 允许之后用 glGetProgramBinary 取出二进制，供 ShaderLibrary 缓存到磁盘
+        glProgramParameteri(m_Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
         glLinkProgram(m_Program);
         glGetProgramiv(m_Program, GL_LINK_STATUS, &success);
         if (!success) {
@@ -61,44 +70,91 @@ namespace esl
         }
         glDeleteShader(vertex);
         glDeleteShader(fragment);
+        if (success) {
+            m_Linked = true;
+            introspect();
+        }
     }
-    Shader::Shader(const std::string& vertexCode, const std::string& fragmentCode) {
-        const char* vShaderCode = vertexCode.c_str();
-        const char* fShaderCode = fragmentCode.c_str();
-        unsigned int vertex, fragment;
-        int success;
-        char infoLog[512];
-        // ɫ
-        vertex = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(vertex, 1, &vShaderCode, NULL);
-        glCompileShader(vertex);
-        glGetShaderiv(vertex, GL_COMPILE_STATUS, &success);
+    std::shared_ptr<Shader> Shader::fromBinary(uint format, const void* data, int length)
+    {
+        std::shared_ptr<Shader> shader(new Shader());
+        shader->m_Program = glCreateProgram();
+        glProgramBinary(shader->m_Program, format, data, length);
+        int success = 0;
+        glGetProgramiv(shader->m_Program, GL_LINK_STATUS, &success);
         if (!success) {
-            glGetShaderInfoLog(vertex, 512, NULL, infoLog);
-            std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
+            // 驱动更新或二进制损坏，由调用者重新编译
+            return nullptr;
         }
-
-        // Ƭɫ
-        fragment = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragment, 1, &fShaderCode, NULL);
-        glCompileShader(fragment);
-        glGetShaderiv(fragment, GL_COMPILE_STATUS, &success);
-        if (!success) {
-            glGetShaderInfoLog(fragment, 512, NULL, infoLog);
-            std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
+        shader->m_Linked = true;
+        shader->introspect();
+        return shader;
+    }
+    bool Shader::getBinary(uint& format, std::vector<char>& data) const
+    {
+        if (!m_Linked) return false;
+        GLint length = 0;
+        glGetProgramiv(m_Program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) return false;
+        data.resize(static_cast<size_t>(length));
+        GLsizei written = 0;
+        GLenum binaryFormat = 0;
+        glGetProgramBinary(m_Program, length, &written, &binaryFormat, data.data());
+        if (written <= 0) return false;
+        data.resize(static_cast<size_t>(written));
+        format = binaryFormat;
+        return true;
+    }
+    void Shader::introspect()
+    {
+        GLint count = 0;
+        GLint maxLength = 0;
+        glGetProgramiv(m_Program, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(m_Program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+        std::vector<char> buffer(maxLength > 0 ? maxLength : 1);
+        int maxLocation = -1;
+        for (GLint i = 0; i < count; i++) {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(m_Program, static_cast<GLuint>(i), static_cast<GLsizei>(buffer.size()), &length, &size, &type, buffer.data());
+            std::string name(buffer.data(), length);
+            int loc = glGetUniformLocation(m_Program, name.c_str());
+            if (loc < 0) continue; // uniform block 中的成员没有独立位置
+            m_Locations[name] = loc;
+            // 数组以 "name[0]" 形式返回，同时登记不带下标的名字
+            size_t bracket = name.find('[');
+            if (bracket != std::string::npos) {
+                m_Locations[name.substr(0, bracket)] = loc;
+            }
+            maxLocation = std::max(maxLocation, loc + size - 1);
         }
-
-        m_Program = glCreateProgram();
-        glAttachShader(m_Program, vertex);
-        glAttachShader(m_Program, fragment);
-        glLinkProgram(m_Program);
-        glGetProgramiv(m_Program, GL_LINK_STATUS, &success);
-        if (!success) {
-            glGetProgramInfoLog(m_Program, 512, NULL, infoLog);
-            std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+        m_Shadow.resize(static_cast<size_t>(maxLocation + 1));
+    }
+    int Shader::location(const std::string& name) const
+    {
+        auto it = m_Locations.find(name);
+        if (it != m_Locations.end()) {
+            return it->second;
         }
-        glDeleteShader(vertex);
-        glDeleteShader(fragment);
+        // 表中没有的名字（如数组的非首元素）向驱动查询一次后缓存
+        int loc = glGetUniformLocation(m_Program, name.c_str());
+        m_Locations.emplace(name, loc);
+        return loc;
+    }
+    bool Shader::changed(int location, const void* data, size_t bytes) const
+    {
+        if (location < 0) return false;
+        if (static_cast<size_t>(location) >= m_Shadow.size()) {
+            m_Shadow.resize(static_cast<size_t>(location) + 1);
+        }
+        UniformState& state = m_Shadow[location];
+        if (state.valid && std::memcmp(state.data, data, bytes) == 0) {
+            return false;
+        }
+        std::memcpy(state.data, data, bytes);
+        state.valid = true;
+        return true;
     }
     Shader::~Shader()
     {
@@ -110,37 +166,81 @@ namespace esl
     void Shader::unload() {
         glUseProgram(0);
     }
+    UniformHandle Shader::getUniform(const std::string& name) const
+    {
+        return UniformHandle(location(name));
+    }
+    void Shader::set(UniformHandle handle, bool value) const
+    {
+        set(handle, static_cast<int>(value));
+    }
+    void Shader::set(UniformHandle handle, int value) const
+    {
+        if (changed(handle.m_Location, &value, sizeof(value))) {
+            glUniform1i(handle.m_Location, value);
+        }
+    }
+    void Shader::set(UniformHandle handle, float value) const
+    {
+        if (changed(handle.m_Location, &value, sizeof(value))) {
+            glUniform1f(handle.m_Location, value);
+        }
+    }
+    void Shader::set(UniformHandle handle, const glm::vec2& value) const
+    {
+        if (changed(handle.m_Location, glm::value_ptr(value), sizeof(value))) {
+            glUniform2fv(handle.m_Location, 1, glm::value_ptr(value));
+        }
+    }
+    void Shader::set(UniformHandle handle, const glm::vec3& value) const
+    {
+        if (changed(handle.m_Location, glm::value_ptr(value), sizeof(value))) {
+            glUniform3fv(handle.m_Location, 1, glm::value_ptr(value));
+        }
+    }
+    void Shader::set(UniformHandle handle, const glm::vec4& value) const
+    {
+        if (changed(handle.m_Location, glm::value_ptr(value), sizeof(value))) {
+            glUniform4fv(handle.m_Location, 1, glm::value_ptr(value));
+        }
+    }
+    void Shader::set(UniformHandle handle, const glm::mat4& value) const
+    {
+        if (changed(handle.m_Location, glm::value_ptr(value), sizeof(value))) {
+            glUniformMatrix4fv(handle.m_Location, 1, GL_FALSE, glm::value_ptr(value));
+        }
+    }
     void Shader::setBool(const std::string& name, bool value) const
     {
-        glUniform1i(glGetUniformLocation(m_Program, name.c_str()), (int)value);
+        set(getUniform(name), value);
     }
     void Shader::setInt(const std::string& name, int value) const
     {
-        glUniform1i(glGetUniformLocation(m_Program, name.c_str()), value);
+        set(getUniform(name), value);
     }
     void Shader::setFloat(const std::string& name, float value) const
     {
-        glUniform1f(glGetUniformLocation(m_Program, name.c_str()), value);
+        set(getUniform(name), value);
     }
     void Shader::set3Float(const std::string& name, float value1, float value2, float value3)
     {
-        glUniform3f(glGetUniformLocation(m_Program, name.c_str()), value1, value2, value3);
+        set(getUniform(name), glm::vec3(value1, value2, value3));
     }
     void Shader::setMat4(const std::string& name, glm::mat4& matrix) const {
-        glUniformMatrix4fv(glGetUniformLocation(m_Program, name.c_str()), 1, GL_FALSE, glm::value_ptr(matrix));
+        set(getUniform(name), matrix);
     }
     void Shader::setVec4(const std::string& name, glm::vec4& vector) const {
-        glUniform4fv(glGetUniformLocation(m_Program, name.c_str()), 1, glm::value_ptr(vector));
+        set(getUniform(name), vector);
     }
 
     void Shader::setVec3(const std::string& name, glm::vec3& vector) const
     {
-        glUniform3fv(glGetUniformLocation(m_Program, name.c_str()), 1, glm::value_ptr(vector));
+        set(getUniform(name), vector);
     }
 
     void Shader::setVec2(const std::string& name, glm::vec2& vector) const
     {
-        glUniform2fv(glGetUniformLocation(m_Program, name.c_str()), 1, glm::value_ptr(vector));
+        set(getUniform(name), vector);
     }
 
 }
@@ -0,0 +1,231 @@
+﻿#include"ShaderLibrary.hpp"
+#include"glad/glad.h"
+#include<cstdio>
+#include<cstring>
+#include<filesystem>
+#include<fstream>
+#include<vector>
+
+namespace esl
+{
+	std::unordered_map<std::string, std::shared_ptr<Shader>> ShaderLibrary::s_Programs;
+	std::unordered_map<std::string, std::shared_ptr<Shader>> ShaderLibrary::s_Named;
+
+	namespace
+	{
+		constexpr char BINARY_MAGIC[4] = { 'E', 'S', 'L', 'B' };
+		constexpr uint32_t BINARY_VERSION = 1;
+		// 单个程序二进制的上限，超出按损坏处理
+		constexpr uint32_t MAX_BINARY_BYTES = 64u << 20;
+
+		struct BinaryHeader {
+			char magic[4];
+			uint32_t version;
+			uint64_t sourceHash;	// 源码的哈希
+			uint64_t driverHash;	// 驱动标识的哈希
+			uint32_t format;		// glGetProgramBinary 返回的格式
+			uint32_t length;
+		};
+
+		std::filesystem::path s_BinaryDirectory;	// 为空时不使用二进制缓存
+		uint64_t s_DriverHash = 0;
+		ShaderLibrary::BinaryCacheStats s_BinaryStats;
+
+		uint64_t fnv1a(const std::string& text, uint64_t hash = 14695981039346656037ull)
+		{
+			for (unsigned char c : text) {
+				hash ^= c;
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		std::string glString(GLenum name)
+		{
+			const GLubyte* text = glGetString(name);
+			return text ? reinterpret_cast<const char*>(text) : "";
+		}
+
+		std::filesystem::path binaryPath(uint64_t sourceHash)
+		{
+			char name[40];
+			std::snprintf(name, sizeof(name), "%016llx.bin",
+				static_cast<unsigned long long>(sourceHash ^ (s_DriverHash * 31)));
+			return s_BinaryDirectory / name;
+		}
+
+		// 读取缓存文件，文件缺失、头部不符或驱动不同时返回 false
+		bool readBinary(const std::filesystem::path& path, uint64_t sourceHash, uint32_t& format, std::vector<char>& data)
+		{
+			std::ifstream in(path, std::ios::binary);
+			if (!in) return false;
+			BinaryHeader header;
+			if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+			if (std::memcmp(header.magic, BINARY_MAGIC, 4) != 0 || header.version != BINARY_VERSION
+				|| header.sourceHash != sourceHash || header.driverHash != s_DriverHash
+				|| header.length == 0 || header.length > MAX_BINARY_BYTES) return false;
+			data.resize(header.length);
+			if (!in.read(data.data(), header.length)) return false;
+			format = header.format;
+			return true;
+		}
+
+		void writeBinary(const std::filesystem::path& path, uint64_t sourceHash, const Shader& shader)
+		{
+			uint32_t format = 0;
+			std::vector<char> data;
+			if (!shader.getBinary(format, data) || data.size() > MAX_BINARY_BYTES) return;
+			BinaryHeader header;
+			std::memcpy(header.magic, BINARY_MAGIC, 4);
+			header.version = BINARY_VERSION;
+			header.sourceHash = sourceHash;
+			header.driverHash = s_DriverHash;
+			header.format = format;
+			header.length = static_cast<uint32_t>(data.size());
+			// 先写临时文件再改名，中途退出不会留下半个文件
+			std::filesystem::path temp = path;
+			temp += ".tmp";
+			{
+				std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+				if (!out) return;
+				out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+				out.write(data.data(), static_cast<std::streamsize>(data.size()));
+				if (!out) return;
+			}
+			std::error_code error;
+			std::filesystem::rename(temp, path, error);
+			if (error) {
+				std::filesystem::remove(temp, error);
+				return;
+			}
+			s_BinaryStats.stored++;
+		}
+
+		// 优先从二进制缓存载入，否则编译链接并写入缓存
+		std::shared_ptr<Shader> createProgram(const std::string& key, const std::string& vertexCode, const std::string& fragmentCode)
+		{
+			if (s_BinaryDirectory.empty()) {
+				return std::make_shared<Shader>(vertexCode, fragmentCode);
+			}
+			const uint64_t sourceHash = fnv1a(key);
+			const std::filesystem::path path = binaryPath(sourceHash);
+			uint32_t format = 0;
+			std::vector<char> data;
+			if (readBinary(path, sourceHash, format, data)) {
+				if (auto shader = Shader::fromBinary(format, data.data(), static_cast<int>(data.size()))) {
+					s_BinaryStats.hits++;
+					return shader;
+				}
+				s_BinaryStats.rejected++;
+			}
+			else {
+				std::error_code error;
+				if (std::filesystem::exists(path, error)) s_BinaryStats.rejected++;
+				else s_BinaryStats.misses++;
+			}
+			auto shader = std::make_shared<Shader>(vertexCode, fragmentCode);
+			if (shader->linked()) writeBinary(path, sourceHash, *shader);
+			return shader;
+		}
+	}
+
+	static std::string makeKey(const std::string& vertexCode, const std::string& fragmentCode)
+	{
+		std::string key;
+		key.reserve(vertexCode.size() + fragmentCode.size() + 1);
+		key.append(vertexCode);
+		key.push_back('\0');
+		key.append(fragmentCode);
+		return key;
+	}
+
+	std::shared_ptr<Shader> ShaderLibrary::get(const std::string& vertexCode, const std::string& fragmentCode)
+	{
+		std::string key = makeKey(vertexCode, fragmentCode);
+		auto it = s_Programs.find(key);
+		if (it != s_Programs.end()) {
+			return it->second;
+		}
+		auto shader = createProgram(key, vertexCode, fragmentCode);
+		s_Programs.emplace(std::move(key), shader);
+		return shader;
+	}
+
+	std::shared_ptr<Shader> ShaderLibrary::get(const std::string& name, const std::string& vertexCode, const std::string& fragmentCode)
+	{
+		auto it = s_Named.find(name);
+		if (it != s_Named.end()) {
+			return it->second;
+		}
+		auto shader = get(vertexCode, fragmentCode);
+		s_Named.emplace(name, shader);
+		return shader;
+	}
+
+	std::shared_ptr<Shader> ShaderLibrary::find(const std::string& name)
+	{
+		auto it = s_Named.find(name);
+		return it != s_Named.end() ? it->second : nullptr;
+	}
+
+	size_t ShaderLibrary::size()
+	{
+		return s_Programs.size();
+	}
+
+	void ShaderLibrary::purge()
+	{
+		// 名字表和源码表各持有一份引用
+		for (auto it = s_Named.begin(); it != s_Named.end();) {
+			if (it->second.use_count() <= 2) it = s_Named.erase(it);
+			else ++it;
+		}
+		for (auto it = s_Programs.begin(); it != s_Programs.end();) {
+			if (it->second.use_count() == 1) it = s_Programs.erase(it);
+			else ++it;
+		}
+	}
+
+	void ShaderLibrary::clear()
+	{
+		s_Named.clear();
+		s_Programs.clear();
+	}
+
+	bool ShaderLibrary::setBinaryCache(const std::string& directory)
+	{
+		s_BinaryDirectory.clear();
+		if (directory.empty()) return false;
+		GLint formats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+		if (formats <= 0) return false;
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+		if (error) {
+			std::cout << "ShaderLibrary: cannot create binary cache " << directory << ": " << error.message() << std::endl;
+			return false;
+		}
+		// 驱动更新后二进制通常不再可用，把驱动标识计入文件名与文件头
+		s_DriverHash = fnv1a(glString(GL_VENDOR) + '|' + glString(GL_RENDERER) + '|' + glString(GL_VERSION));
+		s_BinaryDirectory = directory;
+		return true;
+	}
+
+	const ShaderLibrary::BinaryCacheStats& ShaderLibrary::binaryCacheStats()
+	{
+		return s_BinaryStats;
+	}
+
+	std::string ShaderLibrary::summary()
+	{
+		char line[160];
+		if (s_BinaryDirectory.empty()) {
+			std::snprintf(line, sizeof(line), "shaders: %zu programs, binary cache off", s_Programs.size());
+		}
+		else {
+			std::snprintf(line, sizeof(line), "shaders: %zu programs, binary cache %u hits, %u misses, %u rejected",
+				s_Programs.size(), s_BinaryStats.hits, s_BinaryStats.misses, s_BinaryStats.rejected);
+		}
+		return line;
+	}
+}
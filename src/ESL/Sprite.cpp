@@ -1,6 +1,8 @@
 #include"glad/glad.h"
 #include"GLFW/glfw3.h"
 #include "Sprite.hpp"
+#include "ShaderLibrary.hpp"
+#include "TextureAtlas.hpp"
 
 namespace esl
 {
@@ -14,31 +16,55 @@ namespace esl
 		m_Texture = texture;
 		m_Size = { texture->getWidth(), texture->getHeight() };
 	}
-	void Sprite::setup()
+	Sprite::Sprite(const TextureRegion& region)
 	{
-		glGenVertexArrays(1, &m_VAO);
-		glBindVertexArray(m_VAO);
+		setup();
+		setTextureRegion(region);
+	}
+	uint Sprite::s_QuadVAO = 0;
+	uint Sprite::s_QuadVBO = 0;
+	uint Sprite::s_QuadEBO = 0;
+
+	uint Sprite::sharedQuad()
+	{
+		if (s_QuadVAO) return s_QuadVAO;
+		glGenVertexArrays(1, &s_QuadVAO);
+		glBindVertexArray(s_QuadVAO);
 		unsigned int indices[] = { 0, 1, 2, 1, 2, 3 };
+		// 位置 + 纹理插值系数，实际纹理坐标在着色器中由 uvRect 换算
 		float vertices[] = {
-			-0.5f, -0.5f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
-			0.5f, -0.5f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f,
-			-0.5f, 0.5f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f,
-			0.5f, 0.5f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f };
-		glGenBuffers(1, &m_VBO);
-		glGenBuffers(1, &m_EBO);
-		glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+			-0.5f, -0.5f, 0.0f, 0.0f, 0.0f,
+			0.5f, -0.5f, 0.0f, 1.0f, 0.0f,
+			-0.5f, 0.5f, 0.0f, 0.0f, 1.0f,
+			0.5f, 0.5f, 0.0f, 1.0f, 1.0f };
+		glGenBuffers(1, &s_QuadVBO);
+		glGenBuffers(1, &s_QuadEBO);
+		glBindBuffer(GL_ARRAY_BUFFER, s_QuadVBO);
 		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s_QuadEBO);
 		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
 
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
 		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-		glEnableVertexAttribArray(1);
-		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
 		glEnableVertexAttribArray(2);
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 		glBindVertexArray(0);
+		return s_QuadVAO;
+	}
+
+	void Sprite::releaseSharedQuad()
+	{
+		if (!s_QuadVAO) return;
+		glDeleteVertexArrays(1, &s_QuadVAO);
+		glDeleteBuffers(1, &s_QuadVBO);
+		glDeleteBuffers(1, &s_QuadEBO);
+		s_QuadVAO = s_QuadVBO = s_QuadEBO = 0;
+	}
+
+	void Sprite::setup()
+	{
+		m_VAO = sharedQuad();
 		const std::string vstring = {
 			"#version 460 core\n"
 			"layout(location = 0) in vec3 aPos;\n"
@@ -48,9 +74,10 @@ namespace esl
 			"uniform mat4 projection;\n"
 			"uniform mat4 view;\n"
 			"uniform vec2 uvScale;\n"
+			"uniform vec4 uvRect;\n"
 			"void main() {\n"
 			"gl_Position = projection * view * transform * vec4(aPos, 1.0);\n"
-			"uv = aUV * uvScale;\n"
+			"uv = mix(uvRect.xy, uvRect.zw, aUV) * uvScale;\n"
 			"}\0" };
 		const std::string fstring = {
 			"#version 460 core\n"
@@ -61,8 +88,18 @@ namespace esl
 			"void main() {\n"
 			"fragColor = texture(sampler,uv)*spriteColor;\n"
 			"}\0" };
-		m_Shader = new Shader(vstring, fstring);
-		m_Shader->setInt("sampler", 0);
+		m_Shader = ShaderLibrary::get(vstring, fstring);
+		resolveUniforms();
+	}
+
+	void Sprite::resolveUniforms()
+	{
+		m_Uniforms.projection = m_Shader->getUniform("projection");
+		m_Uniforms.view = m_Shader->getUniform("view");
+		m_Uniforms.transform = m_Shader->getUniform("transform");
+		m_Uniforms.spriteColor = m_Shader->getUniform("spriteColor");
+		m_Uniforms.uvScale = m_Shader->getUniform("uvScale");
+		m_Uniforms.uvRect = m_Shader->getUniform("uvRect");
 	}
 
 	void Sprite::setPosition(glm::vec2 pos)
@@ -73,6 +110,17 @@ namespace esl
 	{
 		m_Texture = texture;
 		m_Size = { texture->getWidth(), texture->getHeight() };
+		m_RegionOffset = { 0.f, 0.f };
+		m_RegionSize = { 0.f, 0.f };
+	}
+	void Sprite::setTextureRegion(const TextureRegion& region)
+	{
+		if (!region.texture) return;
+		m_Texture = region.texture;
+		m_Size = { region.texture->getWidth(), region.texture->getHeight() };
+		m_RegionOffset = region.offset;
+		m_RegionSize = region.size;
+		setTextureRect({ 0.f, 0.f }, region.size);
 	}
 	Texture* Sprite::getTexture() const
 	{
@@ -146,23 +194,16 @@ namespace esl
 	{
 		float textureWidth = static_cast<float>(m_Texture->getWidth());
 		float textureHeight = static_cast<float>(m_Texture->getHeight());
+		pos += m_RegionOffset;
 
 		float u1 = pos.x / textureWidth;
 		float v1 = pos.y / textureHeight;
 		float u2 = (pos.x + size.x) / textureWidth;
 		float v2 = (pos.y + size.y) / textureHeight;
 
-		float vertices[] = {
-			-0.5f, -0.5f, 0.0f, 0.0f, 0.0f, 0.0f, u1, v1,
-			 0.5f, -0.5f, 0.0f, 0.0f, 0.0f, 0.0f, u2, v1,
-			-0.5f,  0.5f, 0.0f, 0.0f, 0.0f, 0.0f, u1, v2,
-			 0.5f,  0.5f, 0.0f, 0.0f, 0.0f, 0.0f, u2, v2
-		};
-
-		glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		// 只记录纹理区域，绘制时作为 uniform 传入，不再写顶点缓冲
 		m_RectScale = { u2 - u1,v2 - v1 };
+		m_TexRect = { u1, v1, u2, v2 };
 	}
 
 	void Sprite::setTextureRectFlip(glm::vec2 pos, glm::vec2 size)
@@ -172,48 +213,36 @@ namespace esl
 		float textureWidth = static_cast<float>(m_Texture->getWidth());
 		float textureHeight = static_cast<float>(m_Texture->getHeight());
 
-		// U  (ˮƽ) ͨҪ䣬߾ 0
+		// 图集区域内的坐标换算到整张纹理
+		float regionHeight = m_RegionSize.y > 0.f ? m_RegionSize.y : textureHeight;
+		pos.x += m_RegionOffset.x;
+		pos.y += textureHeight - m_RegionOffset.y - regionHeight;
+
+		// U 方向 (水平) 通常不需要变，左边就是 0
 		float u1 = pos.x / textureWidth;
 		float u2 = (pos.x + size.x) / textureWidth;
 
-		// V  (ֱ) ת
-		//  pos.y ǾͼƬ
-		// ҪתΪͼƬײ UV 
-		// OpenGL UV: 0 ڵײ1 ڶ
-
-		// ߽ UV (Ӧ pos.y) -> 1.0 - (pos.y / height)
-		// ײ߽ UV (Ӧ pos.y + size.y) -> 1.0 - ((pos.y + size.y) / height)
+		// V 方向 (垂直) 转换
+		// 输入的 pos.y 是距离图片顶部的像素数
+		// 我们需要将其转换为距离图片底部的 UV 坐标
+		// OpenGL UV: 0 在底部，1 在顶部。
 
-		// ע⣺v1 ӦǽС UV ֵǽϴģȡĶ˳ͼƬǷڼʱתˡ
-		// ͨͼƬʱ stbi_set_flip_vertically_on_load(true)ͼƬڴġ
-		// ʱ texture(uv)  v=0 ͼƬײ
+		// 顶部边界的 UV (对应 pos.y) -> 1.0 - (pos.y / height)
+		// 底部边界的 UV (对应 pos.y + size.y) -> 1.0 - ((pos.y + size.y) / height)
 
-		// ҪȡͼƬӾϡϷ (pos.y)
-		// Ӧ UV Ӧǿ 1.0 
+		// 注意：v1 应该是较小的 UV 值还是较大的？这取决于你的顶点顺序和图片是否在加载时翻转了。
+		// 通常图片加载时如果是 stbi_set_flip_vertically_on_load(true)，图片所以在内存里是正的。
+		// 此时 texture(uv) 中 v=0 是图片底部。
 
-		float v2 = 1.0f - (pos.y / textureHeight);           // ζ V (ֵϴ)
-		float v1 = 1.0f - ((pos.y + size.y) / textureHeight); // εײ V (ֵС)
+		// 想要切取图片“视觉上”的上方区域 (pos.y)
+		// 对应的 UV 应该是靠近 1.0 的区域
 
-		// ¶ (ֶ˳ setTextureRect һ)
-		// Ķ˳: , , , 
-		// ¶Ӧ UV  (u1, v1)
-		// ¶Ӧ UV  (u2, v1)
-		// ϶Ӧ UV  (u1, v2)
-		// ϶Ӧ UV  (u2, v2)
-
-		float vertices[] = {
-			-0.5f, -0.5f, 0.0f, 0.0f, 0.0f, 0.0f, u1, v1,
-			 0.5f, -0.5f, 0.0f, 0.0f, 0.0f, 0.0f, u2, v1,
-			-0.5f,  0.5f, 0.0f, 0.0f, 0.0f, 0.0f, u1, v2,
-			 0.5f,  0.5f, 0.0f, 0.0f, 0.0f, 0.0f, u2, v2
-		};
-
-		glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		float v2 = 1.0f - (pos.y / textureHeight);           // 矩形顶部的 V (数值较大)
+		float v1 = 1.0f - ((pos.y + size.y) / textureHeight); // 矩形底部的 V (数值较小)
 
-		// űں
-		m_RectScale = { u2 - u1, v2 - v1 }; // 
+		// 保存缩放比例用于后续计算
+		m_RectScale = { u2 - u1, v2 - v1 }; // 这里可能需
+		m_TexRect = { u1, v1, u2, v2 };
 	}
 
 	void Sprite::setRepeat(glm::uvec2 size)
@@ -230,8 +259,7 @@ namespace esl
 			glDeleteVertexArrays(1, &m_BorderVAO);
 			glDeleteBuffers(1, &m_BorderVBO);
 			glDeleteBuffers(1, &m_BorderEBO);
-			delete m_BorderShader;
-			m_BorderShader = nullptr;
+			m_BorderShader.reset();
 		}
 		m_BorderWidthPixels = 5.f;
 		m_BorderColor = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
@@ -246,19 +274,19 @@ namespace esl
 	void Sprite::setUpBorder()
 	{
 		float borderVertices[] = {
-			-0.5f, -0.5f, 0.0f,  // 
-			0.5f, -0.5f, 0.0f,  // 
-			0.5f,  0.5f, 0.0f,  // 
-			-0.5f,  0.5f, 0.0f   // 
+			-0.5f, -0.5f, 0.0f,  // 左下
+			0.5f, -0.5f, 0.0f,  // 右下
+			0.5f,  0.5f, 0.0f,  // 右上
+			-0.5f,  0.5f, 0.0f   // 左上
 		};
 		//unsigned int borderIndices[] = { 0, 1, 2, 1, 2, 3 };
 
-		// ߣ
+		// 线条索引（绘制四条边）
 		unsigned int borderIndices[] = {
-			0, 1, // ±
-			1, 2, // ұ
-			2, 3, // ϱ
-			3, 0  // 
+			0, 1, // 下边
+			1, 2, // 右边
+			2, 3, // 上边
+			3, 0  // 左边
 		};
 		glGenVertexArrays(1, &m_BorderVAO);
 		glBindVertexArray(m_BorderVAO);
@@ -297,7 +325,7 @@ namespace esl
 		}
 	)";
 
-		m_BorderShader = new Shader(borderVShader, borderFShader);
+		m_BorderShader = ShaderLibrary::get(borderVShader, borderFShader);
 	}
 
 	void Sprite::draw(float right, float top)
@@ -309,8 +337,8 @@ namespace esl
 		glm::mat4 view(1.f);
 
 		projection = glm::ortho(0.0f, right, 0.0f, top, -1.0f, 1.0f);
-		m_Shader->setMat4("projection", projection);
-		m_Shader->setMat4("view", view);
+		m_Shader->set(m_Uniforms.projection, projection);
+		m_Shader->set(m_Uniforms.view, view);
 		glm::mat4 transform = glm::mat4(1.0f);
 
 		transform = glm::translate(transform, m_Position);
@@ -321,9 +349,10 @@ namespace esl
 		glm::vec2 scaledSize = m_Size * m_Scale * m_RectScale * m_RepeatScale;
 		transform = glm::scale(transform, glm::vec3(scaledSize.x, scaledSize.y, 1.0f));
 
-		m_Shader->setMat4("transform", transform);
-		m_Shader->setVec4("spriteColor", m_Color);
-		m_Shader->setVec2("uvScale", m_RepeatScale);
+		m_Shader->set(m_Uniforms.transform, transform);
+		m_Shader->set(m_Uniforms.spriteColor, m_Color);
+		m_Shader->set(m_Uniforms.uvScale, m_RepeatScale);
+		m_Shader->set(m_Uniforms.uvRect, m_TexRect);
 
 		glBindVertexArray(m_VAO);
 		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
@@ -1,6 +1,7 @@
 #include"glad/glad.h"
 #include"GLFW/glfw3.h"
 #include "Sprite3D.hpp"
+#include "ShaderLibrary.hpp"
 
 namespace esl
 {
@@ -15,9 +16,7 @@ namespace esl
 	}
 	void Sprite3D::setupFogShader()
 	{
-		// ֧Чɫ滻Ĭɫ
-		delete m_Shader;
-
+		// 用支持雾效的着色器替换默认着色器
 		const std::string vstring = {
 			"#version 460 core\n"
 			"layout(location = 0) in vec3 aPos;\n"
@@ -28,11 +27,12 @@ namespace esl
 			"uniform mat4 projection;\n"
 			"uniform mat4 view;\n"
 			"uniform vec2 uvScale;\n"
+			"uniform vec4 uvRect;\n"
 			"void main() {\n"
 			"vec4 worldPos = transform * vec4(aPos, 1.0);\n"
 			"fragWorldPos = worldPos.xyz;\n"
 			"gl_Position = projection * view * worldPos;\n"
-			"uv = aUV * uvScale;\n"
+			"uv = mix(uvRect.xy, uvRect.zw, aUV) * uvScale;\n"
 			"}\0" };
 
 		const std::string fstring = {
@@ -58,10 +58,15 @@ namespace esl
 			"}\n"
 			"}\0" };
 
-		m_Shader = new Shader(vstring, fstring);
-		m_Shader->setInt("sampler", 0);
+		m_Shader = ShaderLibrary::get(vstring, fstring);
+		resolveUniforms();
+		m_FogUniforms.cameraPos = m_Shader->getUniform("cameraPos");
+		m_FogUniforms.fogEnabled = m_Shader->getUniform("fogEnabled");
+		m_FogUniforms.fogStart = m_Shader->getUniform("fogStart");
+		m_FogUniforms.fogEnd = m_Shader->getUniform("fogEnd");
+		m_FogUniforms.fogColor = m_Shader->getUniform("fogColor");
 
-		// ĬϽЧ
+		// 默认禁用雾效
 		m_FogEnabled = false;
 		m_FogStart = 100.0f;
 		m_FogEnd = 500.0f;
@@ -135,8 +140,8 @@ namespace esl
 			view = glm::lookAt(m_Camera->m_Pos, m_Camera->m_Target, m_Camera->m_UpVector);
 			if (m_Camera->m_ViewportOffset.x || m_Camera->m_ViewportOffset.y )
 			{
-				// תΪ׼豸(NDC)
-				// NDCΧ[-1, 1]ĻΪ(0, 0)
+				// 将像素坐标转换为标准化设备坐标(NDC)
+				// NDC范围是[-1, 1]，屏幕中心为(0, 0)
 				float ndcOffsetX = (m_Camera->m_ViewportOffset.x * 2.0f) / right;
 				float ndcOffsetY = (m_Camera->m_ViewportOffset.y * 2.0f) / top;
 
@@ -144,21 +149,21 @@ namespace esl
 					glm::vec3(ndcOffsetX, ndcOffsetY, 0.0f));
 				projection = offsetMatrix * projection;
 			}
-			// λЧ
-			m_Shader->setVec3("cameraPos", m_Camera->m_Pos);
+			// 传递摄像机位置用于雾效计算
+			m_Shader->set(m_FogUniforms.cameraPos, m_Camera->m_Pos);
 		}
 		else
 		{
 			projection = glm::ortho(0.0f, right, 0.0f, top, -1.0f, 1.0f);
 		}
-		// Ч
-		m_Shader->setBool("fogEnabled", m_FogEnabled);
-		m_Shader->setFloat("fogStart", m_FogStart);
-		m_Shader->setFloat("fogEnd", m_FogEnd);
-		m_Shader->setVec4("fogColor", m_FogColor);
-
-		m_Shader->setMat4("projection", projection);
-		m_Shader->setMat4("view", view);
+		// 设置雾效参数
+		m_Shader->set(m_FogUniforms.fogEnabled, m_FogEnabled);
+		m_Shader->set(m_FogUniforms.fogStart, m_FogStart);
+		m_Shader->set(m_FogUniforms.fogEnd, m_FogEnd);
+		m_Shader->set(m_FogUniforms.fogColor, m_FogColor);
+
+		m_Shader->set(m_Uniforms.projection, projection);
+		m_Shader->set(m_Uniforms.view, view);
 		glm::mat4 transform = glm::mat4(1.0f);
 		transform = glm::translate(transform, m_Position);
 		transform = glm::translate(transform, m_Origin3D);
@@ -169,9 +174,10 @@ namespace esl
 		glm::vec2 scaledSize = m_Size * m_Scale * m_RectScale * m_RepeatScale;
 		transform = glm::scale(transform, glm::vec3(scaledSize.x, scaledSize.y, 1.0f));
 
-		m_Shader->setMat4("transform", transform);
-		m_Shader->setVec4("spriteColor", m_Color);
-		m_Shader->setVec2("uvScale", m_RepeatScale);
+		m_Shader->set(m_Uniforms.transform, transform);
+		m_Shader->set(m_Uniforms.spriteColor, m_Color);
+		m_Shader->set(m_Uniforms.uvScale, m_RepeatScale);
+		m_Shader->set(m_Uniforms.uvRect, m_TexRect);
 
 
 		glBindVertexArray(m_VAO);
@@ -0,0 +1,222 @@
+﻿#include"glad/glad.h"
+#include"GLFW/glfw3.h"
+#include"SpriteBatch.hpp"
+#include"Sprite.hpp"
+#include"ShaderLibrary.hpp"
+#include<cmath>
+
+namespace esl
+{
+	SpriteBatch::SpriteBatch(size_t capacity)
+	{
+		unsigned int indices[] = { 0, 1, 2, 1, 2, 3 };
+		// 单位四边形：位置 + 纹理插值系数
+		float vertices[] = {
+			-0.5f, -0.5f, 0.0f, 0.0f,
+			 0.5f, -0.5f, 1.0f, 0.0f,
+			-0.5f,  0.5f, 0.0f, 1.0f,
+			 0.5f,  0.5f, 1.0f, 1.0f };
+		glGenVertexArrays(1, &m_VAO);
+		glBindVertexArray(m_VAO);
+		glGenBuffers(1, &m_QuadVBO);
+		glGenBuffers(1, &m_EBO);
+		glGenBuffers(1, &m_InstanceVBO);
+		glBindBuffer(GL_ARRAY_BUFFER, m_QuadVBO);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+		glEnableVertexAttribArray(1);
+
+		// 实例属性，每个实例前进一次
+		glBindBuffer(GL_ARRAY_BUFFER, m_InstanceVBO);
+		const GLsizei stride = sizeof(Instance);
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Instance, translation));
+		glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Instance, rotation));
+		glVertexAttribPointer(4, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Instance, scale));
+		glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Instance, uvRect));
+		glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Instance, color));
+		glVertexAttribPointer(7, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(Instance, motion));
+		for (uint i = 2; i <= 7; i++) {
+			glEnableVertexAttribArray(i);
+			glVertexAttribDivisor(i, 1);
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBindVertexArray(0);
+		reserveInstances(capacity);
+
+		const std::string vstring = R"(
+		#version 460 core
+		layout(location = 0) in vec2 aPos;
+		layout(location = 1) in vec2 aCorner;
+		layout(location = 2) in vec2 iTranslation;
+		layout(location = 3) in float iRotation;
+		layout(location = 4) in vec2 iScale;
+		layout(location = 5) in vec4 iUVRect;
+		layout(location = 6) in vec4 iColor;
+		layout(location = 7) in vec2 iMotion;
+		out vec2 uv;
+		out vec4 color;
+		uniform mat4 projection;
+		uniform float alpha;
+		void main() {
+			float c = cos(iRotation);
+			float s = sin(iRotation);
+			vec2 p = aPos * iScale;
+			p = vec2(c * p.x - s * p.y, s * p.x + c * p.y) + iTranslation - iMotion * (1.0 - alpha);
+			gl_Position = projection * vec4(p, 0.0, 1.0);
+			uv = mix(iUVRect.xy, iUVRect.zw, aCorner);
+			color = iColor;
+		}
+	)";
+		const std::string fstring = R"(
+		#version 460 core
+		in vec2 uv;
+		in vec4 color;
+		out vec4 fragColor;
+		uniform sampler2D sampler;
+		void main() {
+			fragColor = texture(sampler, uv) * color;
+		}
+	)";
+		m_Shader = ShaderLibrary::get(vstring, fstring);
+		m_ProjectionUniform = m_Shader->getUniform("projection");
+		m_SamplerUniform = m_Shader->getUniform("sampler");
+		m_AlphaUniform = m_Shader->getUniform("alpha");
+	}
+
+	SpriteBatch::~SpriteBatch()
+	{
+		glDeleteVertexArrays(1, &m_VAO);
+		glDeleteBuffers(1, &m_QuadVBO);
+		glDeleteBuffers(1, &m_EBO);
+		glDeleteBuffers(1, &m_InstanceVBO);
+	}
+
+	void SpriteBatch::reserveInstances(size_t count)
+	{
+		if (count <= m_Capacity) return;
+		// 按 2 倍增长，避免频繁重新分配显存
+		m_Capacity = m_Capacity == 0 ? count : m_Capacity;
+		while (m_Capacity < count) m_Capacity *= 2;
+		glBindBuffer(GL_ARRAY_BUFFER, m_InstanceVBO);
+		glBufferData(GL_ARRAY_BUFFER, m_Capacity * sizeof(Instance), nullptr, GL_STREAM_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		m_Staging.reserve(m_Capacity);
+	}
+
+	void SpriteBatch::begin()
+	{
+		for (auto& g : m_Groups) {
+			g.instances.clear();
+		}
+	}
+
+	SpriteBatch::Group& SpriteBatch::group(Texture* texture, Blend blend)
+	{
+		// 连续添加的精灵通常属于同一组，先检查上一次命中的组
+		if (m_LastGroup < m_Groups.size()) {
+			Group& last = m_Groups[m_LastGroup];
+			if (last.texture == texture && last.blend == blend) return last;
+		}
+		for (size_t i = 0; i < m_Groups.size(); i++) {
+			if (m_Groups[i].texture == texture && m_Groups[i].blend == blend) {
+				m_LastGroup = i;
+				return m_Groups[i];
+			}
+		}
+		m_Groups.push_back(Group{ texture, blend, {} });
+		m_LastGroup = m_Groups.size() - 1;
+		return m_Groups.back();
+	}
+
+	void SpriteBatch::add(Texture* texture, const Instance& instance, Blend blend)
+	{
+		if (!texture) return;
+		group(texture, blend).instances.push_back(instance);
+	}
+
+	void SpriteBatch::add(Texture* texture, const Instance* instances, size_t count, Blend blend)
+	{
+		if (!texture || count == 0) return;
+		std::vector<Instance>& target = group(texture, blend).instances;
+		target.insert(target.end(), instances, instances + count);
+	}
+
+	void SpriteBatch::add(const Sprite& sprite, Blend blend, glm::vec2 motion)
+	{
+		if (!sprite.m_Texture) return;
+		Instance instance;
+		float radians = glm::radians(sprite.m_Rotation);
+		float c = std::cos(radians);
+		float s = std::sin(radians);
+		// 与 Sprite::draw 的变换一致：T(pos) * T(origin) * R * T(-origin) * S
+		glm::vec2 origin = sprite.m_Origin;
+		glm::vec2 rotatedOrigin = { c * origin.x - s * origin.y, s * origin.x + c * origin.y };
+		instance.translation = glm::vec2(sprite.m_Position) + origin - rotatedOrigin;
+		instance.rotation = radians;
+		instance.scale = sprite.m_Size * sprite.m_Scale * sprite.m_RectScale * sprite.m_RepeatScale;
+		// 重复平铺直接折算进纹理坐标
+		instance.uvRect = sprite.m_TexRect * glm::vec4(sprite.m_RepeatScale, sprite.m_RepeatScale);
+		instance.color = sprite.m_Color;
+		instance.motion = motion;
+		group(sprite.m_Texture, blend).instances.push_back(instance);
+	}
+
+	void SpriteBatch::setInterpolation(float alpha)
+	{
+		m_Alpha = alpha;
+	}
+
+	size_t SpriteBatch::size() const
+	{
+		size_t count = 0;
+		for (auto& g : m_Groups) count += g.instances.size();
+		return count;
+	}
+
+	void SpriteBatch::draw(float right, float top)
+	{
+		const size_t total = size();
+		if (total == 0) return;
+
+		// 把所有分组依次拷入暂存区，一次上传
+		m_Staging.clear();
+		reserveInstances(total);
+		for (auto& g : m_Groups) {
+			m_Staging.insert(m_Staging.end(), g.instances.begin(), g.instances.end());
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, m_InstanceVBO);
+		// 先丢弃旧存储再写入，避免等待上一帧的绘制
+		glBufferData(GL_ARRAY_BUFFER, m_Capacity * sizeof(Instance), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, total * sizeof(Instance), m_Staging.data());
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		glm::mat4 projection = glm::ortho(0.0f, right, 0.0f, top, -1.0f, 1.0f);
+		m_Shader->load();
+		m_Shader->set(m_ProjectionUniform, projection);
+		m_Shader->set(m_SamplerUniform, 0);
+		m_Shader->set(m_AlphaUniform, m_Alpha);
+		glBindVertexArray(m_VAO);
+
+		GLuint base = 0;
+		for (auto& g : m_Groups) {
+			if (g.instances.empty()) continue;
+			if (g.blend == Blend::ADDITIVE) {
+				glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+			}
+			g.texture->bind();
+			glDrawElementsInstancedBaseInstance(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0,
+				static_cast<GLsizei>(g.instances.size()), base);
+			if (g.blend == Blend::ADDITIVE) {
+				glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			}
+			base += static_cast<GLuint>(g.instances.size());
+		}
+
+		glBindVertexArray(0);
+		m_Shader->unload();
+	}
+}
@@ -5,7 +5,7 @@
 #include <codecvt>
 #include <stdexcept>
 #include <sstream>
-#include <fstream>  // ļ֧
+#include <fstream>  // 添加文件流支持
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
 
@@ -36,35 +36,35 @@ namespace esl
 			break;
 		case HorizontalAlign::Center:
 			if (count % 2) {
-				// мַλ
+				// 奇数：中间字符放在中心位置
 				int centerIndex = count / 2;
 				m_SpriteVector[centerIndex]->setPosition(pos);
 				m_SpriteVector[centerIndex]->setScale(m_Scale);
 				m_SpriteVector[centerIndex]->setRotation(m_Angle);
 
-				// Ҳַ
+				// 左侧和右侧字符
 				for (int i = 1; i <= count / 2; ++i)
 				{
-					// ַ
+					// 左侧字符
 					m_SpriteVector[centerIndex - i]->setPosition(pos - offset * static_cast<float>(i));
 					m_SpriteVector[centerIndex - i]->setScale(m_Scale);
 					m_SpriteVector[centerIndex - i]->setRotation(m_Angle);
-					// Ҳַ
+					// 右侧字符
 					m_SpriteVector[centerIndex + i]->setPosition(pos + offset * static_cast<float>(i));
 					m_SpriteVector[centerIndex + i]->setScale(m_Scale);
 					m_SpriteVector[centerIndex + i]->setRotation(m_Angle);
 				}
 			}
 			else {
-				// żĵַ
+				// 偶数：在中心点两侧放置字符
 				float halfOffset = 0.5f;
 				for (int i = 0; i < count / 2; ++i)
 				{
-					// ַ (ҵ)
+					// 左侧字符 (从右到左放置)
 					m_SpriteVector[count / 2 - 1 - i]->setPosition(pos - offset * (halfOffset + i));
 					m_SpriteVector[count / 2 - 1 - i]->setScale(m_Scale);
 					m_SpriteVector[count / 2 - 1 - i]->setRotation(m_Angle);
-					// Ҳַ (ҷ)
+					// 右侧字符 (从左到右放置)
 					m_SpriteVector[count / 2 + i]->setPosition(pos + offset * (halfOffset + i));
 					m_SpriteVector[count / 2 + i]->setScale(m_Scale);
 					m_SpriteVector[count / 2 + i]->setRotation(m_Angle);
@@ -72,7 +72,7 @@ namespace esl
 			}
 			break;
 		case HorizontalAlign::Right:
-			// Ҷ룺ַ
+			// 右对齐：从右往左放置字符
 			{
 				glm::vec2 rightStartPos = pos - offset * static_cast<float>(count - 1);
 				for (int i = 0; i < count; ++i)
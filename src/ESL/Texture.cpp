@@ -1,6 +1,8 @@
-#define STB_IMAGE_IMPLEMENTATION
+﻿#define STB_IMAGE_IMPLEMENTATION
 
 #include "Texture.hpp"
+#include "AssetPack.hpp"
+#include "TextureLoader.hpp"
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
 #include "stbImage/stb_image.h"
@@ -13,33 +15,19 @@ namespace esl
 		glGenTextures(1, &m_Texture);
 		glActiveTexture(GL_TEXTURE0);
 		glBindTexture(GL_TEXTURE_2D, m_Texture);
-		uint _wrap,_filter;
-		switch (filter) {
-			case Filter::LINEAR:
-				_filter = GL_LINEAR;
-				break;
-			case Filter::NEAREST:
-				_filter = GL_NEAREST;
-				break;
+		setParameters(wrap, filter);
+		if (TextureLoader::active() && TextureLoader::request(this, path, wrap, filter)) {
+			return;
 		}
-		switch (wrap) {
-			case Wrap::REPEAT:
-				_wrap = GL_REPEAT;
-				break;
-			case Wrap::MIRRORED_REPEAT:
-				_wrap = GL_MIRRORED_REPEAT;
-				break;
-			case Wrap::CLAMP_TO_EDGE:
-				_wrap = GL_CLAMP_TO_EDGE;
-				break;
-			case Wrap::CLAMP_TO_BORDER:
-				_wrap = GL_CLAMP_TO_BORDER;
-				break;
+		// 资源包中已是翻转好的 RGBA 像素，直接从映射内存上传
+		AssetPack::Image image;
+		if (AssetPack::findImage(path, image)) {
+			m_Width = image.width;
+			m_Height = image.height;
+			m_Channel = 4;
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels);
+			return;
 		}
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, _wrap);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, _wrap);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, _filter);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, _filter);
 		stbi_set_flip_vertically_on_load(true);
 		uchar* data = stbi_load(path, &m_Width, &m_Height, &m_Channel, 0);
 		if (data)
@@ -57,7 +45,6 @@ namespace esl
 				stbi_image_free(data);
 				return;
 			}
-			glGenerateMipmap(GL_TEXTURE_2D);
 		}
 		else
 		{
@@ -76,14 +63,56 @@ namespace esl
 		this->m_Height = height;
 		this->m_Channel = 4;
 	}
+	Texture::Texture(const uchar* pixels, int width, int height, Wrap wrap, Filter filter)
+	{
+		m_Width = width;
+		m_Height = height;
+		m_Channel = 4;
+		glGenTextures(1, &m_Texture);
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, m_Texture);
+		setParameters(wrap, filter);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+	}
 	Texture::~Texture()
 	{
+		if (m_Loading) TextureLoader::cancel(this);
 		glDeleteTextures(1, &m_Texture);
 	}
-	Texture::Size Texture::getSize()
+	Texture::Size Texture::getSize() const
 	{
 		return Size(m_Width, m_Height);
 	}
+	void Texture::setParameters(Wrap wrap, Filter filter)
+	{
+		uint _wrap,_filter;
+		switch (filter) {
+			case Filter::LINEAR:
+				_filter = GL_LINEAR;
+				break;
+			case Filter::NEAREST:
+				_filter = GL_NEAREST;
+				break;
+		}
+		switch (wrap) {
+			case Wrap::REPEAT:
+				_wrap = GL_REPEAT;
+				break;
+			case Wrap::MIRRORED_REPEAT:
+				_wrap = GL_MIRRORED_REPEAT;
+				break;
+			case Wrap::CLAMP_TO_EDGE:
+				_wrap = GL_CLAMP_TO_EDGE;
+				break;
+			case Wrap::CLAMP_TO_BORDER:
+				_wrap = GL_CLAMP_TO_BORDER;
+				break;
+		}
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, _wrap);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, _wrap);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, _filter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, _filter);
+	}
 	void Texture::bind()
 	{
 		glBindTexture(GL_TEXTURE_2D, m_Texture);
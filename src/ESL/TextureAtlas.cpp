@@ -0,0 +1,362 @@
+﻿#include "TextureAtlas.hpp"
+#include "AssetPack.hpp"
+#include "stbImage/stb_image.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace esl
+{
+	namespace {
+		const char CACHE_MAGIC[4] = { 'T', 'A', 'T', 'L' };
+		const uint32_t CACHE_VERSION = 1;
+
+		// skyline 装箱：记录每一段水平线的高度，新矩形放在能使其顶边最低的位置（bottom-left）
+		class SkylinePacker
+		{
+			struct Node {
+				int x, y, width;
+			};
+			int m_Width;
+			int m_Height;
+			std::vector<Node> m_Skyline;
+		public:
+			SkylinePacker(int width, int height) :m_Width(width), m_Height(height) {
+				m_Skyline.push_back({ 0, 0, width });
+			}
+			bool insert(int width, int height, int& outX, int& outY) {
+				size_t bestIndex = SIZE_MAX;
+				int bestTop = INT_MAX, bestWidth = INT_MAX, bestY = 0;
+				for (size_t i = 0; i < m_Skyline.size(); i++) {
+					int y;
+					if (!fit(i, width, height, y)) continue;
+					int top = y + height;
+					if (top < bestTop || (top == bestTop && m_Skyline[i].width < bestWidth)) {
+						bestIndex = i;
+						bestTop = top;
+						bestWidth = m_Skyline[i].width;
+						bestY = y;
+					}
+				}
+				if (bestIndex == SIZE_MAX) return false;
+				outX = m_Skyline[bestIndex].x;
+				outY = bestY;
+				addLevel(bestIndex, outX, bestY + height, width);
+				return true;
+			}
+			int usedHeight() const {
+				int height = 0;
+				for (auto& node : m_Skyline) height = std::max(height, node.y);
+				return height;
+			}
+		private:
+			bool fit(size_t index, int width, int height, int& y) const {
+				if (m_Skyline[index].x + width > m_Width) return false;
+				y = 0;
+				int remaining = width;
+				for (size_t i = index; remaining > 0; i++) {
+					y = std::max(y, m_Skyline[i].y);
+					if (y + height > m_Height) return false;
+					remaining -= m_Skyline[i].width;
+				}
+				return true;
+			}
+			void addLevel(size_t index, int x, int y, int width) {
+				m_Skyline.insert(m_Skyline.begin() + index, Node{ x, y, width });
+				// 被新线段覆盖的部分从后面的线段中去掉
+				for (size_t i = index + 1; i < m_Skyline.size();) {
+					int prevRight = m_Skyline[i - 1].x + m_Skyline[i - 1].width;
+					Node& node = m_Skyline[i];
+					if (node.x >= prevRight) break;
+					int shrink = prevRight - node.x;
+					node.x += shrink;
+					node.width -= shrink;
+					if (node.width > 0) break;
+					m_Skyline.erase(m_Skyline.begin() + i);
+				}
+				for (size_t i = 0; i + 1 < m_Skyline.size();) {
+					if (m_Skyline[i].y == m_Skyline[i + 1].y) {
+						m_Skyline[i].width += m_Skyline[i + 1].width;
+						m_Skyline.erase(m_Skyline.begin() + i + 1);
+					}
+					else i++;
+				}
+			}
+		};
+
+		// 把 w*h 的源图片复制到图集 (x, y) 处，并把边缘像素向外延伸 padding 圈
+		void blit(std::vector<uchar>& page, int pageWidth, const uchar* src, int width, int height, int x, int y, int padding) {
+			for (int row = -padding; row < height + padding; row++) {
+				int srcRow = std::clamp(row, 0, height - 1);
+				uchar* dst = page.data() + (static_cast<size_t>(y + row) * pageWidth + x - padding) * 4;
+				for (int col = -padding; col < width + padding; col++, dst += 4) {
+					int srcCol = std::clamp(col, 0, width - 1);
+					std::memcpy(dst, src + (static_cast<size_t>(srcRow) * width + srcCol) * 4, 4);
+				}
+			}
+		}
+
+		struct FileStamp {
+			uint64_t size = 0;
+			int64_t time = 0;
+		};
+		FileStamp stampOf(const std::string& path) {
+			FileStamp stamp;
+			std::error_code error;
+			auto size = std::filesystem::file_size(path, error);
+			if (!error) stamp.size = size;
+			auto time = std::filesystem::last_write_time(path, error);
+			if (!error) stamp.time = static_cast<int64_t>(time.time_since_epoch().count());
+			return stamp;
+		}
+
+		template<typename T>
+		void writeValue(std::ostream& out, T value) {
+			auto bits = static_cast<uint64_t>(value);
+			for (size_t i = 0; i < sizeof(T); i++) {
+				out.put(static_cast<char>((bits >> (i * 8)) & 0xFF));
+			}
+		}
+		template<typename T>
+		bool readValue(std::istream& in, T& value) {
+			uint64_t bits = 0;
+			for (size_t i = 0; i < sizeof(T); i++) {
+				int c = in.get();
+				if (c == EOF) return false;
+				bits |= static_cast<uint64_t>(static_cast<uint8_t>(c)) << (i * 8);
+			}
+			value = static_cast<T>(bits);
+			return true;
+		}
+		void writeString(std::ostream& out, const std::string& text) {
+			writeValue<uint32_t>(out, static_cast<uint32_t>(text.size()));
+			out.write(text.data(), text.size());
+		}
+		bool readString(std::istream& in, std::string& text) {
+			uint32_t length;
+			if (!readValue(in, length) || length > 4096) return false;
+			text.resize(length);
+			return static_cast<bool>(in.read(text.data(), length));
+		}
+	}
+
+	TextureAtlas::TextureAtlas(int pageSize, int padding, Texture::Filter filter)
+		:m_PageSize(pageSize), m_Padding(padding), m_Filter(filter)
+	{
+	}
+	TextureAtlas::~TextureAtlas() = default;
+
+	void TextureAtlas::add(const std::string& name, const std::string& path)
+	{
+		if (m_Index.count(name)) {
+			std::cout << "TextureAtlas: duplicate image name " << name << std::endl;
+			return;
+		}
+		m_Index[name] = m_Sources.size();
+		m_Sources.push_back({ name, path });
+		m_Regions.emplace_back();
+	}
+
+	bool TextureAtlas::build(const std::string& cachePath)
+	{
+		std::vector<Placement> placements;
+		std::vector<PageImage> pages;
+		bool complete = true;
+		if (cachePath.empty() || !loadCache(cachePath, placements, pages)) {
+			complete = pack(placements, pages);
+			// 不完整的结果不缓存，下次启动时重新尝试
+			if (!cachePath.empty() && complete) writeCache(cachePath, placements, pages);
+		}
+		createPages(placements, pages);
+		return complete;
+	}
+
+	const TextureRegion& TextureAtlas::region(const std::string& name) const
+	{
+		static const TextureRegion empty;
+		auto it = m_Index.find(name);
+		return it == m_Index.end() ? empty : m_Regions[it->second];
+	}
+	bool TextureAtlas::contains(const std::string& name) const
+	{
+		return m_Index.count(name) != 0;
+	}
+
+	bool TextureAtlas::pack(std::vector<Placement>& placements, std::vector<PageImage>& pages) const
+	{
+		struct Image {
+			size_t source;
+			int width = 0, height = 0;
+			const uchar* pixels = nullptr;
+			bool decoded = false;	// 由 stbi 解码，用完需释放；否则指向资源包映射
+		};
+		bool complete = true;
+		std::vector<Image> images;
+		stbi_set_flip_vertically_on_load(true);
+		for (size_t i = 0; i < m_Sources.size(); i++) {
+			Image image{ i };
+			AssetPack::Image packed;
+			if (AssetPack::findImage(m_Sources[i].path, packed)) {
+				image.pixels = packed.pixels;
+				image.width = packed.width;
+				image.height = packed.height;
+				images.push_back(image);
+				continue;
+			}
+			int channel;
+			image.pixels = stbi_load(m_Sources[i].path.c_str(), &image.width, &image.height, &channel, 4);
+			image.decoded = true;
+			if (!image.pixels) {
+				std::cout << "Failed to load texture:" << m_Sources[i].path << ":" << stbi_failure_reason() << std::endl;
+				complete = false;
+				continue;
+			}
+			images.push_back(image);
+		}
+		// 先放高的，skyline 的浪费最少
+		std::sort(images.begin(), images.end(), [](const Image& a, const Image& b) {
+			return a.height != b.height ? a.height > b.height : a.width > b.width;
+		});
+
+		placements.assign(m_Sources.size(), Placement());
+		std::vector<SkylinePacker> packers;
+		for (auto& image : images) {
+			int w = image.width + m_Padding * 2;
+			int h = image.height + m_Padding * 2;
+			Placement& placement = placements[image.source];
+			if (w > m_PageSize || h > m_PageSize) {
+				std::cout << "TextureAtlas: " << m_Sources[image.source].path << " (" << image.width << "x" << image.height
+					<< ") does not fit in a " << m_PageSize << "x" << m_PageSize << " page" << std::endl;
+				complete = false;
+				continue;
+			}
+			int x = 0, y = 0;
+			size_t page = 0;
+			while (page < packers.size() && !packers[page].insert(w, h, x, y)) page++;
+			if (page == packers.size()) {
+				packers.emplace_back(m_PageSize, m_PageSize);
+				packers.back().insert(w, h, x, y);
+			}
+			placement.page = static_cast<int>(page);
+			placement.x = x + m_Padding;
+			placement.y = y + m_Padding;
+			placement.w = image.width;
+			placement.h = image.height;
+		}
+
+		// 页高裁到实际用到的高度，图集只有一小部分时不必占满整页显存
+		pages.resize(packers.size());
+		for (size_t i = 0; i < packers.size(); i++) {
+			pages[i].width = m_PageSize;
+			pages[i].height = std::min(m_PageSize, (packers[i].usedHeight() + 3) / 4 * 4);
+			pages[i].pixels.assign(static_cast<size_t>(pages[i].width) * pages[i].height * 4, 0);
+		}
+		for (auto& image : images) {
+			const Placement& placement = placements[image.source];
+			if (placement.page >= 0) {
+				PageImage& page = pages[placement.page];
+				blit(page.pixels, page.width, image.pixels, image.width, image.height, placement.x, placement.y, m_Padding);
+			}
+			if (image.decoded) stbi_image_free(const_cast<uchar*>(image.pixels));
+		}
+		return complete;
+	}
+
+	void TextureAtlas::createPages(const std::vector<Placement>& placements, const std::vector<PageImage>& pages)
+	{
+		m_Pages.clear();
+		for (auto& page : pages) {
+			m_Pages.push_back(std::make_unique<Texture>(page.pixels.data(), page.width, page.height, Texture::Wrap::CLAMP_TO_EDGE, m_Filter));
+		}
+		for (size_t i = 0; i < m_Regions.size(); i++) {
+			const Placement& placement = placements[i];
+			TextureRegion& region = m_Regions[i];
+			if (placement.page < 0) {
+				region = TextureRegion();
+				continue;
+			}
+			region.texture = m_Pages[placement.page].get();
+			region.offset = glm::vec2(placement.x, placement.y);
+			region.size = glm::vec2(placement.w, placement.h);
+		}
+	}
+
+	bool TextureAtlas::loadCache(const std::string& path, std::vector<Placement>& placements, std::vector<PageImage>& pages) const
+	{
+		std::ifstream in(path, std::ios::binary);
+		if (!in) return false;
+		char magic[4];
+		uint32_t version, pageSize, padding, filter, sourceCount;
+		if (!in.read(magic, 4) || std::memcmp(magic, CACHE_MAGIC, 4) != 0) return false;
+		if (!readValue(in, version) || version != CACHE_VERSION) return false;
+		if (!readValue(in, pageSize) || !readValue(in, padding) || !readValue(in, filter)) return false;
+		if (pageSize != static_cast<uint32_t>(m_PageSize) || padding != static_cast<uint32_t>(m_Padding)
+			|| filter != static_cast<uint32_t>(m_Filter)) return false;
+		if (!readValue(in, sourceCount) || sourceCount != m_Sources.size()) return false;
+
+		// 源图片列表、大小与修改时间都一致时缓存才有效
+		placements.assign(m_Sources.size(), Placement());
+		for (size_t i = 0; i < m_Sources.size(); i++) {
+			std::string name, sourcePath;
+			FileStamp stamp;
+			if (!readString(in, name) || !readString(in, sourcePath)) return false;
+			if (!readValue(in, stamp.size) || !readValue(in, stamp.time)) return false;
+			FileStamp current = stampOf(m_Sources[i].path);
+			if (name != m_Sources[i].name || sourcePath != m_Sources[i].path
+				|| stamp.size != current.size || stamp.time != current.time) return false;
+			Placement& placement = placements[i];
+			if (!readValue(in, placement.page) || !readValue(in, placement.x) || !readValue(in, placement.y)
+				|| !readValue(in, placement.w) || !readValue(in, placement.h)) return false;
+		}
+
+		uint32_t pageCount;
+		if (!readValue(in, pageCount) || pageCount > 64) return false;
+		pages.resize(pageCount);
+		for (auto& page : pages) {
+			if (!readValue(in, page.width) || !readValue(in, page.height)) return false;
+			if (page.width <= 0 || page.width > m_PageSize || page.height <= 0 || page.height > m_PageSize) return false;
+			page.pixels.resize(static_cast<size_t>(page.width) * page.height * 4);
+			if (!in.read(reinterpret_cast<char*>(page.pixels.data()), page.pixels.size())) return false;
+		}
+		for (auto& placement : placements) {
+			if (placement.page >= static_cast<int>(pageCount)) return false;
+		}
+		return true;
+	}
+
+	void TextureAtlas::writeCache(const std::string& path, const std::vector<Placement>& placements, const std::vector<PageImage>& pages) const
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		if (!out) {
+			std::cout << "TextureAtlas: cannot write cache " << path << std::endl;
+			return;
+		}
+		out.write(CACHE_MAGIC, 4);
+		writeValue<uint32_t>(out, CACHE_VERSION);
+		writeValue<uint32_t>(out, m_PageSize);
+		writeValue<uint32_t>(out, m_Padding);
+		writeValue<uint32_t>(out, static_cast<uint32_t>(m_Filter));
+		writeValue<uint32_t>(out, static_cast<uint32_t>(m_Sources.size()));
+		for (size_t i = 0; i < m_Sources.size(); i++) {
+			FileStamp stamp = stampOf(m_Sources[i].path);
+			writeString(out, m_Sources[i].name);
+			writeString(out, m_Sources[i].path);
+			writeValue(out, stamp.size);
+			writeValue(out, stamp.time);
+			const Placement& placement = placements[i];
+			writeValue(out, placement.page);
+			writeValue(out, placement.x);
+			writeValue(out, placement.y);
+			writeValue(out, placement.w);
+			writeValue(out, placement.h);
+		}
+		writeValue<uint32_t>(out, static_cast<uint32_t>(pages.size()));
+		for (auto& page : pages) {
+			writeValue(out, page.width);
+			writeValue(out, page.height);
+			out.write(reinterpret_cast<const char*>(page.pixels.data()), page.pixels.size());
+		}
+	}
+}
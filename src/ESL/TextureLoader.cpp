@@ -0,0 +1,204 @@
+﻿#include"TextureLoader.hpp"
+#include"AssetPack.hpp"
+#include"JobSystem.hpp"
+#include"Profiler.hpp"
+#include"glad/glad.h"
+#include"stbImage/stb_image.h"
+#include<algorithm>
+#include<chrono>
+#include<limits>
+
+namespace esl
+{
+	namespace
+	{
+		// 每次 glTexSubImage2D 上传的字节数，大图分多段上传以遵守每帧预算
+		constexpr size_t BAND_BYTES = 512 * 1024;
+
+		enum class DecodeState { Decoding, Decoded, Failed };
+
+		struct Request
+		{
+			Texture* texture = nullptr;	// 纹理已销毁时为空
+			std::string path;
+			Texture::Wrap wrap = Texture::Wrap::REPEAT;
+			Texture::Filter filter = Texture::Filter::LINEAR;
+			int width = 0;
+			int height = 0;
+			const uchar* pixels = nullptr;
+			bool decoded = false;		// pixels 由 stbi 分配；否则指向资源包映射
+			std::atomic<DecodeState> state{ DecodeState::Decoding };
+			uint target = 0;			// 正在填充的新纹理对象
+			int uploadedRows = 0;
+		};
+
+		std::unique_ptr<JobSystem> s_Jobs;
+		JobCounter s_Decoding;
+		// 按请求顺序排列，只在上下文线程上访问
+		std::vector<std::unique_ptr<Request>> s_Requests;
+
+		void release(Request& request)
+		{
+			if (request.decoded) stbi_image_free(const_cast<uchar*>(request.pixels));
+			request.pixels = nullptr;
+			request.decoded = false;
+			if (request.target) glDeleteTextures(1, &request.target);
+			request.target = 0;
+		}
+
+		double elapsedMs(std::chrono::steady_clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+	}
+
+	void TextureLoader::start(unsigned workerCount)
+	{
+		if (s_Jobs) return;
+		s_Jobs = std::make_unique<JobSystem>(workerCount);
+	}
+
+	void TextureLoader::stop()
+	{
+		if (!s_Jobs) return;
+		s_Jobs->wait(s_Decoding);
+		for (auto& request : s_Requests) {
+			if (request->texture) request->texture->m_Loading = false;
+			release(*request);
+		}
+		s_Requests.clear();
+		s_Jobs.reset();
+	}
+
+	bool TextureLoader::active()
+	{
+		return s_Jobs != nullptr;
+	}
+
+	bool TextureLoader::request(Texture* texture, const std::string& path, Texture::Wrap wrap, Texture::Filter filter)
+	{
+		if (!s_Jobs) return false;
+		auto request = std::make_unique<Request>();
+		request->texture = texture;
+		request->path = path;
+		request->wrap = wrap;
+		request->filter = filter;
+
+		AssetPack::Image image;
+		if (AssetPack::findImage(path, image)) {
+			// 资源包中已是解码好的像素，只需排队上传
+			request->width = image.width;
+			request->height = image.height;
+			request->pixels = image.pixels;
+			request->state.store(DecodeState::Decoded, std::memory_order_relaxed);
+		}
+		else {
+			int channel;
+			if (!stbi_info(path.c_str(), &request->width, &request->height, &channel)) return false;
+			Request* pending = request.get();
+			s_Jobs->submit([pending]() {
+				ESL_PROFILE_ZONE("Decode texture");
+				stbi_set_flip_vertically_on_load_thread(true);
+				int width, height, channel;
+				uchar* pixels = stbi_load(pending->path.c_str(), &width, &height, &channel, 4);
+				// 文件在读取图片头之后被改动时按失败处理，纹理尺寸已经交给调用者
+				if (pixels && (width != pending->width || height != pending->height)) {
+					stbi_image_free(pixels);
+					pixels = nullptr;
+				}
+				pending->pixels = pixels;
+				pending->decoded = pixels != nullptr;
+				pending->state.store(pixels ? DecodeState::Decoded : DecodeState::Failed, std::memory_order_release);
+			}, &s_Decoding);
+		}
+
+		texture->m_Width = request->width;
+		texture->m_Height = request->height;
+		texture->m_Channel = 4;
+		texture->m_Loading = true;
+		// 调用者已绑定纹理，先放入透明的占位像素
+		static const uchar placeholder[4] = { 255, 255, 255, 0 };
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholder);
+		s_Requests.push_back(std::move(request));
+		return true;
+	}
+
+	void TextureLoader::cancel(Texture* texture)
+	{
+		for (auto& request : s_Requests) {
+			if (request->texture == texture) {
+				// 解码任务可能还在运行，留给 update 回收
+				request->texture = nullptr;
+				return;
+			}
+		}
+	}
+
+	void TextureLoader::update(double budgetMs)
+	{
+		if (s_Requests.empty()) return;
+		ESL_PROFILE_ZONE("Texture upload");
+		const auto start = std::chrono::steady_clock::now();
+		bool uploaded = false;
+		for (size_t i = 0; i < s_Requests.size();) {
+			Request& request = *s_Requests[i];
+			const DecodeState state = request.state.load(std::memory_order_acquire);
+			if (state == DecodeState::Decoding) {
+				i++;
+				continue;
+			}
+			if (!request.texture || state == DecodeState::Failed) {
+				if (request.texture) {
+					std::cout << "Failed to load texture:" << request.path << std::endl;
+					request.texture->m_Loading = false;
+				}
+				release(request);
+				s_Requests.erase(s_Requests.begin() + i);
+				continue;
+			}
+
+			glActiveTexture(GL_TEXTURE0);
+			const size_t rowBytes = static_cast<size_t>(request.width) * 4;
+			const int bandRows = static_cast<int>(std::max<size_t>(1, BAND_BYTES / rowBytes));
+			while (request.uploadedRows < request.height) {
+				if (uploaded && elapsedMs(start) >= budgetMs) return;
+				if (!request.target) {
+					glGenTextures(1, &request.target);
+					glBindTexture(GL_TEXTURE_2D, request.target);
+					Texture::setParameters(request.wrap, request.filter);
+					glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, request.width, request.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+				}
+				else {
+					glBindTexture(GL_TEXTURE_2D, request.target);
+				}
+				const int rows = std::min(bandRows, request.height - request.uploadedRows);
+				glTexSubImage2D(GL_TEXTURE_2D, 0, 0, request.uploadedRows, request.width, rows, GL_RGBA, GL_UNSIGNED_BYTE,
+					request.pixels + request.uploadedRows * rowBytes);
+				request.uploadedRows += rows;
+				uploaded = true;
+			}
+
+			// 上传完毕，替换占位纹理
+			Texture* texture = request.texture;
+			glDeleteTextures(1, &texture->m_Texture);
+			texture->m_Texture = request.target;
+			texture->m_Loading = false;
+			request.target = 0;
+			release(request);
+			s_Requests.erase(s_Requests.begin() + i);
+		}
+	}
+
+	void TextureLoader::finish()
+	{
+		if (!s_Jobs) return;
+		s_Jobs->wait(s_Decoding);
+		update(std::numeric_limits<double>::infinity());
+	}
+
+	size_t TextureLoader::pending()
+	{
+		return static_cast<size_t>(std::count_if(s_Requests.begin(), s_Requests.end(),
+			[](const std::unique_ptr<Request>& request) { return request->texture != nullptr; }));
+	}
+}
@@ -8,6 +8,10 @@
 #include "Text.hpp"
 #include "ModernText.hpp" 
 #include "Shape.hpp"
+#include "SpriteBatch.hpp"
+#include "NullGL.hpp"
+#include "GpuProfiler.hpp"
+#include "ESL.hpp"
 #include <chrono>
 #include <thread>
 #include <vector>
@@ -16,7 +20,7 @@ namespace esl
 {
 
 	Window::Window(unsigned int width, unsigned int height, const char* title, bool visiable, bool resizeable)
-		: m_BackgroundColor(0.0f, 0.0f, 0.0f, 1.0f)  // ʼɫΪɫ
+		: m_BackgroundColor(0.0f, 0.0f, 0.0f, 1.0f)  // 初始化背景颜色为黑色
 	{
 		glfwWindowHint(GLFW_VISIBLE, visiable);
 		glfwWindowHint(GLFW_RESIZABLE, resizeable);
@@ -26,11 +30,20 @@ namespace esl
 			std::cout << "Failed to create GLFW window" << std::endl;
 			glfwTerminate();
 		}
-		glfwMakeContextCurrent(m_Window);
 		glfwSetWindowUserPointer(m_Window, this);
-		if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+		if (IsHeadless())
 		{
-			std::cout << "Failed to initialize GLAD" << std::endl;
+			// 没有上下文，所有 gl* 调用进入空实现
+			m_Headless = true;
+			NullGL::load();
+		}
+		else
+		{
+			glfwMakeContextCurrent(m_Window);
+			if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+			{
+				std::cout << "Failed to initialize GLAD" << std::endl;
+			}
 		}
 		glViewport(0, 0, width, height);
 		glfwSetWindowSizeCallback(
@@ -52,6 +65,7 @@ namespace esl
 	}
 	Window::~Window()
 	{
+		GpuProfiler::release();
 		glfwDestroyWindow(this->m_Window);
 	}
 	bool Window::isOpen()
@@ -60,6 +74,13 @@ namespace esl
 	}
 	void Window::display()
 	{
+		if (m_Headless)
+		{
+			// 无窗口模式不限帧、不交换缓冲
+			GpuProfiler::frame();
+			glfwPollEvents();
+			return;
+		}
 		if (!m_Vsync)
 		{
 			double elapsed = glfwGetTime() - m_LastFrameTime;
@@ -70,12 +91,14 @@ namespace esl
 			}
 		}
 		glfwSwapBuffers(m_Window);
+		// 一帧的绘制命令已全部提交，轮换 GPU 计时查询
+		GpuProfiler::frame();
 		glfwPollEvents();
 		m_LastFrameTime = glfwGetTime();
 	}
 	void Window::clear()
 	{
-		glfwMakeContextCurrent(m_Window);
+		if (!m_Headless) glfwMakeContextCurrent(m_Window);
 		glClearColor(m_BackgroundColor.r, m_BackgroundColor.g, m_BackgroundColor.b, m_BackgroundColor.a);
 		glClear(GL_COLOR_BUFFER_BIT);
 	}
@@ -150,7 +173,7 @@ namespace esl
 	void Window::setVSync(bool value)
 	{
 		m_Vsync = value;
-		glfwSwapInterval(value);
+		if (!m_Headless) glfwSwapInterval(value);
 		if (value)
 		{
 			m_Framerate = 0;
@@ -172,11 +195,11 @@ namespace esl
 	{
 		int width, height;
 		glfwGetWindowSize(m_Window, &width, &height);
-		// 鴰ǷС
+		// 检查窗口是否被最小化
 		if (glfwGetWindowAttrib(m_Window, GLFW_ICONIFIED))
 			return;
 
-		// 飺ȷڳߴЧ
+		// 额外检查：确保窗口尺寸有效
 		if (width <= 0 || height <= 0)
 			return;
 		renderObject.draw(static_cast<float>(width), static_cast<float>(height));
@@ -186,10 +209,10 @@ namespace esl
 	{
 		int width, height;
 		glfwGetWindowSize(m_Window, &width, &height);
-		// 鴰ǷС
+		// 检查窗口是否被最小化
 		if (glfwGetWindowAttrib(m_Window, GLFW_ICONIFIED))
 			return;
-		// 飺ȷڳߴЧ
+		// 额外检查：确保窗口尺寸有效
 		if (width <= 0 || height <= 0)
 			return;
 		for (auto& e : text.m_SpriteVector)
@@ -199,6 +222,32 @@ namespace esl
 	}
 
 
+	void Window::draw(SpriteBatch& batch)
+	{
+		batch.setInterpolation(getInterpolationAlpha());
+		this->draw(static_cast<Renderable&>(batch));
+	}
+
+	void Window::setInterpolation(bool enable)
+	{
+		m_Interpolation = enable;
+	}
+
+	bool Window::getInterpolation() const
+	{
+		return m_Interpolation;
+	}
+
+	void Window::setInterpolationAlpha(float alpha)
+	{
+		m_InterpolationAlpha = glm::clamp(alpha, 0.0f, 1.0f);
+	}
+
+	float Window::getInterpolationAlpha() const
+	{
+		return m_Interpolation ? m_InterpolationAlpha : 1.0f;
+	}
+
 	void Window::KeyEventCallback(GLFWwindow* window, int key, int scancode, int action, int modes)
 	{
 		Window* instance = static_cast<Window*>(glfwGetWindowUserPointer(window));
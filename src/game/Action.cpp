@@ -1,6 +1,6 @@
 ﻿#include <Action.h>
 #include <Enemy.h>
-#include <BulletPool.h>  // 添加 BulletPool 头文件
+#include <BulletWorld.h>
 
 
 MovementAction::MovementAction(std::function<glm::vec2(double)> func, double duration):mTrajectoryFunc(func), mDuration(duration), mElapsedTime(0)
@@ -113,142 +113,60 @@ void DanmakuAction::apply(Enemy* enemy) {
     mLastShootTime = mElapsedTime;
 }
 
-void DanmakuAction::shootLinear(Enemy* enemy, glm::vec2 startPos) {
-    // 如果设置了发射半径，从圆周上发射
-    if (mShootRadius > 0) {
-        float radians = glm::radians(mBulletConfig.baseAngle);
-        startPos += glm::vec2(
-            mShootRadius * cos(radians),
-            mShootRadius * sin(radians)
-        );
-    }
-    auto bullet = BulletPoolHelper::getBullet(
-        mBulletConfig.type,
-        mBulletConfig.color,
-        startPos,
-        *mRenderer,
-        mBulletConfig.baseAngle,
-        mBulletConfig.baseSpeed
-    );
-
-    bullet->setRotation(mBulletConfig.baseAngle - 90);
+void DanmakuAction::emit(Enemy* enemy, PatternDesc pattern, int count) {
+    if (count <= 0) return;
+    pattern.style = Bullet::styleOf(mBulletConfig.type, mBulletConfig.color);
+    pattern.radius = Bullet::style(pattern.style).radius;
+    pattern.flags = mSyncRotationWithDirection ? BulletWorld::FLAG_SYNC_ROTATION : 0;
+    pattern.owner = enemy;
 
-    // 设置旋转同步标志
-    if (auto bullet1 = dynamic_cast<Bullet_1*>(bullet.get())) {
-        bullet1->mSyncRotation = mSyncRotationWithDirection;
+    // 运动用所有子弹共享的程序表示，不再为每颗子弹创建 Action
+    if (!mBulletProgram.empty()) {
+        pattern.program = mBulletWorld->registerProgram(mBulletProgram);
     }
-
-    // 应用运动参数（如果有加速度）
-    if (mBulletAcceleration != 0.0f) {
-        if (auto bullet1 = dynamic_cast<Bullet_1*>(bullet.get())) {
-            if (mBulletNeverStop) {
-                bullet1->addMovementAction(
-                    BulletLinearMovement()
-                        .direction(mBulletConfig.baseAngle)
-                        .speed(mBulletConfig.baseSpeed)
-                        .accelerate(mBulletAcceleration)
-                        .accelerateDuring(mAccelerationDuration)  // 设置加速时间
-                        .neverStop()
-                        .buildBullet()
-                );
-            } else {
-                bullet1->addMovementAction(
-                    BulletLinearMovement()
-                        .direction(mBulletConfig.baseAngle)
-                        .speed(mBulletConfig.baseSpeed)
-                        .accelerate(mBulletAcceleration)
-                        .accelerateDuring(mAccelerationDuration)  // 设置加速时间
-                        .stopAfter(mBulletMoveDuration)
-                        .buildBullet()
-                );
-            }
-        }
+    else if (mBulletAcceleration != 0.0f && mAccelerationDuration >= 0) {
+        // 加速 mAccelerationDuration 秒（不超过 mBulletMoveDuration），之后匀速
+        float seconds = static_cast<float>(mAccelerationDuration);
+        if (!mBulletNeverStop) seconds = std::min(seconds, static_cast<float>(mBulletMoveDuration));
+        pattern.program = mBulletWorld->registerProgram(BulletProgram().accelerate(mBulletAcceleration, seconds));
     }
-    // 如果有自定义运动配置，应用它
-    else if (!mMovementBuilders.empty()) {
-        if (auto bullet1 = dynamic_cast<Bullet_1*>(bullet.get())) {
+
+    size_t first = mBulletWorld->spawnBatch(pattern, static_cast<uint32_t>(count));
+
+    // 如果有自定义运动配置，逐颗应用它
+    if (pattern.program == 0 && mBulletAcceleration == 0.0f && !mMovementBuilders.empty()) {
+        for (int i = 0; i < count; i++) {
+            BulletHandle bullet = mBulletWorld->handleOf(first + i);
             for (const auto& builder : mMovementBuilders) {
                 if (builder) {
-                    bullet1->addMovementAction(builder());
+                    mBulletWorld->addMovementAction(bullet, builder());
                 }
             }
         }
     }
+}
 
-    enemy->mBullets.push_back(std::move(bullet));
+void DanmakuAction::shootLinear(Enemy* enemy, glm::vec2 startPos) {
+    PatternDesc pattern;
+    pattern.origin = startPos;
+    pattern.baseAngle = mBulletConfig.baseAngle;
+    pattern.speed = mBulletConfig.baseSpeed;
+    // 如果设置了发射半径，从圆周上发射
+    pattern.spawnRadius = mShootRadius;
+    emit(enemy, pattern, 1);
 }
 
 void DanmakuAction::shootCircle(Enemy* enemy, glm::vec2 startPos) {
-    float angleStep = mAngleStep > 0 ? mAngleStep : (360.0f / mBulletCount);
-
-    for (int i = 0; i < mBulletCount; i++) {
-        float angle = mBulletConfig.baseAngle + angleStep * i;
-        float speed = mBulletConfig.baseSpeed + mSpeedVariation * (i - mBulletCount / 2.0f);
-
-        // 计算发射位置：从圆周上发射
-        glm::vec2 shootPosForBullet = startPos;
-        if (mShootRadius > 0) {
-            float radians = glm::radians(angle);
-            shootPosForBullet += glm::vec2(
-                mShootRadius * cos(radians),
-                mShootRadius * sin(radians)
-            );
-        }
-        auto bullet = BulletPoolHelper::getBullet(
-            mBulletConfig.type,
-            mBulletConfig.color,
-            shootPosForBullet,
-            *mRenderer,
-            angle,
-            speed
-        );
-
-        bullet->setRotation(angle - 90);
-
-        // 设置旋转同步标志
-        if (auto bullet1 = dynamic_cast<Bullet_1*>(bullet.get())) {
-            bullet1->mSyncRotation = mSyncRotationWithDirection;
-        }
-
-        // 应用运动参数（如果有加速度）
-        if (mBulletAcceleration != 0.0f) {
-            if (auto bullet1 = dynamic_cast<Bullet_1*>(bullet.get())) {
-                if (mBulletNeverStop) {
-                    bullet1->addMovementAction(
-                        BulletLinearMovement()
-                            .direction(angle)
-                            .speed(speed)
-                            .accelerate(mBulletAcceleration)
-                            .accelerateDuring(mAccelerationDuration)
-                            .neverStop()
-                            .buildBullet()
-                    );
-                } else {
-                    bullet1->addMovementAction(
-                        BulletLinearMovement()
-                            .direction(angle)
-                            .speed(speed)
-                            .accelerate(mBulletAcceleration)
-                            .accelerateDuring(mAccelerationDuration)
-                            .stopAfter(mBulletMoveDuration)
-                            .buildBullet()
-                    );
-                }
-            }
-        }
-        // 如果有自定义运动配置，应用它
-        else if (!mMovementBuilders.empty()) {
-            if (auto bullet1 = dynamic_cast<Bullet_1*>(bullet.get())) {
-                for (const auto& builder : mMovementBuilders) {
-                    if (builder) {
-                        bullet1->addMovementAction(builder());
-                    }
-                }
-            }
-        }
-
-        enemy->mBullets.push_back(std::move(bullet));
-    }
+    PatternDesc pattern;
+    pattern.origin = startPos;
+    pattern.baseAngle = mBulletConfig.baseAngle;
+    pattern.angleStep = mAngleStep > 0 ? mAngleStep : (360.0f / mBulletCount);
+    // 第 i 颗的速度为 baseSpeed + mSpeedVariation * (i - mBulletCount / 2)
+    pattern.speed = mBulletConfig.baseSpeed - mSpeedVariation * (mBulletCount / 2.0f);
+    pattern.speedStep = mSpeedVariation;
+    // 从圆周上发射
+    pattern.spawnRadius = mShootRadius;
+    emit(enemy, pattern, mBulletCount);
 }
 
 void DanmakuAction::shootFan(Enemy* enemy, glm::vec2 startPos) {
@@ -258,156 +176,27 @@ void DanmakuAction::shootFan(Enemy* enemy, glm::vec2 startPos) {
     }
 
     float totalAngle = mAngleStep * (mBulletCount - 1);
-    float startAngle = mBulletConfig.baseAngle - totalAngle / 2.0f;
-
-    for (int i = 0; i < mBulletCount; i++) {
-        float angle = startAngle + mAngleStep * i;
-        float speed = mBulletConfig.baseSpeed + mSpeedVariation * (i - mBulletCount / 2.0f);
-        // 计算发射位置：从圆周上发射
-        glm::vec2 shootPosForBullet = startPos;
-        if (mShootRadius > 0) {
-            // 选项 1：所有子弹从同一个位置发射（扇形中心方向）
-            if (!mAlignToRadius) {
-                float radians = glm::radians(mBulletConfig.baseAngle);
-                shootPosForBullet += glm::vec2(
-                    mShootRadius * cos(radians),
-                    mShootRadius * sin(radians)
-                );
-            }
-            // 选项 2：每个子弹从对应角度的圆周位置发射
-            else {
-                float radians = glm::radians(angle);
-                shootPosForBullet += glm::vec2(
-                    mShootRadius * cos(radians),
-                    mShootRadius * sin(radians)
-                );
-            }
-        }
-        auto bullet = BulletPoolHelper::getBullet(
-            mBulletConfig.type,
-            mBulletConfig.color,
-            shootPosForBullet,
-            *mRenderer,
-            angle,
-            speed
-        );
-
-        bullet->setRotation(angle - 90);
-
-        // 设置旋转同步标志
-        if (auto bullet1 = dynamic_cast<Bullet_1*>(bullet.get())) {
-            bullet1->mSyncRotation = mSyncRotationWithDirection;
-        }
-
-        // 应用运动参数（如果有加速度）
-        if (mBulletAcceleration != 0.0f) {
-            if (auto bullet1 = dynamic_cast<Bullet_1*>(bullet.get())) {
-                if (mBulletNeverStop) {
-                    bullet1->addMovementAction(
-                        BulletLinearMovement()
-                            .direction(angle)
-                            .speed(speed)
-                            .accelerate(mBulletAcceleration)
-                            .accelerateDuring(mAccelerationDuration)
-                            .neverStop()
-                            .buildBullet()
-                    );
-                } else {
-                    bullet1->addMovementAction(
-                        BulletLinearMovement()
-                            .direction(angle)
-                            .speed(speed)
-                            .accelerate(mBulletAcceleration)
-                            .accelerateDuring(mAccelerationDuration)
-                            .stopAfter(mBulletMoveDuration)
-                            .buildBullet()
-                    );
-                }
-            }
-        }
-        // 如果有自定义运动配置，应用它
-        else if (!mMovementBuilders.empty()) {
-            if (auto bullet1 = dynamic_cast<Bullet_1*>(bullet.get())) {
-                for (const auto& builder : mMovementBuilders) {
-                    if (builder) {
-                        bullet1->addMovementAction(builder());
-                    }
-                }
-            }
-        }
-
-        enemy->mBullets.push_back(std::move(bullet));
-    }
+    PatternDesc pattern;
+    pattern.origin = startPos;
+    pattern.baseAngle = mBulletConfig.baseAngle - totalAngle / 2.0f;
+    pattern.angleStep = mAngleStep;
+    pattern.speed = mBulletConfig.baseSpeed - mSpeedVariation * (mBulletCount / 2.0f);
+    pattern.speedStep = mSpeedVariation;
+    pattern.spawnRadius = mShootRadius;
+    // 选项 1：所有子弹从同一个位置发射（扇形中心方向）
+    // 选项 2：每个子弹从对应角度的圆周位置发射
+    pattern.radialSpawn = mAlignToRadius;
+    pattern.spawnAngle = mBulletConfig.baseAngle;
+    emit(enemy, pattern, mBulletCount);
 }
 
 void DanmakuAction::shootSpiral(Enemy* enemy, glm::vec2 startPos) {
     // 螺旋模式：baseAngle 已经包含了每轮的增量
-    float baseAngle = mBulletConfig.baseAngle;
-
-    for (int i = 0; i < mBulletCount; i++) {
-        float angle = baseAngle + (360.0f / mBulletCount) * i;
-        // 计算发射位置：从圆周上发射
-        glm::vec2 shootPosForBullet = startPos;
-        if (mShootRadius > 0) {
-            float radians = glm::radians(angle);
-            shootPosForBullet += glm::vec2(
-                mShootRadius * cos(radians),
-                mShootRadius * sin(radians)
-            );
-        }
-        auto bullet = BulletPoolHelper::getBullet(
-            mBulletConfig.type,
-            mBulletConfig.color,
-            shootPosForBullet,
-            *mRenderer,
-            angle,
-            mBulletConfig.baseSpeed
-        );
-
-        bullet->setRotation(angle - 90);
-
-        // 设置旋转同步标志
-        if (auto bullet1 = dynamic_cast<Bullet_1*>(bullet.get())) {
-            bullet1->mSyncRotation = mSyncRotationWithDirection;
-        }
-
-        // 应用运动参数（如果有加速度）
-        if (mBulletAcceleration != 0.0f) {
-            if (auto bullet1 = dynamic_cast<Bullet_1*>(bullet.get())) {
-                // 直接构建并传递，不使用中间变量（避免拷贝）
-                if (mBulletNeverStop) {
-                    bullet1->addMovementAction(
-                        BulletLinearMovement()
-                            .direction(angle)
-                            .speed(mBulletConfig.baseSpeed)
-                            .accelerate(mBulletAcceleration)
-                            .accelerateDuring(mAccelerationDuration)
-                            .neverStop()
-                            .buildBullet()
-                    );
-                } else {
-                    bullet1->addMovementAction(
-                        BulletLinearMovement()
-                            .direction(angle)
-                            .speed(mBulletConfig.baseSpeed)
-                            .accelerate(mBulletAcceleration)
-                            .accelerateDuring(mAccelerationDuration)
-                            .stopAfter(mBulletMoveDuration)
-                            .buildBullet()
-                    );
-                }
-            }
-        }
-        else if (!mMovementBuilders.empty()) {
-            if (auto bullet1 = dynamic_cast<Bullet_1*>(bullet.get())) {
-                for (const auto& builder : mMovementBuilders) {
-                    if (builder) {
-                        bullet1->addMovementAction(builder());
-                    }
-                }
-            }
-        }
-
-        enemy->mBullets.push_back(std::move(bullet));
-    }
-}
\ No newline at end of file
+    PatternDesc pattern;
+    pattern.origin = startPos;
+    pattern.baseAngle = mBulletConfig.baseAngle;
+    pattern.angleStep = 360.0f / mBulletCount;
+    pattern.speed = mBulletConfig.baseSpeed;
+    pattern.spawnRadius = mShootRadius;
+    emit(enemy, pattern, mBulletCount);
+}
@@ -1,4 +1,5 @@
 #include <Background3D.h>
+#include <ResourceCache.hpp>
 
 esl::Window* Background3D::mRenderer = nullptr;
 std::string const Background3D::mTexturePath = "Assets/background/";
@@ -26,9 +27,9 @@ void Background3D::update(double deltaTime)
 Stage01_Background::Stage01_Background()
 {
 	std::string texture_path = mTexturePath + "stage01/";
-	mBaseTexture = std::make_unique<esl::Texture>(texture_path + "st01a.png");
-	mCloudTexture = std::make_unique<esl::Texture>(texture_path + "stg4bg2.png");
-	mSkyTexture = std::make_unique<esl::Texture>(texture_path + "A007.png");
+	mBaseTexture = esl::TextureCache::get(texture_path + "st01a.png");
+	mCloudTexture = esl::TextureCache::get(texture_path + "stg4bg2.png");
+	mSkyTexture = esl::TextureCache::get(texture_path + "A007.png");
 	mBaseSprite = std::make_unique<esl::Sprite3D>(mBaseTexture.get());
 	mCloudSprite = std::make_unique<esl::Sprite3D>(mCloudTexture.get());
 	mSkySprite = std::make_unique<esl::Sprite>(mSkyTexture.get());
@@ -2,71 +2,74 @@
 #include <Player.h>
 #include <cmath>
 #include "Action.h"
-
-Bullet::~Bullet() = default;
+#include "BulletRenderThread.h"
 
 std::string bullet_texture_path = ".\\Assets\\bullet\\";
 
-pTexture Bullet::etbreakTexture = nullptr;
 pSprite Bullet::etbreakSprite = nullptr;
 const glm::vec2 Bullet::etbreakFrames[8] = {
 		{0,64}, {64,64}, {128,64}, { 192,64 }, {0,0}, {64,0}, {128,0},{192,0}
 };
 std::vector<Bullet::EtBreakEffect> Bullet::etbreaks;
-pTexture Bullet_1::sTexture[6];
-// ̬ӵԣײ뾶
-void Bullet_1::setupBulletProperties(
-	esl::Sprite* sprite,
-	double& collisionRadius,
-	int type,
-	int color
-) {
+std::unique_ptr<esl::TextureAtlas> Bullet::sAtlas;
+std::vector<BulletStyle> Bullet::sStyles;
+std::unique_ptr<esl::SpriteBatch> Bullet::sBatch;
+// 静态辅助函数：根据 type/color 设置纹理坐标和碰撞半径
+void Bullet::setupBulletProperties(BulletStyle& style) {
+	const int type = style.type;
+	const int color = style.color;
 	glm::vec2 size = { 0,0 };
 	glm::vec2 start_pos = { 0,0 };
+	glm::vec2 rect = { 0,0 };
+	float radius = 2.4f;
+
+	// 根据 type 选择图集中的源图片
+	const esl::TextureRegion& region = selectRegion(type);
+	style.texture = region.texture;
+	if (!style.texture) {
+		return;
+	}
 
-	//  type ѡ
-	sprite->setTexture(selectTexture(type));
-
-	// ײ뾶
+	// 设置纹理坐标和碰撞半径
 	switch (type) {
 	case 1:
 	{
 		start_pos = { 0,0 };
 		size = { 8,8 };
-		sprite->setTextureRect(start_pos + glm::vec2{ 8 * (color % 8), (color / 8) * 8 }, size);
-		collisionRadius = 2.4;
+		rect = start_pos + glm::vec2{ 8 * (color % 8), (color / 8) * 8 };
+		radius = 2.4;
 	}
 		break;
 	case 2:
 	{
 		start_pos = { 64,0 };
 		size = { 16,16 };
-		sprite->setTextureRect(start_pos + glm::vec2{ color * 16,0 }, size);
-		collisionRadius = 4;
+		rect = start_pos + glm::vec2{ color * 16,0 };
+		radius = 4;
 		break;
 	}
 	case 3:
 	{
 		start_pos = { 0,16 };
 		size = { 32,32 };
-		sprite->setTextureRect(start_pos + glm::vec2{ color * 32,0 }, size);
-		collisionRadius = 12;
+		rect = start_pos + glm::vec2{ color * 32,0 };
+		radius = 12;
 		break;
 	}
 	case 4:
 	{
 		start_pos = { 0,32 };
 		size = { 8,8 };
-		sprite->setTextureRect(start_pos + glm::vec2{ 8 * (color % 8), (color / 8) * 8 }, size);
-		collisionRadius = 2.4;
+		rect = start_pos + glm::vec2{ 8 * (color % 8), (color / 8) * 8 };
+		radius = 2.4;
 		break;
 	}
 	case 5:
 	{
 		start_pos = { 64,32 };
 		size = { 8,8 };
-		sprite->setTextureRect(start_pos + glm::vec2{ 8 * (color % 8), (color / 8) * 8 }, size);
-		collisionRadius = 2;
+		rect = start_pos + glm::vec2{ 8 * (color % 8), (color / 8) * 8 };
+		radius = 2;
 		break;
 	}
 	case 6:
@@ -76,26 +79,26 @@ void Bullet_1::setupBulletProperties(
 	case 12:
 	case 16:
 	{
-		collisionRadius = 2.4;
+		radius = 2.4;
 		start_pos = { 0,64 + 16 * (type - 6) };
 		size = { 16,16 };
-		sprite->setTextureRect(start_pos + glm::vec2{ color * 16, 0 }, size);
+		rect = start_pos + glm::vec2{ color * 16, 0 };
 		break;
 	}
 	case 10:
 	{
-		collisionRadius = 2.8;
+		radius = 2.8;
 		start_pos = { 0,64 + 16 * (type - 6) };
 		size = { 16,16 };
-		sprite->setTextureRect(start_pos + glm::vec2{ color * 16, 0 }, size);
+		rect = start_pos + glm::vec2{ color * 16, 0 };
 		break;
 	}
 	case 13:
 	{
-		collisionRadius = 3.2;
+		radius = 3.2;
 		start_pos = { 0,64 + 16 * (type - 6) };
 		size = { 16,16 };
-		sprite->setTextureRect(start_pos + glm::vec2{ color * 16, 0 }, size);
+		rect = start_pos + glm::vec2{ color * 16, 0 };
 		break;
 	}
 	case 7:
@@ -105,24 +108,24 @@ void Bullet_1::setupBulletProperties(
 	{
 		start_pos = { 0,64 + 16 * (type - 6) };
 		size = { 16,16 };
-		sprite->setTextureRect(start_pos + glm::vec2{ color * 16, 0 }, size);
-		collisionRadius = 4;
+		rect = start_pos + glm::vec2{ color * 16, 0 };
+		radius = 4;
 		break;
 	}
 	case 18:
 	{
 		start_pos = { 13 * 16,3 * 16 };
 		size = { 16,16 };
-		sprite->setTextureRect(start_pos + glm::vec2{ color * 16, 0 }, size);
-		collisionRadius = 4;
+		rect = start_pos + glm::vec2{ color * 16, 0 };
+		radius = 4;
 		break;
 	}
 	case 19:
 	{
 		start_pos = { 0,0 };
 		size = { 64,64 };
-		sprite->setTextureRect(start_pos + glm::vec2{ color * 64, 0 }, size);
-		collisionRadius = 14;
+		rect = start_pos + glm::vec2{ color * 64, 0 };
+		radius = 14;
 		break;
 	}
 	case 20:
@@ -134,133 +137,114 @@ void Bullet_1::setupBulletProperties(
 	{
 		start_pos = { 0,64 + (type - 20) * 32 };
 		size = { 32,32 };
-		sprite->setTextureRect(start_pos + glm::vec2{ color * 32, 0 }, size);
-		collisionRadius = 7;
+		rect = start_pos + glm::vec2{ color * 32, 0 };
+		radius = 7;
 		break;
 	}
 	case 26:
+		// 整张纹理
+		rect = { 0,0 };
+		size = region.size;
+		radius = 10;
 		break;
 	default:
-		collisionRadius = 2.4;
+		radius = 2.4;
 		break;
 	}
+	style.rectPos = rect;
+	style.rectSize = size;
+	glm::vec2 textureSize = { style.texture->getSize().w, style.texture->getSize().h };
+	glm::vec2 atlasPos = region.offset + rect;
+	style.uvRect = { atlasPos / textureSize, (atlasPos + size) / textureSize };
+	// 子弹以 2 倍大小绘制，判定半径同步放大
+	style.radius = radius * 2;
 }
-esl::Texture* Bullet_1::selectTexture(int type) {
-	if (type <= 18) return sTexture[0].get();
-	if (type <= 25) return sTexture[1].get();
-	if (type <= 31) return sTexture[2].get();
-	if (type == 32) return sTexture[3].get();
-	if (type <= 36) return sTexture[4].get();
-	if (type <= 38) return sTexture[5].get();
-	return sTexture[0].get();  // Ĭ
+const esl::TextureRegion& Bullet::selectRegion(int type) {
+	if (type <= 18) return sAtlas->region("bullet1");
+	if (type <= 25) return sAtlas->region("bullet2");
+	if (type <= 31) return sAtlas->region("bullet3");
+	if (type == 32) return sAtlas->region("bullet4");
+	if (type <= 36) return sAtlas->region("bullet5");
+	if (type <= 38) return sAtlas->region("bullet6");
+	return sAtlas->region("bullet1");  // 默认
 }
-void Bullet_1::init() {
-	if (!sTexture[0]) {
+void Bullet::init() {
+	if (!sAtlas) {
+		sAtlas = std::make_unique<esl::TextureAtlas>();
 		for (int i = 0; i < 6; i++) {
 			char index = '1' + i;
-			sTexture[i] = std::make_unique<esl::Texture>(bullet_texture_path + "bullet" + index + ".png");
+			sAtlas->add(std::string("bullet") + index, bullet_texture_path + "bullet" + index + ".png");
 		}
+		sAtlas->add("etbreak", "./Assets/effect/etbreak.png");
+		sAtlas->build(bullet_texture_path + "atlas.cache");
 	}
-}
-
-Bullet_1::Bullet_1(int type, int color, glm::vec2 pos, esl::Window& render, float angle, float speed):mRenderer(render), mAngle(angle), mSpeed(speed)
-{
-	static bool firstTime = true;
-	if (firstTime) {
-		firstTime = false;
-		//printf("[Bullet_1] Object size: %zu bytes\n", sizeof(Bullet_1));
-		//printf("[Bullet_1] Sprite size: %zu bytes\n", sizeof(esl::Sprite));
-		//printf("[Bullet_1] Expected 5000 bullets memory: %.2f MB\n",sizeof(Bullet_1) * 5000 / 1024.0 / 1024.0);
+	if (!sBatch) {
+		sBatch = std::make_unique<esl::SpriteBatch>(3000);
 	}
-	// 飨ʹʱ setupBulletProperties ȷã
-	mSprite = std::make_unique<esl::Sprite>(sTexture[0].get());
-
-	// ù
-	setupBulletProperties(mSprite.get(), mCollisionRadius, type, color);
-
-	// λú
-	mSprite->setPosition(pos);
-	mSprite->setScale({ 2,2 });
-	mCollisionRadius *= 2;
-	//mSprite->setBorderVisiable(true);
 }
 
-void Bullet_1::renderBatch(
-	esl::Window& renderer,
-	const std::vector<pBullet>& bullets)
+uint16_t Bullet::styleOf(int type, int color)
 {
-	// Ż飬л
-	static thread_local std::unordered_map<esl::Texture*, std::vector<Bullet_1*>> batches;
-	batches.clear();
-
-	// Ԥռ
-	for (auto& [_, vec] : batches) {
-		vec.reserve(bullets.size() / 6);  // ƽֲ
-	}
-
-	// 
-	for (const auto& bullet : bullets) {
-		if (!bullet) continue;
-
-		auto* bullet1 = dynamic_cast<Bullet_1*>(bullet.get());
-		if (!bullet1 || !bullet1->mSprite) continue;
-
-		esl::Texture* tex = bullet1->mSprite->getTexture();
-		if (tex) {
-			batches[tex].push_back(bullet1);
+	// 外观种类很少，线性查找即可
+	for (size_t i = 0; i < sStyles.size(); i++) {
+		if (sStyles[i].type == type && sStyles[i].color == color) {
+			return static_cast<uint16_t>(i);
 		}
 	}
 
-	// ƣл
-	for (auto& [texture, group] : batches) {
-		// Ż
-		for (auto* bullet : group) {
-			renderer.draw(*bullet->mSprite);
-		}
-	}
+	BulletStyle style;
+	style.type = type;
+	style.color = color;
+	setupBulletProperties(style);
+
+	sStyles.push_back(style);
+	return static_cast<uint16_t>(sStyles.size() - 1);
 }
-void Bullet_1::update(double delta)
-{
-	lastGrazeTime += delta;
-	// ˶Actionϵͳ
-	updateMovementActions(delta);
 
-	// ûActionʹûƶ
-	if (mMovementActions.empty()) {
-		glm::vec2 velocity = {
-			mSpeed * cos(glm::radians(mAngle)) * static_cast<float>(delta),
-			mSpeed * sin(glm::radians(mAngle)) * static_cast<float>(delta)
-		};
-		mSprite->setPosition(mSprite->getPosition() + velocity);
+void Bullet::capture(const BulletWorld& world, BulletSnapshot& snapshot)
+{
+	// 外观表只会追加，补上这个快照还没有的部分即可
+	for (size_t id = snapshot.styles.size(); id < sStyles.size(); id++) {
+		const BulletStyle& s = sStyles[id];
+		BulletSnapshot::Style style;
+		style.texture = s.texture;
+		style.scale = s.rectSize * 2.0f;  // 子弹以 2 倍大小绘制
+		style.uvRect = s.uvRect;
+		snapshot.styles.push_back(style);
 	}
-
-	// תͬ¾תǶ
-	if (mSyncRotation) {
-		mSprite->setRotation(mAngle - 90);  // -90 ΪͼƬĬϳ
+	snapshot.bullets.clear();
+	const size_t count = world.size();
+	for (size_t i = 0; i < count; i++) {
+		if (world.released(i)) continue;
+		BulletSnapshot::Entry entry;
+		entry.x = world.mX[i];
+		entry.y = world.mY[i];
+		// 上一逻辑步中的位移，用于插值绘制
+		entry.dx = world.mX[i] - world.mPrevX[i];
+		entry.dy = world.mY[i] - world.mPrevY[i];
+		entry.rotation = world.mRotation[i];
+		entry.style = world.mStyle[i];
+		snapshot.bullets.push_back(entry);
 	}
 }
 
-void Bullet_1::render()
+void Bullet::render(esl::Window& renderer, const BulletDrawList& list)
 {
-	mRenderer.draw(*mSprite);
+	// 实例数据已由渲染线程按纹理分好组，这里只做拷贝和实例化绘制
+	sBatch->begin();
+	for (const BulletDrawList::Group& group : list.groups) {
+		sBatch->add(group.texture, group.instances.data(), group.instances.size());
+	}
+	renderer.draw(*sBatch);
 }
 
-void Bullet_1::updateMovementActions(double deltaTime)
+size_t Bullet::clearWithEffect(BulletWorld& world, const BulletOwner* owner)
 {
-	// ˶Action
-	for (auto it = mMovementActions.begin(); it != mMovementActions.end();) {
-		// ӦActionЧȷʼ
-		(*it)->apply(this);
-
-		// Ȼ״̬
-		if ((*it)->update(deltaTime)) {
-			// ActionɣƳ
-			it = mMovementActions.erase(it);
-		} else {
-			// ִֻеһAction
-			break;
-		}
-	}
+	return world.releaseIf([&](size_t i) {
+		if (owner && world.mOwner[i] != owner) return false;
+		createEtBreakEffect(world.position(i));
+		return true;
+	});
 }
 
 void Bullet::createEtBreakEffect(glm::vec2 pos)
@@ -276,7 +260,7 @@ void Bullet::updateEtBreaks(double deltaTime)
 {
 	for (auto it = etbreaks.begin(); it != etbreaks.end();) {
 		it->lifetime += deltaTime;
-		// ÿ0.1лһ֡
+		// 每0.1秒切换一帧
 		size_t frameIndex = static_cast<size_t>(it->lifetime / 0.1);
 		if (frameIndex >= 8) {
 			it = etbreaks.erase(it);
@@ -290,7 +274,7 @@ void Bullet::updateEtBreaks(double deltaTime)
 void Bullet::drawEtBreaks(esl::Window& renderer)
 {
 	for (const auto& effect : etbreaks) {
-		if (etbreakSprite && etbreakTexture) {
+		if (etbreakSprite) {
 			etbreakSprite->setTextureRect(
 				etbreakFrames[effect.current_index],
 				glm::vec2{ 64,64 }
@@ -303,76 +287,23 @@ void Bullet::drawEtBreaks(esl::Window& renderer)
 
 void Bullet::initEtBreak()
 {
-	etbreakTexture = std::make_unique<esl::Texture>("./Assets/effect/etbreak.png");
-	etbreakSprite = std::make_unique<esl::Sprite>(etbreakTexture.get());
+	// 消弹特效与子弹共用图集，需在 init() 之后调用
+	const esl::TextureRegion& region = sAtlas->region("etbreak");
+	if (region) {
+		etbreakSprite = std::make_unique<esl::Sprite>(region);
+	}
 }
 
 void Bullet::cleanupEtBreak()
 {
 	etbreaks.clear();
 	etbreakSprite.reset();
-	etbreakTexture.reset();
 }
 
-void Bullet_1::cleanup()
+void Bullet::cleanup()
 {
-	// ͷо̬
-	for (int i = 0; i < 6; i++) {
-		sTexture[i].reset();
-	}
-}
-
-void Bullet_1::addMovementAction(pBulletMovementAction action)
-{
-	mMovementActions.push_back(std::move(action));
-}
-
-void Bullet_1::clearMovementActions()
-{
-	mMovementActions.clear();
-}
-
-// ļĩβʵ
-
-bool GenericBulletMovementAction::update(double deltaTime) {
-	mState.elapsedTime += deltaTime;
-	mUpdater->update(mState, deltaTime);
-	return mStopCondition->shouldStop(mState);
+	// 释放外观表、批次和图集
+	sBatch.reset();
+	sStyles.clear();
+	sAtlas.reset();
 }
-
-void GenericBulletMovementAction::apply(Bullet* bullet) {
-	
-	if (!mInitialized) {
-		// ֻе NOT useTargetMode ʱŴӵ̳з
-		// Ϊʹ TargetModeĿλþģӦñӵʼǶȸ
-		if (!mState.useTargetMode) {
-			if (auto b1 = dynamic_cast<Bullet_1*>(bullet)) {
-				if (mState.direction == 0) {
-					mState.direction = b1->mAngle;
-				}
-			}
-		}
-		// ٶȼ̳ͬٶδãӵ̳
-		if (auto b1 = dynamic_cast<Bullet_1*>(bullet)) {
-			if (mState.speed < 0) {
-				mState.speed = b1->mSpeed;
-			}
-		}
-		mUpdater->initialize(mState, bullet->getPosition());
-		mInitialized = true;
-	}
-
-	// ӵλ
-	bullet->setPosition(mState.position);
-
-	//  Bullet_1ͬٶ
-	if (auto b1 = dynamic_cast<Bullet_1*>(bullet)) {
-		b1->mAngle = mState.direction;
-		b1->mSpeed = mState.speed;
-
-		// תͬ
-		if (b1->mSyncRotation) {
-			b1->getSprite()->setRotation(mState.direction);
-		}
-	}
-}
\ No newline at end of file
@@ -0,0 +1,100 @@
+﻿#include "BulletRenderThread.h"
+#include <Profiler.hpp>
+
+BulletRenderThread::BulletRenderThread()
+	: mThread([this]() { run(); })
+{
+}
+
+BulletRenderThread::~BulletRenderThread()
+{
+	stop();
+}
+
+void BulletRenderThread::publish()
+{
+	// 先发布数据，再更新步数，渲染线程看到新步数时一定能取到对应的快照
+	mSnapshots.back().step = ++mNextStep;
+	mSnapshots.publish();
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mPublishedStep = mNextStep;
+	}
+	mPublished.notify_one();
+}
+
+const BulletDrawList& BulletRenderThread::latest()
+{
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mBuilt.wait(lock, [this]() { return mStopping || mBuiltStep >= mPublishedStep; });
+	}
+	return mDrawLists.acquire();
+}
+
+void BulletRenderThread::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mStopping = true;
+	}
+	mPublished.notify_all();
+	mBuilt.notify_all();
+	if (mThread.joinable()) {
+		mThread.join();
+	}
+}
+
+void BulletRenderThread::run()
+{
+	esl::Profiler::setThreadName("Bullet render");
+	uint64_t built = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mPublished.wait(lock, [this, built]() { return mStopping || mPublishedStep != built; });
+			if (mStopping) return;
+		}
+		const BulletSnapshot& snapshot = mSnapshots.acquire();
+		{
+			ESL_PROFILE_ZONE("Bullet render build");
+			build(snapshot, mDrawLists.back());
+		}
+		mDrawLists.publish();
+		built = snapshot.step;
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mBuiltStep = built;
+		}
+		mBuilt.notify_all();
+	}
+}
+
+void BulletRenderThread::build(const BulletSnapshot& snapshot, BulletDrawList& list)
+{
+	list.step = snapshot.step;
+	for (auto& group : list.groups) {
+		group.instances.clear();
+	}
+	esl::SpriteBatch::Instance instance;
+	instance.color = { 1,1,1,1 };
+	size_t last = 0;
+	for (const BulletSnapshot::Entry& entry : snapshot.bullets) {
+		const BulletSnapshot::Style& style = snapshot.styles[entry.style];
+		if (!style.texture) continue;
+		// 连续的子弹通常是同一张纹理，先检查上一次命中的组
+		if (last >= list.groups.size() || list.groups[last].texture != style.texture) {
+			last = 0;
+			while (last < list.groups.size() && list.groups[last].texture != style.texture) last++;
+			if (last == list.groups.size()) {
+				list.groups.push_back({ style.texture, {} });
+			}
+		}
+		instance.translation = { entry.x, entry.y };
+		instance.motion = { entry.dx, entry.dy };
+		instance.rotation = glm::radians(entry.rotation);
+		instance.scale = style.scale;
+		instance.uvRect = style.uvRect;
+		list.groups[last].instances.push_back(instance);
+	}
+}
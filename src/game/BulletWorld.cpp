@@ -0,0 +1,492 @@
+﻿#include <BulletWorld.h>
+#include "Action.h"
+#include <JobSystem.hpp>
+#include <cmath>
+
+BulletWorld::~BulletWorld() = default;
+
+void BulletWorld::reserve(size_t capacity)
+{
+	while (this->capacity() < capacity) {
+		growChunk();
+	}
+}
+
+void BulletWorld::growChunk()
+{
+	const uint32_t first = static_cast<uint32_t>(mSlotGeneration.size());
+	const uint32_t newCapacity = first + CHUNK_SIZE;
+	mSlotIndex.resize(newCapacity);
+	mSlotGeneration.resize(newCapacity, 0);
+	// 新槽位按顺序接到空闲链表头部
+	for (uint32_t slot = newCapacity; slot-- > first;) {
+		mSlotIndex[slot] = mFreeHead;
+		mFreeHead = slot;
+	}
+
+	mX.reserve(newCapacity);
+	mY.reserve(newCapacity);
+	mPrevX.reserve(newCapacity);
+	mPrevY.reserve(newCapacity);
+	mVelX.reserve(newCapacity);
+	mVelY.reserve(newCapacity);
+	mRadius.reserve(newCapacity);
+	mGrazeTimer.reserve(newCapacity);
+	mAngle.reserve(newCapacity);
+	mSpeed.reserve(newCapacity);
+	mRotation.reserve(newCapacity);
+	mLifetime.reserve(newCapacity);
+	mStyle.reserve(newCapacity);
+	mProgram.reserve(newCapacity);
+	mPc.reserve(newCapacity);
+	mOpTime.reserve(newCapacity);
+	mFlags.reserve(newCapacity);
+	mOwner.reserve(newCapacity);
+	mActions.reserve(newCapacity);
+	mSlot.reserve(newCapacity);
+	mStats.capacity = newCapacity;
+}
+
+void BulletWorld::freeSlot(uint32_t slot)
+{
+	mSlotGeneration[slot]++;
+	mSlotIndex[slot] = mFreeHead;
+	mFreeHead = slot;
+}
+
+void BulletWorld::resetStats()
+{
+	mStats = Stats();
+	mStats.capacity = static_cast<uint32_t>(capacity());
+	mStats.peak = static_cast<uint32_t>(size());
+}
+
+uint32_t BulletWorld::allocateSlot()
+{
+	if (mFreeHead == BulletHandle::INVALID) {
+		growChunk();
+		mStats.growths++;
+	}
+	const uint32_t slot = mFreeHead;
+	mFreeHead = mSlotIndex[slot];
+	return slot;
+}
+
+BulletHandle BulletWorld::spawn(uint16_t style, float radius, glm::vec2 pos, float angle, float speed,
+	uint8_t flags, BulletOwner* owner)
+{
+	const uint32_t slot = allocateSlot();
+
+	const size_t index = size();
+	mSlotIndex[slot] = static_cast<uint32_t>(index);
+	mSlot.push_back(slot);
+	mX.push_back(pos.x);
+	mY.push_back(pos.y);
+	mPrevX.push_back(pos.x);
+	mPrevY.push_back(pos.y);
+	mVelX.push_back(0);
+	mVelY.push_back(0);
+	mRadius.push_back(radius);
+	mGrazeTimer.push_back(0);
+	mAngle.push_back(angle);
+	mSpeed.push_back(speed);
+	mRotation.push_back(angle - 90);  // -90 是因为精灵图片默认朝上
+	mLifetime.push_back(0);
+	mStyle.push_back(style);
+	mProgram.push_back(0);
+	mPc.push_back(0);
+	mOpTime.push_back(0);
+	mFlags.push_back(flags);
+	mOwner.push_back(owner);
+	mActions.emplace_back();
+	refreshVelocity(index);
+
+	if (owner) owner->mLiveBullets++;
+	mStats.spawned++;
+	if (size() > mStats.peak) mStats.peak = static_cast<uint32_t>(size());
+	return { slot, mSlotGeneration[slot] };
+}
+
+void BulletWorld::addMovementAction(BulletHandle handle, pBulletMovementAction action)
+{
+	const size_t index = indexOf(handle);
+	if (index == NPOS) return;
+	mActions[index].push_back(std::move(action));
+	mFlags[index] |= FLAG_SCRIPTED;
+}
+
+bool BulletWorld::alive(BulletHandle handle) const
+{
+	return indexOf(handle) != NPOS;
+}
+
+size_t BulletWorld::indexOf(BulletHandle handle) const
+{
+	if (handle.slot >= mSlotGeneration.size()) return NPOS;
+	if (mSlotGeneration[handle.slot] != handle.generation) return NPOS;
+	const size_t index = mSlotIndex[handle.slot];
+	if (mFlags[index] & FLAG_RELEASED) return NPOS;
+	return index;
+}
+
+BulletHandle BulletWorld::handleOf(size_t index) const
+{
+	const uint32_t slot = mSlot[index];
+	return { slot, mSlotGeneration[slot] };
+}
+
+bool BulletWorld::release(BulletHandle handle)
+{
+	const size_t index = indexOf(handle);
+	if (index == NPOS) return false;
+	// 槽位与归属计数在压缩时回收，这里只标记，释放大量子弹也是线性的
+	mFlags[index] |= FLAG_RELEASED;
+	mPendingReleases++;
+	return true;
+}
+
+void BulletWorld::refreshVelocity(size_t index)
+{
+	float radians = glm::radians(mAngle[index]);
+	mVelX[index] = mSpeed[index] * std::cos(radians);
+	mVelY[index] = mSpeed[index] * std::sin(radians);
+}
+
+void BulletWorld::update(double deltaTime)
+{
+	// 每颗子弹的运动互不依赖，按块分给工作线程；函数返回时全部完成
+	if (mJobs && size() >= PARALLEL_GRAIN * 2) {
+		mJobs->parallelFor(size(), PARALLEL_GRAIN, [this, deltaTime](size_t begin, size_t end) {
+			updateRange(begin, end, deltaTime);
+		});
+	}
+	else {
+		updateRange(0, size(), deltaTime);
+	}
+}
+
+void BulletWorld::updateRange(size_t begin, size_t end, double deltaTime)
+{
+	const float dt = static_cast<float>(deltaTime);
+
+	for (size_t i = begin; i < end; ++i) {
+		if (mFlags[i] & FLAG_RELEASED) continue;
+		mPrevX[i] = mX[i];
+		mPrevY[i] = mY[i];
+		mGrazeTimer[i] += dt;
+		mLifetime[i] += dt;
+
+		// 有运动 Action 的子弹交给 Action 驱动，全部完成后回到匀速直线运动
+		bool integrate = true;
+		if (mFlags[i] & FLAG_SCRIPTED) {
+			updateMovementActions(i, deltaTime);
+			if (mActions[i].empty()) {
+				mFlags[i] &= ~FLAG_SCRIPTED;
+				refreshVelocity(i);
+			}
+			else {
+				integrate = false;
+			}
+		}
+		else if (mProgram[i]) {
+			runProgram(i, dt);
+		}
+		if (integrate) {
+			mX[i] += mVelX[i] * dt;
+			mY[i] += mVelY[i] * dt;
+		}
+
+		// 如果启用了旋转同步，更新精灵旋转角度
+		if (mFlags[i] & FLAG_SYNC_ROTATION) {
+			mRotation[i] = mAngle[i] - 90;
+		}
+	}
+}
+
+void BulletWorld::runProgram(size_t index, float dt)
+{
+	const std::vector<BulletInstruction>& code = mPrograms[mProgram[index]].code();
+	// 一帧内最多连续执行的瞬时指令数，防止没有耗时指令的 JUMP 循环卡死
+	int budget = 16;
+	while (budget-- > 0) {
+		if (mPc[index] >= code.size()) {
+			mProgram[index] = 0;  // 程序结束，之后保持匀速直线
+			return;
+		}
+		const BulletInstruction& ins = code[mPc[index]];
+		switch (ins.op) {
+		case BulletOp::LINEAR:
+		case BulletOp::ACCELERATE:
+		case BulletOp::TURN:
+			if (ins.op == BulletOp::ACCELERATE) {
+				const float oldSpeed = mSpeed[index];
+				const float newSpeed = oldSpeed + ins.a * dt;
+				mSpeed[index] = newSpeed;
+				if (std::abs(oldSpeed) > 1e-4f) {
+					const float scale = newSpeed / oldSpeed;
+					mVelX[index] *= scale;
+					mVelY[index] *= scale;
+				}
+				else {
+					refreshVelocity(index);
+				}
+			}
+			else if (ins.op == BulletOp::TURN) {
+				mAngle[index] += ins.a * dt;
+				refreshVelocity(index);
+			}
+			mOpTime[index] += dt;
+			if (ins.time >= 0 && mOpTime[index] >= ins.time) {
+				mPc[index]++;
+				mOpTime[index] = 0;
+			}
+			return;
+		case BulletOp::WAIT_UNTIL:
+			if (mLifetime[index] < ins.a) return;
+			break;
+		case BulletOp::AIM_AT_PLAYER:
+			mAngle[index] = glm::degrees(std::atan2(mAimTarget.y - mY[index], mAimTarget.x - mX[index])) + ins.a;
+			refreshVelocity(index);
+			break;
+		case BulletOp::SET_SPEED:
+			mSpeed[index] = ins.a;
+			refreshVelocity(index);
+			break;
+		case BulletOp::SET_ANGLE:
+			mAngle[index] = ins.a;
+			refreshVelocity(index);
+			break;
+		case BulletOp::JUMP:
+			mPc[index] = static_cast<uint16_t>(ins.a);
+			mOpTime[index] = 0;
+			continue;
+		}
+		mPc[index]++;
+		mOpTime[index] = 0;
+	}
+}
+
+uint16_t BulletWorld::registerProgram(const BulletProgram& program)
+{
+	if (program.empty()) return 0;
+	for (size_t id = 1; id < mPrograms.size(); ++id) {
+		if (mPrograms[id] == program) return static_cast<uint16_t>(id);
+	}
+	mPrograms.push_back(program);
+	return static_cast<uint16_t>(mPrograms.size() - 1);
+}
+
+// 角度为等差数列时，用复数乘法（旋转）递推正余弦：只需计算两次三角函数，
+// 其余每项一次乘加，用 double 递推保证几百项后误差仍可忽略
+static void sincosProgression(float baseDegrees, float stepDegrees, uint32_t count, float* sines, float* cosines)
+{
+	const double base = glm::radians(static_cast<double>(baseDegrees));
+	const double step = glm::radians(static_cast<double>(stepDegrees));
+	const double stepCos = std::cos(step);
+	const double stepSin = std::sin(step);
+	double c = std::cos(base);
+	double s = std::sin(base);
+	for (uint32_t k = 0; k < count; ++k) {
+		cosines[k] = static_cast<float>(c);
+		sines[k] = static_cast<float>(s);
+		const double nc = c * stepCos - s * stepSin;
+		s = s * stepCos + c * stepSin;
+		c = nc;
+	}
+}
+
+size_t BulletWorld::spawnBatch(const PatternDesc& pattern, uint32_t count)
+{
+	const size_t first = size();
+	if (count == 0) return first;
+	const size_t last = first + count;
+
+	// 一次取出全部槽位
+	while (capacity() < last) {
+		growChunk();
+		mStats.growths++;
+	}
+	mSlot.resize(last);
+	for (size_t i = first; i < last; ++i) {
+		const uint32_t slot = allocateSlot();
+		mSlot[i] = slot;
+		mSlotIndex[slot] = static_cast<uint32_t>(i);
+	}
+
+	mX.resize(last);
+	mY.resize(last);
+	mVelX.resize(last);
+	mVelY.resize(last);
+	mAngle.resize(last);
+	mSpeed.resize(last);
+	mRotation.resize(last);
+	// 先把正余弦写进速度列，再就地换算成速度
+	float* sines = mVelY.data() + first;
+	float* cosines = mVelX.data() + first;
+	sincosProgression(pattern.baseAngle, pattern.angleStep, count, sines, cosines);
+
+	glm::vec2 fixedOffset = { 0, 0 };
+	if (!pattern.radialSpawn && pattern.spawnRadius > 0) {
+		float radians = glm::radians(pattern.spawnAngle);
+		fixedOffset = pattern.spawnRadius * glm::vec2(std::cos(radians), std::sin(radians));
+	}
+	const float spawnRadius = pattern.radialSpawn ? pattern.spawnRadius : 0.0f;
+	for (uint32_t k = 0; k < count; ++k) {
+		const size_t i = first + k;
+		const float angle = pattern.baseAngle + pattern.angleStep * k;
+		const float speed = pattern.speed + pattern.speedStep * k;
+		mX[i] = pattern.origin.x + fixedOffset.x + spawnRadius * cosines[k];
+		mY[i] = pattern.origin.y + fixedOffset.y + spawnRadius * sines[k];
+		mAngle[i] = angle;
+		mSpeed[i] = speed;
+		mRotation[i] = angle - 90;  // -90 是因为精灵图片默认朝上
+		mVelX[i] = speed * cosines[k];
+		mVelY[i] = speed * sines[k];
+	}
+
+	// 新生成的子弹没有上一步的位置
+	mPrevX.insert(mPrevX.end(), mX.begin() + first, mX.end());
+	mPrevY.insert(mPrevY.end(), mY.begin() + first, mY.end());
+
+	// 其余各列都是同一个值
+	mRadius.resize(last, pattern.radius);
+	mGrazeTimer.resize(last, 0.0f);
+	mLifetime.resize(last, 0.0f);
+	mStyle.resize(last, pattern.style);
+	mProgram.resize(last, pattern.program);
+	mPc.resize(last, 0);
+	mOpTime.resize(last, 0.0f);
+	mFlags.resize(last, pattern.flags);
+	mOwner.resize(last, pattern.owner);
+	mActions.resize(last);
+
+	if (pattern.owner) pattern.owner->mLiveBullets += count;
+	mStats.spawned += count;
+	if (size() > mStats.peak) mStats.peak = static_cast<uint32_t>(size());
+	return first;
+}
+
+void BulletWorld::updateMovementActions(size_t index, double deltaTime)
+{
+	auto& actions = mActions[index];
+	// 依次执行队首 Action，完成后移除并立即执行下一个
+	while (!actions.empty()) {
+		// 先应用Action效果（确保初始化）
+		actions.front()->apply(*this, index);
+
+		// 然后更新状态
+		if (!actions.front()->update(deltaTime)) break;
+		actions.erase(actions.begin());
+	}
+}
+
+size_t BulletWorld::cullOutside(glm::vec2 min, glm::vec2 max)
+{
+	// 并行标记出界的子弹，再在当前线程上稳定压缩
+	auto mark = [this, min, max](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			if (mX[i] < min.x || mX[i] > max.x || mY[i] < min.y || mY[i] > max.y) {
+				mFlags[i] |= FLAG_RELEASED;
+			}
+		}
+	};
+	if (mJobs && size() >= PARALLEL_GRAIN * 2) {
+		mJobs->parallelFor(size(), PARALLEL_GRAIN, mark);
+	}
+	else {
+		mark(0, size());
+	}
+	// 标记过的子弹由 releaseIf 直接删除
+	return releaseIf([](size_t) { return false; });
+}
+
+size_t BulletWorld::compact()
+{
+	if (mPendingReleases == 0) return 0;
+	return releaseIf([](size_t) { return false; });
+}
+
+void BulletWorld::clear()
+{
+	releaseIf([](size_t) { return true; });
+}
+
+void BulletWorld::moveSlot(size_t dst, size_t src)
+{
+	mX[dst] = mX[src];
+	mY[dst] = mY[src];
+	mPrevX[dst] = mPrevX[src];
+	mPrevY[dst] = mPrevY[src];
+	mVelX[dst] = mVelX[src];
+	mVelY[dst] = mVelY[src];
+	mRadius[dst] = mRadius[src];
+	mGrazeTimer[dst] = mGrazeTimer[src];
+	mAngle[dst] = mAngle[src];
+	mSpeed[dst] = mSpeed[src];
+	mRotation[dst] = mRotation[src];
+	mLifetime[dst] = mLifetime[src];
+	mStyle[dst] = mStyle[src];
+	mProgram[dst] = mProgram[src];
+	mPc[dst] = mPc[src];
+	mOpTime[dst] = mOpTime[src];
+	mFlags[dst] = mFlags[src];
+	mOwner[dst] = mOwner[src];
+	mActions[dst] = std::move(mActions[src]);
+	mSlot[dst] = mSlot[src];
+	mSlotIndex[mSlot[dst]] = static_cast<uint32_t>(dst);
+}
+
+void BulletWorld::truncate(size_t count)
+{
+	mX.resize(count);
+	mY.resize(count);
+	mPrevX.resize(count);
+	mPrevY.resize(count);
+	mVelX.resize(count);
+	mVelY.resize(count);
+	mRadius.resize(count);
+	mGrazeTimer.resize(count);
+	mAngle.resize(count);
+	mSpeed.resize(count);
+	mRotation.resize(count);
+	mLifetime.resize(count);
+	mStyle.resize(count);
+	mProgram.resize(count);
+	mPc.resize(count);
+	mOpTime.resize(count);
+	mFlags.resize(count);
+	mOwner.resize(count);
+	mActions.resize(count);
+	mSlot.resize(count);
+}
+
+// ========== 子弹运动 Action ==========
+
+bool GenericBulletMovementAction::update(double deltaTime) {
+	mState.elapsedTime += deltaTime;
+	mUpdater->update(mState, deltaTime);
+	return mStopCondition->shouldStop(mState);
+}
+
+void GenericBulletMovementAction::apply(BulletWorld& world, size_t index) {
+
+	if (!mInitialized) {
+		// 只有当 NOT useTargetMode 时，才从子弹继承方向
+		// 因为如果使用了 TargetMode，方向是由目标位置决定的，不应该被子弹初始角度覆盖
+		if (!mState.useTargetMode && mState.direction == 0) {
+			mState.direction = world.mAngle[index];
+		}
+		// 速度继承同理，如果速度未设置，从子弹继承
+		if (mState.speed < 0) {
+			mState.speed = world.mSpeed[index];
+		}
+		mUpdater->initialize(mState, world.position(index));
+		mInitialized = true;
+	}
+
+	// 更新子弹位置，同步方向和速度（旋转同步在 BulletWorld::update 中处理）
+	world.mX[index] = mState.position.x;
+	world.mY[index] = mState.position.y;
+	world.mAngle[index] = mState.direction;
+	world.mSpeed[index] = mState.speed;
+}
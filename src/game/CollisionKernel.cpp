@@ -0,0 +1,112 @@
+﻿#include "CollisionKernel.h"
+
+#if defined(__AVX2__)
+#define COLLISION_KERNEL_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLLISION_KERNEL_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace CollisionKernel {
+
+    // 逐颗检测，也用于处理向量化后剩下的尾部
+    static void testScalar(const float* xs, const float* ys, const float* radii,
+        uint32_t begin, uint32_t end, glm::vec2 center, float hitR2, float grazeR2,
+        uint32_t* grazeOut, Result& result)
+    {
+        for (uint32_t k = begin; k < end; ++k) {
+            float dx = center.x - xs[k];
+            float dy = center.y - ys[k];
+            float d2 = dx * dx + dy * dy;
+            float r2 = radii[k] * radii[k];
+            if (!result.hit && d2 < hitR2 + r2) {
+                result.hit = true;
+                result.hitIndex = k;
+            }
+            if (d2 < grazeR2 + r2) {
+                grazeOut[result.grazeCount++] = k;
+            }
+        }
+    }
+
+    // 把掩码中置位的通道依次写入 grazeOut
+    static inline void appendMask(unsigned mask, uint32_t base, uint32_t* grazeOut, Result& result)
+    {
+        while (mask) {
+            unsigned lane = 0;
+            while (!(mask & (1u << lane))) ++lane;
+            grazeOut[result.grazeCount++] = base + lane;
+            mask &= mask - 1;
+        }
+    }
+
+    Result testCircles(const float* xs, const float* ys, const float* radii,
+        uint32_t begin, uint32_t end, glm::vec2 center,
+        float hitRadius, float grazeRadius, uint32_t* grazeOut)
+    {
+        Result result;
+        const float hitR2 = hitRadius * hitRadius;
+        const float grazeR2 = grazeRadius * grazeRadius;
+        uint32_t k = begin;
+
+#if defined(COLLISION_KERNEL_AVX2)
+        const __m256 cx = _mm256_set1_ps(center.x);
+        const __m256 cy = _mm256_set1_ps(center.y);
+        const __m256 hr2 = _mm256_set1_ps(hitR2);
+        const __m256 gr2 = _mm256_set1_ps(grazeR2);
+        for (; k + 8 <= end; k += 8) {
+            __m256 dx = _mm256_sub_ps(cx, _mm256_loadu_ps(xs + k));
+            __m256 dy = _mm256_sub_ps(cy, _mm256_loadu_ps(ys + k));
+            __m256 r = _mm256_loadu_ps(radii + k);
+            __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            __m256 r2 = _mm256_mul_ps(r, r);
+            unsigned hitMask = static_cast<unsigned>(_mm256_movemask_ps(
+                _mm256_cmp_ps(d2, _mm256_add_ps(hr2, r2), _CMP_LT_OQ)));
+            unsigned grazeMask = static_cast<unsigned>(_mm256_movemask_ps(
+                _mm256_cmp_ps(d2, _mm256_add_ps(gr2, r2), _CMP_LT_OQ)));
+            if (hitMask && !result.hit) {
+                unsigned lane = 0;
+                while (!(hitMask & (1u << lane))) ++lane;
+                result.hit = true;
+                result.hitIndex = k + lane;
+            }
+            appendMask(grazeMask, k, grazeOut, result);
+        }
+#elif defined(COLLISION_KERNEL_SSE2)
+        const __m128 cx = _mm_set1_ps(center.x);
+        const __m128 cy = _mm_set1_ps(center.y);
+        const __m128 hr2 = _mm_set1_ps(hitR2);
+        const __m128 gr2 = _mm_set1_ps(grazeR2);
+        for (; k + 4 <= end; k += 4) {
+            __m128 dx = _mm_sub_ps(cx, _mm_loadu_ps(xs + k));
+            __m128 dy = _mm_sub_ps(cy, _mm_loadu_ps(ys + k));
+            __m128 r = _mm_loadu_ps(radii + k);
+            __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            __m128 r2 = _mm_mul_ps(r, r);
+            unsigned hitMask = static_cast<unsigned>(_mm_movemask_ps(_mm_cmplt_ps(d2, _mm_add_ps(hr2, r2))));
+            unsigned grazeMask = static_cast<unsigned>(_mm_movemask_ps(_mm_cmplt_ps(d2, _mm_add_ps(gr2, r2))));
+            if (hitMask && !result.hit) {
+                unsigned lane = 0;
+                while (!(hitMask & (1u << lane))) ++lane;
+                result.hit = true;
+                result.hitIndex = k + lane;
+            }
+            appendMask(grazeMask, k, grazeOut, result);
+        }
+#endif
+        testScalar(xs, ys, radii, k, end, center, hitR2, grazeR2, grazeOut, result);
+        return result;
+    }
+
+    const char* implementation()
+    {
+#if defined(COLLISION_KERNEL_AVX2)
+        return "AVX2";
+#elif defined(COLLISION_KERNEL_SSE2)
+        return "SSE2";
+#else
+        return "scalar";
+#endif
+    }
+}
@@ -2,71 +2,72 @@
 #include "Player.h"
 #include "Enemy.h"
 #include "Bullet.h"
+#include "BulletWorld.h"
+#include "SpatialGrid.h"
+#include "CollisionKernel.h"
 #include <glm/glm.hpp>
 #include <cmath>
 
 bool CollisionManager::checkEnemyBulletsVsPlayer(
-    const std::vector<std::unique_ptr<Bullet>>& bullets,
-    Player& player)
-{
-    // ʹ thread_local Ƶ
-    static thread_local std::vector<Bullet*> bulletPtrs;
-    bulletPtrs.clear();
-    bulletPtrs.reserve(bullets.size());
-
-    for (const auto& bullet : bullets) {
-        if (bullet) {
-            bulletPtrs.push_back(bullet.get());
-        }
-    }
-
-    // Ż汾
-    return checkEnemyBulletsVsPlayer(bulletPtrs, player);
-}
-bool CollisionManager::checkEnemyBulletsVsPlayer(
-    const std::vector<Bullet*>& bullets,
+    BulletWorld& bullets,
+    const SpatialGrid& grid,
     Player& player)
 {
     glm::vec2 playerPos = player.get_position();
     float playerRadius = player.mMissRadius;
     float grazeRadius = playerRadius + 64.0f;
+    bool invincible = player.isInvincible();
+
+    // 只检查玩家附近格子里的子弹，范围取擦弹半径加上最大子弹半径
+    float* grazeTimers = bullets.mGrazeTimer.data();
+    SpatialGrid::Query nearby = grid.query(playerPos, grazeRadius + grid.maxRadius());
+
+    size_t candidates = 0;
+    for (const SpatialGrid::Span& span : nearby) candidates += span.size();
+    if (candidates == 0) return false;
+    if (mGrazeCandidates.size() < candidates) mGrazeCandidates.resize(candidates);
+
+    // 每一行的格子是连续的一段，交给批量内核一次检测
+    size_t grazeCount = 0;
+    bool hit = false;
+    for (const SpatialGrid::Span& span : nearby) {
+        CollisionKernel::Result result = CollisionKernel::testCircles(
+            grid.xData(), grid.yData(), grid.radiusData(), span.begin, span.end,
+            playerPos, playerRadius, grazeRadius, mGrazeCandidates.data() + grazeCount);
+        grazeCount += result.grazeCount;
+        hit = hit || result.hit;
+    }
 
-
-    for (const auto& bullet : bullets) {
-        if (!bullet || !bullet->getSprite()) continue;
-
-        glm::vec2 bulletPos = bullet->getPosition();
-        float bulletRadius = static_cast<float>(bullet->mCollisionRadius);
-
-        // ŻAABB ޳ھȷǰ
-        float dx = playerPos.x - bulletPos.x;
-        float dy = playerPos.y - bulletPos.y;
-
-        // ʹñعƵı߽
-        float maxDist = playerRadius + bulletRadius + 64.0f;
-        if (dx > maxDist || dx < -maxDist) continue;
-        if (dy > maxDist || dy < -maxDist) continue;
-
-        // ײ
-        if (!player.isInvincible() && circleCollision(playerPos, playerRadius, bulletPos, bulletRadius)) {
-            if (mEnemyBulletHitPlayerCallback) {
-                mEnemyBulletHitPlayerCallback();
-            }
-            return true;
+    // 本步内被释放、尚未压缩的子弹仍在网格里，命中需要在擦弹候选中排除它们后重新判定
+    if (hit && bullets.pendingReleases() > 0) {
+        hit = false;
+        for (size_t n = 0; n < grazeCount && !hit; ++n) {
+            const uint32_t k = mGrazeCandidates[n];
+            if (bullets.released(grid.index(k))) continue;
+            const float dx = grid.xData()[k] - playerPos.x;
+            const float dy = grid.yData()[k] - playerPos.y;
+            const float r = grid.radiusData()[k];
+            hit = dx * dx + dy * dy < playerRadius * playerRadius + r * r;
         }
+    }
 
-        // 
-        if (bullet->lastGrazeTime > 0.5f) {
-            float grazeDist = grazeRadius + bulletRadius;
+    // 碰撞检测
+    if (hit && !invincible) {
+        if (mEnemyBulletHitPlayerCallback) {
+            mEnemyBulletHitPlayerCallback();
+        }
+        return true;
+    }
 
-            if (std::abs(dx) <= grazeDist && std::abs(dy) <= grazeDist) {
-                if (circleCollision(playerPos, grazeRadius, bulletPos, bulletRadius)) {
-                    bullet->lastGrazeTime = 0.f;
+    // 擦弹检测
+    for (size_t n = 0; n < grazeCount; ++n) {
+        const uint32_t i = grid.index(mGrazeCandidates[n]);
+        if (bullets.released(i)) continue;
+        if (grazeTimers[i] > 0.5f) {
+            grazeTimers[i] = 0.f;
 
-                    if (mPlayerGrazeEnemyBulletCallback)
-                        mPlayerGrazeEnemyBulletCallback();
-                }
-            }
+            if (mPlayerGrazeEnemyBulletCallback)
+                mPlayerGrazeEnemyBulletCallback();
         }
     }
 
@@ -90,7 +91,7 @@ bool CollisionManager::checkPlayerBulletsVsEnemy(
         glm::vec2 bulletPos = (*it)->sprite->getPosition();
         glm::vec2 bulletSize = (*it)->sprite->getGlobalSize();
 
-        // ʹ rectCollision ͳһ
+        // 使用 rectCollision 统一处理
         if (rectCollision(bulletPos, bulletSize, enemyPos, enemySize) && enemy.getHP() > 0) {
             enemy.onBulletHit(5);
             it = bullets.erase(it);
@@ -124,7 +125,7 @@ bool CollisionManager::checkPlayerBulletsVsEnemy(
         glm::vec2 bulletPos = (*it)->getPosition();
         glm::vec2 bulletSize = (*it)->getGlobalSize();
 
-        // ʹ rectCollision ͳһ
+        // 使用 rectCollision 统一处理
         if (rectCollision(bulletPos, bulletSize, enemyPos, enemySize) && enemy.getHP() > 0) {
             enemy.onBulletHit(10);
 			(*it)->setAvailable(false);
@@ -148,7 +149,7 @@ bool CollisionManager::checkPlayerVsEnemy(Player& player, Enemy& enemy)
     float playerRadius = player.mMissRadius;
     float enemyRadius = static_cast<float>(enemy.mCollisionRadius);
 
-    // ʹ circleCollision ͳһж
+    // 使用 circleCollision 统一判定
     if (circleCollision(playerPos, playerRadius, enemyPos, enemyRadius)) {
         if (mPlayerHitEnemyCallback) {
             mPlayerHitEnemyCallback();
@@ -186,7 +187,7 @@ bool CollisionManager::circleCollision(const glm::vec2& pos1, float radius1, con
 
 bool CollisionManager::rectCollision(const glm::vec2& pos1, const glm::vec2& size1, const glm::vec2& pos2, const glm::vec2& size2)
 {
-    // AABB ײ
+    // AABB 碰撞检测
     bool xOverlap = abs(pos1.x - pos2.x) < (size1.x + size2.x) / 2.0f;
     bool yOverlap = abs(pos1.y - pos2.y) < (size1.y + size2.y) / 2.0f;
     return xOverlap && yOverlap;
@@ -4,9 +4,10 @@
 #include <filesystem>
 #include <locale>
 #include <codecvt>
+#include <ResourceCache.hpp>
 void Dialogue_Illustration::init(const std::string& path,const std::string& index,bool reverse)
 {
-	full_illustration = std::make_unique<esl::Texture>(path + "face"+index+"bs.png");
+	full_illustration = esl::TextureCache::get(path + "face"+index+"bs.png");
 	full_sprite = std::make_unique<esl::Sprite>(full_illustration.get());
 	
 	glm::vec2 size = glm::vec2(full_illustration->getSize().w, full_illustration->getSize().h);
@@ -35,7 +36,7 @@ void Dialogue_Illustration::init(const std::string& path,const std::string& inde
 	for (size_t i = 0; i < std::size(face_name); i++) {
 		face_textures.emplace_back(
 			std::move(
-				std::make_unique<esl::Texture>(
+				esl::TextureCache::get(
 					path + face_name[i] + ".png"
 				)
 			)
@@ -50,7 +51,7 @@ void Dialogue_Illustration::init(const std::string& path,const std::string& inde
 		face_sprites[i]->setScale({ reverse ?glm::vec2{-scale.x,scale.y} : scale });
 	}
 
-	name_flavor = std::make_unique<esl::Texture>(path + "name.png");
+	name_flavor = esl::TextureCache::get(path + "name.png");
 	name_flavor_sprite = std::make_unique<esl::Sprite>(name_flavor.get());
 }
 
@@ -65,7 +66,7 @@ void Dialogue::init(esl::Window& renderer)
 
 void Dialogue::render()
 {
-	// ޸ʹϢΪգ˳ҲҪȾ
+	// 修复：即使消息为空，如果在退出动画中也要继续渲染
 	if (!Message::isEmpty() || mIsExiting) {
 		if (player_visible) {
 			renderer->draw(*player.full_sprite.get());
@@ -78,7 +79,7 @@ void Dialogue::render()
 				renderer->draw(*boss.face_sprites[boss.face_index].get());
 		}
 
-		// ֻϢʱȾϢ
+		// 只在有消息时渲染消息
 		if (!Message::isEmpty()) {
 			Message::renderFirst();
 		}
@@ -86,20 +87,20 @@ void Dialogue::render()
 }
 void Dialogue::update(double deltaTime)
 {
-	// ˳˳
+	// 如果正在退出，处理退出动画
 	if (mIsExiting) {
 
 		mExitTimer += deltaTime;
 		float progress = static_cast<float>(glm::clamp(mExitTimer / mExitDuration, 0.0, 1.0));
 
-		// ƶ
+		// 玩家向左下移动
 		if (player.full_sprite) {
 			glm::vec2 targetPos = player.ori_pos + glm::vec2(-300, -300) * progress;
 			player.full_sprite->setPosition(targetPos);
 			float alpha = 1.0f - progress;
 			player.full_sprite->setColor(glm::vec4(1, 1, 1, alpha));
 		}
-		// ұλúɫ
+		// 更新玩家表情位置和颜色
 		if (player.face_index != -1 && player.face_sprites[player.face_index]) {
 			glm::vec2 pos = player.full_sprite->getPosition();
 			player.face_sprites[player.face_index]->setPosition(pos + player.face_pos * glm::vec2(0.7, 0.7));
@@ -107,14 +108,14 @@ void Dialogue::update(double deltaTime)
 			player.face_sprites[player.face_index]->setColor(glm::vec4(1, 1, 1, alpha));
 		}
 
-		// Boss ƶ
+		// Boss 向右下移动
 		if (boss.full_sprite) {
 			glm::vec2 targetPos = boss.ori_pos + glm::vec2(300, -300) * progress;
 			boss.full_sprite->setPosition(targetPos);
 			float alpha = 1.0f - progress;
 			boss.full_sprite->setColor(glm::vec4(1, 1, 1, alpha));
 		}
-		//  Boss λúɫ
+		// 更新 Boss 表情位置和颜色
 		if (boss.face_index != -1 && boss.face_sprites[boss.face_index]) {
 			glm::vec2 pos = boss.full_sprite->getPosition();
 			boss.face_sprites[boss.face_index]->setPosition(pos + boss.face_pos * glm::vec2(0.7, 0.7));
@@ -122,7 +123,7 @@ void Dialogue::update(double deltaTime)
 			boss.face_sprites[boss.face_index]->setColor(glm::vec4(1, 1, 1, alpha));
 		}
 
-		// 
+		// 动画结束
 		if (progress >= 1.0f) {
 			mIsExiting = false;
 			player_visible = false;
@@ -172,7 +173,7 @@ void Dialogue::process_input(esl::Event& e)
 {
 	static bool respond = true;
 	if (respond) {
-		// òֵڼ¼һ֡ǷѾ¼ֹʱδ
+		// 该布尔值用于记录上一次帧是否已经按下了上下键，防止长按时多次触发
 		static bool key_pressed_last_frame = false;
 		if (e.isKeyPressed(Keyboard::KEY_Z) && !key_pressed_last_frame) {
 			Message::deleteFirst();
@@ -185,17 +186,17 @@ void Dialogue::process_input(esl::Event& e)
 }
 
 void Dialogue::reset() {
-	// ÿɼ
+	// 重置可见性
 	player_visible = false;
 	boss_visible = false;
-	// ˳״̬
+	// 重置退出状态
 	mIsExiting = false;
 	mExitTimer = 0.0;
-	// ñ
+	// 重置表情索引
 	player.face_index = -1;
 	boss.face_index = -1;
 
-	// λõʼλ
+	// 重置位置到初始位置
 	if (player.full_sprite) {
 		player.full_sprite->setPosition(player.ori_pos);
 		player.full_sprite->setColor(glm::vec4(1, 1, 1, 1));
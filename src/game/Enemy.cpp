@@ -1,17 +1,18 @@
 #include <Enemy.h>
 #include "Action.h"
 #include "ActionFactory.h"
-#include <BulletPool.h>
 #include <cmath>
 #include <Item.h>
 #include "ScriptSystem.h"
+#include <ResourceCache.hpp>
 std::string enemy_texture_path = ".\\Assets\\enemy\\";
 esl::Window* Enemy::mRenderer = nullptr;
-// ͳһľ̬
+// 统一敌人类的静态纹理
 pTexture EnemyUnit::sAnimalTexture = nullptr;
 pTexture EnemyUnit::sNormalTexture = nullptr;
 pTexture Enemy::sHPBar = nullptr;
 ScriptSystem* Enemy::sScriptSystem = nullptr;
+BulletWorld* Enemy::sBulletWorld = nullptr;
 void Enemy::init(esl::Window* renderer)
 {
 	mRenderer = renderer;
@@ -19,14 +20,15 @@ void Enemy::init(esl::Window* renderer)
 
 void Enemy::cleanup()
 {
-	// þ̬
+	// 重置静态纹理
 	sHPBar.reset();
 	EnemyUnit::sAnimalTexture.reset();
 	EnemyUnit::sNormalTexture.reset();
 	
-	// þָ̬
+	// 重置静态指针
 	mRenderer = nullptr;
 	sScriptSystem = nullptr;
+	sBulletWorld = nullptr;
 }
 
 void Enemy::updateActionQueue(std::deque<pAction>& actions, double delta)
@@ -35,7 +37,7 @@ void Enemy::updateActionQueue(std::deque<pAction>& actions, double delta)
 		auto& currentAction = actions.front();
 		currentAction->apply(this);
 		if (currentAction->update(delta)) {
-			// ǰɣƳִһ
+			// 当前动作完成，移除并执行下一个
 			actions.pop_front();
 		}
 		mFinished = false;
@@ -45,6 +47,7 @@ void Enemy::updateActionQueue(std::deque<pAction>& actions, double delta)
 
 void Enemy::update(double delta)
 {
+	if (mSprite) mPrevPos = mSprite->getPosition();
 	if (mSpawnAction) {
 		mHitable = false;
 		static bool firstApply = true;
@@ -62,13 +65,12 @@ void Enemy::update(double delta)
 	mHitable = true;
 	updateActionQueue(mMovementActions, delta);
 	updateActionQueue(mDanmakuActions, delta);
-	updateBullets(delta);
 	if (mMovementActions.empty() && mDanmakuActions.empty() && !mDeathAction) {
 		mSpriteAvailable = false;
 		mHitable = false;
 	}
-	if (mBullets.empty()) mBulletsAvailable = false;
-	else mBulletsAvailable = true;
+	// 子弹全部消失后才允许销毁
+	mBulletsAvailable = mLiveBullets > 0;
 
 	
 	if (isHitByPlayer) {
@@ -82,40 +84,6 @@ void Enemy::update(double delta)
 			isHitByPlayer = false;
 		}
 	}
-	
-
-	//Żӳɾ
-	const float SCREEN_LEFT = 0.0f;
-	const float SCREEN_RIGHT = 896.0f;
-	const float SCREEN_TOP = 960.0f;
-	const float SCREEN_BOTTOM = 0.0f;
-
-	// ʹ erase-remove idiom һɾʧЧӵ
-	mBullets.erase(
-		std::remove_if(mBullets.begin(), mBullets.end(),
-			[&](pBullet& bullet) {
-				if (!bullet) return true;
-
-				glm::vec2 pos = bullet->getPosition();
-
-				// Ļ߽
-				if (pos.x < SCREEN_LEFT || pos.x > SCREEN_RIGHT ||
-					pos.y > SCREEN_TOP || pos.y < SCREEN_BOTTOM) {
-
-					// 黹
-					if (auto* bullet1 = dynamic_cast<Bullet_1*>(bullet.get())) {
-						std::unique_ptr<Bullet_1> ptr(
-							static_cast<Bullet_1*>(bullet.release())
-						);
-						BulletPoolHelper::returnBullet(std::move(ptr));
-					}
-					return true;
-				}
-
-				return false;
-			}),
-		mBullets.end()
-	);
 }
 
 ///PowerUp,Power,LifeUp,Life,SpellCard,FullPower,Point
@@ -131,22 +99,14 @@ void Enemy::setBonus(int powerUp, int power, int lifeUp, int life, int spellCard
 	mBonusNum.radius = radius;
 }
 
-void Enemy::updateBullets(double deltaTime)
-{
-	for (auto& bullet : mBullets) {
-		if (bullet) bullet->update(deltaTime);
-	}
-}
-
 void Enemy::render()
 {
 	if (mSprite && mSpriteAvailable) {
+		// 在上一步与当前位置之间插值绘制，绘制后恢复逻辑位置
+		glm::vec2 pos = mSprite->getPosition();
+		mSprite->setPosition(glm::mix(mPrevPos, pos, mRenderer->getInterpolationAlpha()));
 		mRenderer->draw(*mSprite);
-	}
-
-	// ŻȾӵ
-	if (!mBullets.empty()) {
-		Bullet_1::renderBatch(*mRenderer, mBullets);
+		mSprite->setPosition(pos);
 	}
 }
 
@@ -157,7 +117,7 @@ void Enemy::onBulletHit(int damage)
 	mEnemyHP -= damage;
 	isHitByPlayer = true;
 
-	// ѪΪ0£ж
+	// 如果敌人血量为0或以下，清空所有动作
 	if (mEnemyHP <= 0) {
 		mEnemyHP = 0;
 		Item::generate_items(mBonusNum.powerUp, mBonusNum.power, mBonusNum.lifeUp, mBonusNum.life, mBonusNum.spellCard, mBonusNum.fullPower, mBonusNum.point, mSprite->getPosition(), mBonusNum.radius);
@@ -223,10 +183,10 @@ void Enemy::setPlayerPosGetter(std::function<glm::vec2()> getter) {
 }
 
 DanmakuAction& Enemy::shoot() {
-	// ʹ thread_local ̬ڴ
+	// 使用 thread_local 静态变量，避免内存问题
 	static thread_local DanmakuAction builder;
-	builder = DanmakuAction();  // 
-	builder.setRenderer(mRenderer);
+	builder = DanmakuAction();  // 重置
+	builder.setBulletWorld(sBulletWorld);
 	builder.setPlayerPosGetter(mGetPlayerPos);
 
 	return builder;
@@ -234,40 +194,31 @@ DanmakuAction& Enemy::shoot() {
 
 void Enemy::clearBullets()
 {
-	// ӵ黹أȻ
-	for (auto& bullet : mBullets) {
-		if (bullet) {
-			Bullet::createEtBreakEffect(bullet->getPosition());
-
-			if(dynamic_cast<Bullet_1*>(bullet.get())){
-				// ͷ unique_ptr ȨתΪ Bullet_1 ͣȻ黹
-				std::unique_ptr<Bullet_1> bullet1_ptr(static_cast<Bullet_1*>(bullet.release()));
-				BulletPoolHelper::returnBullet(std::move(bullet1_ptr));
-			}
-		}
+	// 消除自己发射的全部子弹并播放消弹特效
+	if (sBulletWorld && mLiveBullets > 0) {
+		Bullet::clearWithEffect(*sBulletWorld, this);
 	}
-	mBullets.clear();
 }
 
 void EnemyUnit::texture_init()
 {
 	if (!sAnimalTexture) {
-		sAnimalTexture = std::make_unique<esl::Texture>(enemy_texture_path + "animal_spirits.png",esl::Texture::Wrap::CLAMP_TO_EDGE,esl::Texture::Filter::NEAREST);
+		sAnimalTexture = esl::TextureCache::get(enemy_texture_path + "animal_spirits.png",esl::Texture::Wrap::CLAMP_TO_EDGE,esl::Texture::Filter::NEAREST);
 	}
 	if (!sNormalTexture) {
-		sNormalTexture = std::make_unique<esl::Texture>(enemy_texture_path + "enemy.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
+		sNormalTexture = esl::TextureCache::get(enemy_texture_path + "enemy.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
 	}
 
 }
 
-// ﾫ鹹캯
+// 动物精灵构造函数
 EnemyUnit::EnemyUnit(AnimalType type, bool isHorizon, glm::vec2 pos, int HP)
 {
 	mIsAnimalSpirit = true;
 	initAnimalSpirit(type, isHorizon, pos, HP);
 }
 
-// ͨ˹캯
+// 普通敌人构造函数
 EnemyUnit::EnemyUnit(NormalType type, glm::vec2 pos, int HP)
 {
 	mIsAnimalSpirit = false;
@@ -278,7 +229,7 @@ void EnemyUnit::initAnimalSpirit(AnimalType type, bool isHorizon, glm::vec2 pos,
 {
 	texture_init();
 
-	// ׼߶
+	// 基准高度
 	int base_height = 16;
 	if (!isHorizon) {
 		switch (type) {
@@ -327,10 +278,11 @@ void EnemyUnit::initAnimalSpirit(AnimalType type, bool isHorizon, glm::vec2 pos,
 	mSprite = std::make_unique<esl::Sprite>(sAnimalTexture.get());
 	mSprite->setTextureRect(mRect[0], mSize);
 	mSprite->setPosition(pos);
+	mPrevPos = pos;
 	mSprite->setScale({ 2, 2 });
 	//mSprite->setBorderVisiable(true);
 
-	// Ѫʼ
+	// 血量初始化
 	mEnemyHP = HP;
 	mMaxHP = HP;
 }
@@ -369,7 +321,7 @@ void EnemyUnit::initNormalEnemy(NormalType type, glm::vec2 pos, int HP)
 		size = { 32, 32 };
 		sprite_num = 5;
 		break;
-	case NormalType::TYPE6: // 
+	case NormalType::TYPE6: // 跳过阴阳玉
 		start_pos = { 0, 384 };
 		size = { 48, 32 };
 		sprite_num = 4;
@@ -404,20 +356,21 @@ void EnemyUnit::initNormalEnemy(NormalType type, glm::vec2 pos, int HP)
 	mSprite = std::make_unique<esl::Sprite>(sNormalTexture.get());
 	mSprite->setTextureRect(mRect[0], mSize);
 	mSprite->setPosition(pos);
+	mPrevPos = pos;
 	mSprite->setScale({ 1.5, 1.5 });
 	//mSprite->setBorderVisiable(true);
 
-	// Ѫʼ
+	// 血量初始化
 	mEnemyHP = HP;
 	mMaxHP = HP;
 }
 
 void EnemyUnit::update(double delta)
 {
-	// ¼
+	// 基类事件更新
 	Enemy::update(delta);
 
-	// ֡
+	// 帧动画
 	if (++mFrame > 10) {
 		mSpriteIndex = (mSpriteIndex + 1) % mSpriteNum;
 		
@@ -434,8 +387,8 @@ void EnemyUnit::render()
 
 void Boss::initBossLifeBar()
 {
-	hp_back_texture = std::make_unique<esl::Texture>("Assets/front/e_life_bar_1.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
-	hp_fore_texture = std::make_unique<esl::Texture>("Assets/front/e_life_bar_2.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
+	hp_back_texture = esl::TextureCache::get("Assets/front/e_life_bar_1.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
+	hp_fore_texture = esl::TextureCache::get("Assets/front/e_life_bar_2.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
 	hp_fore = std::make_unique<esl::ProgressSprite>(hp_fore_texture.get());
 	hp_back = std::make_unique<esl::ProgressSprite>(hp_back_texture.get());
 	hp_fore->setPosition(glm::vec2(400, 300));
@@ -458,13 +411,14 @@ void Boss::initBoss(size_t boss,int hp,glm::vec2 pos)
 	std::string texture_path = "Assets/stgenm/stage0"+ std::to_string(boss);
 	texture_path += "/enm" + std::to_string(boss);
 	texture_path += ".png";
-	texture = std::make_unique<esl::Texture>(texture_path, esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
+	texture = esl::TextureCache::get(texture_path, esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
 	mSprite = std::make_unique<esl::Sprite>(texture.get());
 	mSprite->setPosition(pos);
+	mPrevPos = pos;
 	mSprite->setScale({ 2,2 });
 	mSize = { 48,80 };
 	texture_path = "Assets/effect/eff_magicsquare.png";
-	magic_square_texture = std::make_unique<esl::Texture>(texture_path);
+	magic_square_texture = esl::TextureCache::get(texture_path);
 	magic_square = std::make_unique<esl::Sprite>(magic_square_texture.get());
 	magic_square->setAlpha(0.5);
 	mEnemyHP = hp;
@@ -499,7 +453,7 @@ void Boss::update(double deltaTime)
 		}
 		break;
 	case BossStatus::Move:
-		// δʵ
+		// 未实现
 		break;
 	case BossStatus::SpellCard:
 		if (++mFrame > 10)
@@ -511,7 +465,7 @@ void Boss::update(double deltaTime)
 		break;
 	}
 	glm::vec2 boss_position = mSprite->getPosition();
-	// magic_square
+	// 更新magic_square
 	float rotation = magic_square->getRotation();
 	rotation += 0.5;
 	magic_square->setRotation(rotation);
@@ -542,35 +496,31 @@ void Boss::loadFromFile(const std::string& path)
 }
 
 DanmakuEmitter::DanmakuEmitter(glm::vec2 startPos){
-	// ʼ
-	mEnemyHP = 1;           // Ϊ 1 Ա
+	// 初始化基本属性
+	mEnemyHP = 1;           // 设置为 1 以便正常工作
 	mMaxHP = 1;
-	mCollisionRadius = 0;   // ײ
+	mCollisionRadius = 0;   // 无碰撞体积
 
-	// ɼľ
+	// 创建不可见的精灵
 	mSprite = std::make_unique<esl::Sprite>();
 	mSprite->setPosition(startPos);
-	mSprite->setAvailable(false);  // ؼɼ
+	mPrevPos = startPos;
+	mSprite->setAvailable(false);  // 关键：不可见
 	mHitable = false;
-	// Ϊɽ
+	// 标记为不可交互
 	mSpriteAvailable = false;
 	mBulletsAvailable = true;
 	mEnemyType = EnemyType::EMITTER;
 
-	// κν
+	// 不掉落任何奖励
 	setBonus(0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 void DanmakuEmitter::render() {
-	// ȾֻȾӵ
-	for (auto& bullet : mBullets) {
-		if (bullet && bullet->getSprite()) {
-			mRenderer->draw(*bullet->getSprite());
-		}
-	}
+	// 不渲染自身，子弹由 BulletWorld 统一绘制
 }
 void DanmakuEmitter::update(double delta) {
-	// 鸸 Enemy Ƿ mEnemys бУȫ
+	// 检查父 Enemy 是否还在 mEnemys 列表中（更安全）
 	if (mParentEnemy && !mParentEnemy->mSpriteAvailable) {
 		mSpriteAvailable = false;
 		mBulletsAvailable = false;
@@ -1,5 +1,6 @@
 #include <Front.h>
 #include <Enemy.h>
+#include <ResourceCache.hpp>
 void Front::setDifficultyMode(int difficulty,glm::vec2 pos)
 {
 	glm::vec2 base_pos(512,256);
@@ -39,7 +40,7 @@ void Front::hideBossXPosIndicator()
 Front::Front(esl::Window& window) : renderer(window)
 {
 	const std::string texture_path = "Assets/front/front00.png";
-	mTexture = std::make_unique<esl::Texture>(texture_path, esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
+	mTexture = esl::TextureCache::get(texture_path, esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
 	mLeftSprite = std::make_unique<esl::Sprite>(mTexture.get());
 	mRightSprite = std::make_unique<esl::Sprite>(mTexture.get());
 	mTopSprite = std::make_unique<esl::Sprite>(mTexture.get());
@@ -60,15 +61,15 @@ Front::Front(esl::Window& window) : renderer(window)
 	mBottomSprite->setPosition({ 64.f+size.x/2,0.f+size.y/2 });
 
 	glm::vec2 pos = { 64 + 768 + 64,960 - 128 };
-	// ߵ÷
+	// 最高得分
 	mHighScore = std::make_unique<esl::Sprite>(mTexture.get());
 	mHighScore->setTextureRect({ 512,1024-36 }, { 150,36 });
 	mHighScore->setPosition({ pos.x+32, pos.y });
-	// ÷
+	// 得分
 	mScore = std::make_unique<esl::Sprite>(mTexture.get());
 	mScore->setTextureRect({ 512,1024-72 }, { 150,36 });
 	mScore->setPosition({ pos.x + 32, pos.y-64 });
-	// ʣ
+	// 剩余人数
 	mRemainLife = std::make_unique<esl::Sprite>(mTexture.get());
 	mRemainLife->setTextureRect({ 512,1024 - 108 }, { 150,36 });
 	mRemainLife->setPosition({ pos.x + 32, pos.y - 64*2 });
@@ -76,11 +77,11 @@ Front::Front(esl::Window& window) : renderer(window)
 	mSpellCard = std::make_unique<esl::Sprite>(mTexture.get());
 	mSpellCard->setTextureRect({ 512+150,1024-36 }, { 164,36 });
 	mSpellCard->setPosition({ pos.x + 32+14, pos.y - 64 * 3 });
-	// 
+	// 灵力
 	mPower = std::make_unique<esl::Sprite>(mTexture.get());
 	mPower->setTextureRect({ 512 + 150,1024 - 4*36 }, { 150,36 });
 	mPower->setPosition({ pos.x + 64, pos.y - 64 * 4 });
-	// Ǯ
+	// 金钱
 	mMoney = std::make_unique<esl::Sprite>(mTexture.get());
 	mMoney->setTextureRect({ 512 + 150,1024 - 3*36 }, { 150,36 });
 	mMoney->setPosition({ pos.x + 64, pos.y - 64 * 5 });
@@ -129,8 +130,8 @@ void Front::char_map_init()
 	mCharMap[1].loadFromFile(asciif_texture_path);
 	for (int i = 0; i < 2; i++) {
 		int y = 9;
-		mCharMap[i].bindCharacter(U'', { 0,y }, { 32,39 });
-		mCharMap[i].bindCharacter(U'', { 32,y }, { 32,39 });
+		mCharMap[i].bindCharacter(U'终', { 0,y }, { 32,39 });
+		mCharMap[i].bindCharacter(U'框', { 32,y }, { 32,39 });
 		y += 40;
 		mCharMap[i].bindCharacter(U'p', { 0,y }, { 22,39 });
 		mCharMap[i].bindCharacter(U'q', { 32,y }, { 22,39 });
@@ -147,9 +148,9 @@ void Front::char_map_init()
 		mCharMap[i].bindCharacter(U'|', { 32 * 12,y }, { 14,39 });
 		mCharMap[i].bindCharacter(U'}', { 32 * 13,y }, { 16,39 });
 		mCharMap[i].bindCharacter(U'~', { 32 * 14,y }, { 24,39 });
-		mCharMap[i].bindCharacter(U'', { 32 * 15,y }, { 30,39 });
+		mCharMap[i].bindCharacter(U'回', { 32 * 15,y }, { 30,39 });
 		y += 40;
-		mCharMap[i].bindCharacter(U'', { 0,y }, { 15,39 });
+		mCharMap[i].bindCharacter(U'‘', { 0,y }, { 15,39 });
 		mCharMap[i].bindCharacter(U'a', { 32,y }, { 22,39 });
 		mCharMap[i].bindCharacter(U'b', { 32 * 2,y }, { 22,39 });
 		mCharMap[i].bindCharacter(U'c', { 32 * 3,y }, { 20,39 });
@@ -219,7 +220,7 @@ void Front::char_map_init()
 		y += 40;
 		mCharMap[i].bindCharacter(U' ', { 0,y }, { 22,39 });
 		mCharMap[i].bindCharacter(U'!', { 32,y }, { 16,39 });
-		mCharMap[i].bindCharacter(U'', { 32 * 2,y }, { 18,39 });
+		mCharMap[i].bindCharacter(U'“', { 32 * 2,y }, { 18,39 });
 		mCharMap[i].bindCharacter(U'#', { 32 * 3,y }, { 22,39 });
 		mCharMap[i].bindCharacter(U'$', { 32 * 4,y }, { 22,39 });
 		mCharMap[i].bindCharacter(U'%', { 32 * 5,y }, { 29,39 });
@@ -273,28 +274,35 @@ void Front::char_map_init()
 }
 void Front::text_update()
 {
-	for (int i = 0; i < 2; i++) {
-		std::string str = std::to_string(*mData.score);
-		if (str.size() > 3) {
-			for (int j = static_cast<int>(str.size()) - 3; j > 0; j -= 3) {
-				str.insert(j, ",");
-			}
-		}
-		mScoreText[i]->setText(str);
-		str = std::to_string(*mData.highscore);
-		if (str.size() > 3) {
-
-			for (int j = static_cast<int>(str.size()) - 3; j > 0; j -= 3) {
-				str.insert(j, ",");
-			}
+	// 只在数值变化时重建文本，每次重建都会分配字符串和字形精灵
+	auto withCommas = [](unsigned int value) {
+		std::string str = std::to_string(value);
+		for (int j = static_cast<int>(str.size()) - 3; j > 0; j -= 3) {
+			str.insert(j, ",");
 		}
-		mHighScoreText[i]->setText(str);
-		str = std::to_string(*mData.power);
+		return str;
+	};
+	if (*mData.score != mShownScore) {
+		mShownScore = *mData.score;
+		std::string str = withCommas(mShownScore);
+		for (auto& text : mScoreText) text->setText(str);
+	}
+	if (*mData.highscore != mShownHighScore) {
+		mShownHighScore = *mData.highscore;
+		std::string str = withCommas(mShownHighScore);
+		for (auto& text : mHighScoreText) text->setText(str);
+	}
+	if (*mData.power != mShownPower) {
+		mShownPower = *mData.power;
+		std::string str = std::to_string(mShownPower);
 		str.insert(str.size() - 2, ".");
 		str += "/4.00";
-		mPowerText[i]->setText(str);
-		str = std::to_string(*mData.money);
-		mMoneyText[i]->setText(str);
+		for (auto& text : mPowerText) text->setText(str);
+	}
+	if (*mData.money != mShownMoney) {
+		mShownMoney = *mData.money;
+		std::string str = std::to_string(mShownMoney);
+		for (auto& text : mMoneyText) text->setText(str);
 	}
 }
 void Front::render()
@@ -352,7 +360,7 @@ void Front::update(double delta)
 		mSpellCards[i]->setTextureRect(pos + glm::vec2{ 0,-39 }, mRect);
 	}
 	text_update();
-	// ȡʾ
+	// 收取线显示动画
 	if (mItemGetAnimationStarted) {
 		mItemGetAnimationTime += delta;
 		mItemGetBorderLine->setAlpha(static_cast<float>(sin((mItemGetAnimationTime - 0.125) * 4 * glm::pi<double>())/2+0.5));
@@ -365,7 +373,7 @@ void Front::update(double delta)
 		}
 	}
 	
-	// лλָʾ
+	// 敌机横坐标位置指示
 	if (mBossXPosIndicatorEnabled) {
 		mBossXPosIndicatorAnimationTime += delta;
 		
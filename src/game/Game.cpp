@@ -1,4 +1,8 @@
 #include <Game.h>
+#include <Profiler.hpp>
+#include <TextureLoader.hpp>
+#include <ResourceCache.hpp>
+#include <ShaderLibrary.hpp>
 
 Game::Game()
 {
@@ -7,18 +11,34 @@ Game::Game()
 
 Game::~Game()
 {
+	finishGame();
+	// 纹理、着色器等 GL 资源都要在窗口（OpenGL 上下文）销毁之前释放：
+	// 先销毁持有纹理的场景和脚本系统，再清空缓存，最后销毁窗口
+	delete mScene;
+	mScene = nullptr;
+	esl::TextureLoader::stop();
+	mScriptSystem.reset();
+	esl::TextureCache::cache().setBudget(0);
+	esl::ShaderLibrary::clear();
+	esl::Sprite::releaseSharedQuad();
+	mWindow.reset();
 	esl::Terminate();
 }
 
 void Game::init()
 {
+	esl::Profiler::setThreadName("Main");
 	mWindow = std::make_unique<esl::Window>(1280, 960, "Touhou 18 - UM", false, false);
 	mWindow->setBackgroundColor(glm::vec4{ 1,1,1,1 });
 	mWindow->setWindowPosition({ 400, 30 });
-	mScriptSystem.initDialogueSystem(*mWindow);
-	mScriptSystem.initAudioSystem(*mWindow);
-	mScriptSystem.preloadSoundEffect("Assets/sound/");
-	mScene = new TitleScene(*(mWindow.get()),mScriptSystem);
+	// 之后的纹理在工作线程上解码，标题、对白立绘和关卡背景不再阻塞窗口
+	esl::TextureLoader::start();
+	// 链接好的着色器程序按驱动缓存到磁盘，之后启动不必重新编译
+	esl::ShaderLibrary::setBinaryCache("shader_cache");
+	mScriptSystem->initDialogueSystem(*mWindow);
+	mScriptSystem->initAudioSystem(*mWindow);
+	mScriptSystem->preloadSoundEffect("Assets/sound/");
+	mScene = new TitleScene(*(mWindow.get()),*mScriptSystem);
 }
 
 void Game::run()
@@ -29,34 +49,52 @@ void Game::run()
 void Game::update()
 {
 	double timeSinceLastUpdate = 0;
-	double timePerFrame = 1.0 / 60.0;  // 60 FPS Ƶ
+	double timePerFrame = 1.0 / 60.0;  // 60 FPS 更新频率
 	
 	while (mWindow->isOpen() && !mShouldQuit) {
 		esl::Event e;
-		mWindow->pollEvents(e);
-		this->handle_event(e);
+		// 录制或回放时输入按逻辑步处理，保证与回放时完全一致
+		const bool stepInput = mInGame && mReplayMode != ReplayMode::NONE;
+		{
+			ESL_PROFILE_ZONE("Input");
+			mWindow->pollEvents(e);
+			if (!stepInput) this->handle_event(e);
+		}
 		
 		double deltaTime = mMainClock.getElapsedTime();
 		mMainClock.restart();
 		timeSinceLastUpdate += deltaTime;
 		
-		// ̶ʱ䲽Ϸ߼
+		// 固定时间步长更新游戏逻辑
 		while (timeSinceLastUpdate >= timePerFrame) {
+			ESL_PROFILE_ZONE("Fixed step");
 			timeSinceLastUpdate -= timePerFrame;
+			if (stepInput) {
+				if (mReplayMode == ReplayMode::RECORD) {
+					mReplay.record(Replay::capture(e));
+				}
+				else {
+					Replay::apply(mReplay.input(mReplayFrame++), e);
+				}
+				this->handle_event(e);
+			}
 			mScene->update(timePerFrame);
 			
-			// л
+			// 处理场景切换
 			if (mScene->mSceneInfo.mSwitchToNextScene) {
 				int index = mScene->mSceneInfo.mSwitchToSceneIndex;
-				mScriptSystem.stopAudio();
+				mScriptSystem->stopAudio();
 				delete mScene;
+				mScene = nullptr;
+				finishGame();
 				switch (index) {
 				case -1: {
-					mScene = new TitleScene(*(mWindow.get()), mScriptSystem);
+					mScene = new TitleScene(*(mWindow.get()), *mScriptSystem);
 					break;
 				}
 				case 0: {
-					mScene = new MainGame(*(mWindow.get()), mScriptSystem);
+					startGame();
+					mScene = new MainGame(*(mWindow.get()), *mScriptSystem);
 					break;
 				}
 				case 1: {
@@ -72,12 +110,66 @@ void Game::update()
 				default:
 					break;
 				}
-				
+				// 退出或没有对应的场景
+				if (!mScene) break;
 			}
 		}
+		if (!mScene) break;
 		
-		// ÿ֡Ⱦ̶ܹʱ䲽
-		mScene->render();
+		// 每帧都渲染，不受固定时间步长限制；
+		// 按剩余时间在上一步与当前步之间插值，高刷新率下运动更平滑。
+		// 暂停或场景还没有推进过时没有可插值的运动，直接绘制当前状态
+		const float alpha = mScene->advanced() ? static_cast<float>(timeSinceLastUpdate / timePerFrame) : 1.0f;
+		mWindow->setInterpolationAlpha(alpha);
+		esl::TextureLoader::update();
+		{
+			ESL_PROFILE_ZONE("Render");
+			mScene->render();
+		}
+		ESL_PROFILE_FRAME();
+	}
+}
+
+void Game::recordReplay(const std::string& path)
+{
+	mReplayMode = ReplayMode::RECORD;
+	mReplayPath = path;
+}
+
+bool Game::playReplay(const std::string& path)
+{
+	if (!mReplay.load(path)) return false;
+	mReplayMode = ReplayMode::PLAYBACK;
+	mReplayPath = path;
+	return true;
+}
+
+void Game::startGame()
+{
+	mInGame = true;
+	mReplayFrame = 0;
+	if (mReplayMode == ReplayMode::RECORD) {
+		// 每局使用新的种子并记入录像
+		mReplay.clear();
+		mReplay.setSeed(std::random_device{}());
+	}
+	if (mReplayMode != ReplayMode::NONE) {
+		MainGame::SetSeed(mReplay.seed());
+	}
+}
+
+void Game::finishGame()
+{
+	if (!mInGame) return;
+	mInGame = false;
+	if (mReplayMode == ReplayMode::RECORD) {
+		if (mReplay.save(mReplayPath)) {
+			std::cout << "Replay saved: " << mReplayPath << " (" << mReplay.size() << " steps)" << std::endl;
+		}
+	}
+	else if (mReplayMode == ReplayMode::PLAYBACK) {
+		// 只回放一局，之后恢复实时输入
+		mReplayMode = ReplayMode::NONE;
 	}
 }
 
@@ -0,0 +1,210 @@
+﻿#include <HeadlessRunner.h>
+#include <ESL.hpp>
+#include <Window.hpp>
+#include <Clock.hpp>
+#include <NullGL.hpp>
+#include <Profiler.hpp>
+#include <AllocTracker.hpp>
+#include <Scene.h>
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+// 读取 MainGame 写出的哈希文件，每行 "<步数> <哈希>"，步数必须从 0 开始连续。
+// 文件无法打开、为空或格式不对时返回 false
+static bool LoadHashes(const std::string& path, std::vector<uint64_t>& hashes)
+{
+	hashes.clear();
+	std::FILE* file = std::fopen(path.c_str(), "r");
+	if (!file) {
+		std::fprintf(stderr, "[Headless] cannot open hash file %s\n", path.c_str());
+		return false;
+	}
+	unsigned long long step = 0, hash = 0;
+	int matched = 0;
+	while ((matched = std::fscanf(file, "%llu %llx", &step, &hash)) == 2) {
+		if (step != hashes.size()) break;
+		hashes.push_back(hash);
+	}
+	std::fclose(file);
+	if (matched != EOF) {
+		std::fprintf(stderr, "[Headless] malformed hash file %s at step %llu\n",
+			path.c_str(), static_cast<unsigned long long>(hashes.size()));
+		return false;
+	}
+	if (hashes.empty()) {
+		std::fprintf(stderr, "[Headless] hash file %s is empty\n", path.c_str());
+		return false;
+	}
+	return true;
+}
+
+HeadlessReport HeadlessRunner::run(const HeadlessOptions& options)
+{
+	HeadlessReport report;
+	const bool hashing = options.hashState || !options.hashOutput.empty() || !options.hashCheck.empty();
+	std::vector<uint64_t> expected;
+	if (!options.hashCheck.empty()) {
+		// 读不到参考哈希时直接失败，不能当作“全部一致”
+		if (!LoadHashes(options.hashCheck, expected)) {
+			report.hashFileError = true;
+			return report;
+		}
+		report.hashExpected = expected.size();
+	}
+	const bool profiling = !options.profileOutput.empty();
+	if (profiling) {
+		esl::Profiler::setEnabled(true);
+		esl::Profiler::setThreadName("Main");
+		esl::Profiler::resetStats();
+	}
+	std::FILE* hashFile = nullptr;
+	if (!options.hashOutput.empty()) {
+		hashFile = std::fopen(options.hashOutput.c_str(), "w");
+		if (!hashFile) {
+			std::fprintf(stderr, "[Headless] cannot write hash file %s\n", options.hashOutput.c_str());
+		}
+	}
+	esl::InitializeHeadless();
+	if (options.seeded) {
+		MainGame::SetSeed(options.seed);
+	}
+	report.seed = MainGame::Seed();
+	{
+		esl::Window window(1280, 960, "Touhou 18 - UM (headless)", false, false);
+		ScriptSystem scriptSystem;
+		scriptSystem.initDialogueSystem(window);
+		// 无窗口模式下音频引擎不打开设备，音效照常触发但不输出，不依赖声卡
+		scriptSystem.initAudioSystem(window);
+		scriptSystem.preloadSoundEffect("Assets/sound/");
+		MainGame game(window, scriptSystem);
+		game.setStateHashing(hashing, hashFile);
+		esl::NullGL::resetStats();
+		// 加载阶段的分配不计入
+		const bool tracking = options.trackAllocations || options.allocationBudget >= 0;
+		if (tracking) {
+			esl::AllocTracker::reset();
+			if (options.allocationBudget >= 0) {
+				esl::AllocTracker::setBudget(static_cast<uint64_t>(options.allocationBudget), esl::AllocTracker::BudgetMode::Assert);
+			}
+			esl::AllocTracker::setEnabled(true);
+		}
+
+		esl::Event e;
+		esl::Clock clock;
+		uint64_t frame = 0;
+		for (; frame < options.frames; frame++) {
+			if (options.input) {
+				options.input(frame, e);
+				game.process_input(e);
+			}
+			game.update(options.step);
+			if (options.render) {
+				window.setInterpolationAlpha(1.0f);
+				game.render();
+			}
+			if (hashing && frame < expected.size()) {
+				report.hashChecked++;
+				if (report.hashMismatch == UINT64_MAX && game.stateHash() != expected[frame]) {
+					report.hashMismatch = frame;
+				}
+			}
+			if (options.afterStep) {
+				options.afterStep(frame, game);
+			}
+			ESL_PROFILE_FRAME();
+			if (tracking) {
+				report.peakFrameAllocations = std::max(report.peakFrameAllocations, esl::AllocTracker::lastFrame().allocations);
+			}
+			// 关卡结束或返回标题时停止
+			if (game.mSceneInfo.mSwitchToNextScene) {
+				frame++;
+				break;
+			}
+		}
+		report.seconds = clock.getElapsedTime();
+		report.frames = frame;
+		// 记录的步数与实际模拟的步数不同也算不一致，报告第一个缺失或多出的步
+		if (!expected.empty() && expected.size() != frame && report.hashMismatch == UINT64_MAX) {
+			report.hashMismatch = std::min<uint64_t>(expected.size(), frame);
+		}
+		report.finalHash = game.stateHash();
+		if (tracking) {
+			report.allocations = esl::AllocTracker::total().allocations;
+			esl::AllocTracker::writeReport(stdout);
+			esl::AllocTracker::setEnabled(false);
+		}
+		if (profiling) {
+			for (const auto& zone : esl::Profiler::stats()) {
+				printf("[Profile] %*s%-*s avg %.3f  p50 %.3f  p95 %.3f  p99 %.3f  max %.3f ms\n",
+					static_cast<int>(zone.depth * 2), "", 28 - static_cast<int>(zone.depth * 2), zone.name,
+					zone.average, zone.p50, zone.p95, zone.p99, zone.max);
+			}
+			if (esl::Profiler::writeChromeTrace(options.profileOutput)) {
+				printf("[Profile] trace written to %s\n", options.profileOutput.c_str());
+			}
+			esl::Profiler::setEnabled(false);
+		}
+
+		const BulletWorld::Stats& bullets = game.getBulletWorld().stats();
+		report.peakBullets = bullets.peak;
+		report.spawnedBullets = bullets.spawned;
+		report.drawCalls = esl::NullGL::stats().drawCalls;
+		const MainGame::StepTimings& t = game.getStepTimings();
+		if (t.steps > 0) {
+			const double toMs = 1000.0 / static_cast<double>(t.steps);
+			report.enemiesMs = t.enemies * toMs;
+			report.bulletsMs = t.bullets * toMs;
+			report.playerMs = t.player * toMs;
+			report.collisionMs = t.collision * toMs;
+			report.otherMs = t.other * toMs;
+		}
+		scriptSystem.stopAudio();
+	}
+	if (hashFile) {
+		std::fclose(hashFile);
+	}
+	if (report.seconds > 0) {
+		report.framesPerSecond = static_cast<double>(report.frames) / report.seconds;
+	}
+	esl::Terminate();
+	return report;
+}
+
+void HeadlessRunner::print(const HeadlessReport& report)
+{
+	if (report.hashFileError) {
+		printf("[Headless] state hash check FAILED: reference hashes could not be read, nothing was simulated\n");
+		return;
+	}
+	printf("[Headless] frames %llu  seed %u  %.3f s  %.1f fps\n",
+		static_cast<unsigned long long>(report.frames), report.seed, report.seconds, report.framesPerSecond);
+	printf("[Headless] bullets: peak %u  spawned %llu  draw calls %llu\n",
+		report.peakBullets, static_cast<unsigned long long>(report.spawnedBullets),
+		static_cast<unsigned long long>(report.drawCalls));
+	printf("[Headless] ms/step: enemies %.3f  bullets %.3f  player %.3f  collision %.3f  other %.3f\n",
+		report.enemiesMs, report.bulletsMs, report.playerMs, report.collisionMs, report.otherMs);
+	if (report.finalHash != 0) {
+		printf("[Headless] final state hash %016llx\n", static_cast<unsigned long long>(report.finalHash));
+	}
+	if (report.allocations > 0) {
+		printf("[Headless] allocations: %llu total  %.1f per step  peak %llu\n",
+			static_cast<unsigned long long>(report.allocations),
+			report.frames ? static_cast<double>(report.allocations) / static_cast<double>(report.frames) : 0.0,
+			static_cast<unsigned long long>(report.peakFrameAllocations));
+	}
+	if (report.hashExpected > 0) {
+		if (report.hashMismatch == UINT64_MAX) {
+			printf("[Headless] state hashes match for %llu steps\n", static_cast<unsigned long long>(report.hashChecked));
+		}
+		else if (report.hashExpected != report.frames) {
+			printf("[Headless] state hash MISMATCH at step %llu: %llu steps recorded, %llu simulated\n",
+				static_cast<unsigned long long>(report.hashMismatch),
+				static_cast<unsigned long long>(report.hashExpected),
+				static_cast<unsigned long long>(report.frames));
+		}
+		else {
+			printf("[Headless] state hash MISMATCH at step %llu\n", static_cast<unsigned long long>(report.hashMismatch));
+		}
+	}
+}
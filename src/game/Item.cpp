@@ -2,8 +2,11 @@
 #include <cmath>
 #include <Player.h>
 #include <Scene.h>
-// ̬Ա
+#include <StateHash.h>
+#include <ResourceCache.hpp>
+// 静态成员变量定义
 pTexture Item::itemTexture = nullptr;
+std::unique_ptr<esl::SpriteBatch> Item::sBatch = nullptr;
 esl::Window* Item::mRenderer = nullptr;
 std::deque<Item*> Item::mItems;
 const float Item::mAcc = 100.f;
@@ -54,7 +57,10 @@ void Item::init(esl::Window* renderer, Player* player, Data& data)
 	mPlayer = player;
 	mData = &data;
 	if (!itemTexture) {
-		itemTexture = std::make_unique<esl::Texture>(".\\Assets\\bullet\\item.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
+		itemTexture = esl::TextureCache::get(".\\Assets\\bullet\\item.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
+	}
+	if (!sBatch) {
+		sBatch = std::make_unique<esl::SpriteBatch>(256);
 	}
 }
 
@@ -62,6 +68,7 @@ void Item::generate_item(Type type, glm::vec2 pos)
 {
 	Item* item = new Item(type);
 	item->mSprite->setPosition(pos);
+	item->mPrevPos = pos;
 	mItems.push_back(item);
 }
 
@@ -74,6 +81,7 @@ void Item::generate_at_player_death(glm::vec2 pos, glm::vec2 centerPos)
 	for (int i = 0; i < 6; i++) {
 		Item* item = new Item(Type::Power);
 		item->mSprite->setPosition(pos + offsets[i]);
+		item->mPrevPos = pos + offsets[i];
 		item->mMoveToCenter = true;
 		item->mTargetPos = centerPos + offsets[i]; 
 		mItems.push_back(item);
@@ -100,17 +108,21 @@ void Item::generate_items(int num1, int num2, int num3, int num4, int num5, int
 
 void Item::RenderAll()
 {
+	if (!mRenderer || !sBatch) return;
+	// 所有道具共用一张纹理，合并为一次实例化绘制
+	sBatch->begin();
 	for(auto& item : mItems)
 	{
 		item->render();
 	}
+	mRenderer->draw(*sBatch);
 }
 
 void Item::UpdateAll(double delta,float playerPosY)
 {
 	bool allCollect = playerPosY>=collectLineY;
 	for (auto it = mItems.begin(); it != mItems.end(); ) {
-		// ȫȡǿȡ
+		// 如果触发了全收取，则强制收取
 		if (allCollect) {
 			(*it)->isCollected = true;
 		}
@@ -132,7 +144,7 @@ void Item::SetCollectLine(float y)
 
 void Item::cleanup()
 {
-	// δռĵ
+	// 清理所有未收集的道具
 	for (auto* item : mItems) {
 		if (item) {
 			delete item;
@@ -140,28 +152,42 @@ void Item::cleanup()
 	}
 	mItems.clear();
 	
-	// ̬Դ
+	// 清理静态纹理资源
+	sBatch.reset();
 	itemTexture.reset();
 	
-	// þָ̬
+	// 重置静态指针
 	mRenderer = nullptr;
 	mPlayer = nullptr;
 	mData = nullptr;
 }
 
+void Item::HashAll(StateHash& hash)
+{
+	hash.add(static_cast<uint64_t>(mItems.size()));
+	for (auto* item : mItems) {
+		hash.add(item->mType);
+		hash.add(item->mSprite->getPosition());
+		hash.add(item->mSpeed);
+		hash.add(item->isCollected);
+		hash.add(item->mMoveToCenter);
+	}
+}
+
 void Item::update(double delta)
 {
+	mPrevPos = mSprite->getPosition();
 
 	float dist = glm::distance(mPlayer->get_position(), mSprite->getPosition());
 	if (isCollected) {
-		// 
+		// 靠近玩家
 		glm::vec2 direction = glm::normalize(mPlayer->get_position() - mSprite->getPosition());
 		mSprite->move(direction * 600.f * static_cast<float>(delta));
 		if (dist < 8) {
-			// ҳԵ
+			// 被玩家吃掉
 			mSprite->setAvailable(false);
 			Player::getItemSoundEffect();
-			// ƷӦ
+			// 根据物品类型增加相应的属性
 			switch (mType) {
 			case Type::PowerUp:
 				mData->mPlayerPower < 300 ? mData->mPlayerPower += 100 : mData->mPlayerPower = 400;
@@ -193,7 +219,7 @@ void Item::update(double delta)
 	}
 	else {
 		if (this->mMoveToCenter) {
-			// ĵƶ
+			// 向中心点移动
 			glm::vec2 direction = glm::normalize(mTargetPos - mSprite->getPosition());
 			mSprite->move(direction * 300.f * static_cast<float>(delta));
 			float distanceToTarget = glm::distance(mTargetPos, mSprite->getPosition());
@@ -202,10 +228,10 @@ void Item::update(double delta)
 			}
 		}
 		else {
-			// ٶСٶȣ
+			// 如果速度小于最大速度，则加速
 			if (mSpeed < mMaxSpeed)
 				mSpeed += mAcc * static_cast<float>(delta);
-			// ƶ
+			// 否则匀速移动
 			else mSpeed = mMaxSpeed;
 			mSprite->move({ 0,-mSpeed * static_cast<float>(delta) });
 		}
@@ -226,7 +252,7 @@ bool Item::checkAvailable()
 
 void Item::render()
 {
-	if (mRenderer && mSprite) {
-		mRenderer->draw(*mSprite);
+	if (mSprite) {
+		sBatch->add(*mSprite, esl::SpriteBatch::Blend::ALPHA, mSprite->getPosition() - mPrevPos);
 	}
 }
@@ -1,13 +1,14 @@
 #include <Message.h>
+#include <ResourceCache.hpp>
 
 esl::Window* Message::renderer = nullptr;
-esl::Texture* Message::balloon_texture = nullptr;
+std::shared_ptr<esl::Texture> Message::balloon_texture;
 std::deque<Message*> Message::message_queue;
 
 void Message::init(esl::Window& renderer)
 {
 	Message::renderer = &renderer;
-	balloon_texture = new esl::Texture("Assets/face/balloon_1024.png");
+	balloon_texture = esl::TextureCache::get("Assets/face/balloon_1024.png");
 }
 void Message::renderFirst()
 {
@@ -109,13 +110,13 @@ void Message::clearText()
 
 void Message::endEdit()
 {
-	// 궨
+	// 纹理坐标定义
 	int x0 = 0, x1 = 90, x2 = 124;
-	int left_width = x1;           // Ե: 90
-	int middle_width = x2 - x1;    // м䲿ֿ: 34
-	int right_width = 206 - x2;    // ұԵ: 82
+	int left_width = x1;           // 左边缘宽度: 90
+	int middle_width = x2 - x1;    // 中间部分宽度: 34
+	int right_width = 206 - x2;    // 右边缘宽度: 82
 
-	// ıȼҪм䲿
+	// 根据文本长度计算需要的中间部分数量
 	auto len1 = text[0]?text[0]->getLength():0, len2 = text[1]?text[1]->getLength():0;
 	size_t count = len1 > len2 ? len1 : len2;
 
@@ -124,17 +125,17 @@ void Message::endEdit()
 
 	int direction = (role == 1) ? -1 : 1;
 
-	esl::Sprite* left_sprite = new esl::Sprite(balloon_texture);
-	esl::Sprite* right_sprite = new esl::Sprite(balloon_texture);
-	// --- һ֣ʼ (Role 0:/, Role 1:/) ---
+	esl::Sprite* left_sprite = new esl::Sprite(balloon_texture.get());
+	esl::Sprite* right_sprite = new esl::Sprite(balloon_texture.get());
+	// --- 第一部分：起始端 (Role 0:左/尖角, Role 1:右/尖角) ---
 	if (role == 0) {
-		// ģʽǼ (x0-x1)
+		// 正常模式：左边是尖角 (x0-x1)
 		left_sprite->setTextureRect({ rect.x + x0, rect.y }, { left_width, rect.h });
 		left_sprite->setScale({ 1,1 });
 	}
 	else {
-		// Գģʽʼ(ұ)ӦǼ (x0-x1)ˮƽת
-		left_sprite->setTextureRect({ rect.x + x0, rect.y }, { left_width, rect.h }); // Ļ x0
+		// 对称模式：起始点(右边)应该是尖角 (x0-x1)，但水平翻转
+		left_sprite->setTextureRect({ rect.x + x0, rect.y }, { left_width, rect.h }); // 改回 x0
 		left_sprite->setScale({ -1,1 });
 	}
 	
@@ -142,23 +143,23 @@ void Message::endEdit()
 	balloons.push_back(left_sprite);
 	current_x += direction * std::abs(left_sprite->getGlobalSize().x/2);
 
-	// м
+	// 中间
 	for (size_t i = 0; i < count; i++) {
-		esl::Sprite* middle_sprite = new esl::Sprite(balloon_texture);
+		esl::Sprite* middle_sprite = new esl::Sprite(balloon_texture.get());
 		middle_sprite->setTextureRect({ rect.x + x1, rect.y }, { middle_width, rect.h });
 		middle_sprite->setScale({ role?-scale:scale,1 });
 		middle_sprite->setPosition({ current_x, pos.y + y_offset });
 		balloons.push_back(middle_sprite);
 		current_x += direction * std::abs(middle_sprite->getGlobalSize().x);
 	}
-	// --- ֣ (Role 0:/Բ, Role 1:/Բ) ---
+	// --- 第三部分：结束端 (Role 0:右/圆角, Role 1:左/圆角) ---
 	if (role == 1) {
-		// Գģʽ()ӦԲ (x2-End)ˮƽת
-		right_sprite->setTextureRect({ rect.x + x2, rect.y }, { right_width, rect.h }); // Ļ x2
+		// 对称模式：结束点(左边)应该是圆角 (x2-End)，但水平翻转
+		right_sprite->setTextureRect({ rect.x + x2, rect.y }, { right_width, rect.h }); // 改回 x2
 		right_sprite->setScale({ -1,1 });
 	}
 	else {
-		// ģʽұԲ (x2-End)
+		// 正常模式：右边是圆角 (x2-End)
 		right_sprite->setTextureRect({ rect.x + x2, rect.y }, { right_width, rect.h });
 		right_sprite->setScale({ 1,1 });
 	}
@@ -169,10 +170,10 @@ void Message::endEdit()
 	text[1]->setScale({ 0.1,1 });
 	text[0]->setFont(*font);
 	text[1]->setFont(*font);
-	// ޸ģ Role ıλ
+	// 修改：根据 Role 决定文本对齐位置
 	if (role == 1) {
-		//  Role 1ɣcurrent_x ڴ
-		// ıӦô￪ʼ
+		// 对于 Role 1，气泡向左生成，current_x 现在处于气泡最左端
+		// 文本应该从这里开始
 		glm::vec2 textPos = { current_x, pos.y };
 
 		if (text_line_count == 1)
@@ -193,7 +194,7 @@ void Message::render()
 {
 	for (auto& b : balloons)
 	{
-		if (b) {  // Ӽ
+		if (b) {  // 添加检查
 			renderer->draw(*b);
 		}
 		renderer->draw(*b);
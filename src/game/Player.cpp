@@ -1,11 +1,21 @@
 #include <Player.h>
+#include <SpatialGrid.h>
 #include <Enemy.h>
+#include <StateHash.h>
+#include <ResourceCache.hpp>
 
 ScriptSystem* Player::mScriptSystem = nullptr;
 
 void Player::set_position(glm::vec2 pos)
 {
 	mSprite->setPosition(pos);
+	mPrevPos = pos;  // 瞬移不做插值
+}
+
+glm::vec2 Player::renderOffset(float alpha)
+{
+	glm::vec2 pos = mSprite->getPosition();
+	return glm::mix(mPrevPos, pos, alpha) - pos;
 }
 
 glm::vec2 Player::get_position()
@@ -15,7 +25,9 @@ glm::vec2 Player::get_position()
 
 void Player::move(glm::vec2 distance)
 {
-	// ޵״̬²ƶԶԭλ
+	// 每个逻辑步都会调用一次，在移动前记录位置
+	mPrevPos = mSprite->getPosition();
+	// 无敌状态下不可移动，自动复原位置
 	if (mInvincible && mInvincibleTimer > 4.0) return;
 	mSprite->move(distance);
 }
@@ -48,9 +60,26 @@ void Player::hitPlayer(glm::vec2 rebirthPos)
 	if (mPower < 100) mPower = 100;
 }
 
+void Player::hashState(StateHash& hash)
+{
+	hash.add(get_position());
+	hash.add(mDirection);
+	hash.add(static_cast<uint64_t>(mFrame));
+	hash.add(static_cast<uint64_t>(mShootInterval));
+	hash.add(mInvincible);
+	hash.add(mInvincibleTimer);
+	hash.add(mPower);
+	hash.add(mEnableShoot);
+	hash.add(mHyperMode);
+	hash.add(static_cast<uint64_t>(mBullets.size()));
+	for (auto& bullet : mBullets) {
+		hash.add(bullet->getPosition());
+	}
+}
+
 void Reimu::update_bullets(double delta)
 {
-	// ӵ
+	// 子弹更新
 	for (auto& bullet : mBullets) {
 		glm::vec2 bullet_position = bullet->getPosition();
 		if (
@@ -64,7 +93,8 @@ void Reimu::update_bullets(double delta)
 		}
 		bullet->move({ 0,delta * 2000 });
 	}
-	// ʧЧӵ
+	mShotStep = static_cast<float>(delta * 2000);
+	// 清除失效子弹
 	mBullets.erase(
 		std::remove_if(
 			mBullets.begin(),
@@ -86,7 +116,7 @@ void Reimu::update_trace_bullets(double delta)
 		auto& traceBullet = *it;
 		glm::vec2 bulletPos = traceBullet->sprite->getPosition();
 		
-		// Ƿ񳬳Ļ߽
+		// 检查是否超出屏幕边界
 		glm::ivec2 screenSize = mRenderer.getWindowSize();
 		if (bulletPos.x < -32 || bulletPos.x > screenSize.x ||
 			bulletPos.y < -64 || bulletPos.y > screenSize.y) {
@@ -94,13 +124,13 @@ void Reimu::update_trace_bullets(double delta)
 			continue;
 		}
 		
-		// 1. 鵱ǰĿǷȻЧ
+		// 1. 检查当前目标是否仍然有效
 		if (traceBullet->hasTarget && !isTargetValid(traceBullet->target)) {
 			traceBullet->hasTarget = false;
 			traceBullet->target = nullptr;
 		}
 		
-		// 2. ûĿ꣬ѰĿ
+		// 2. 如果没有目标，寻找新目标
 		if (!traceBullet->hasTarget) {
 			traceBullet->target = findNearestEnemy(bulletPos);
 			if (traceBullet->target) {
@@ -108,33 +138,34 @@ void Reimu::update_trace_bullets(double delta)
 			}
 		}
 		
-		// 3. ǷĿٶȷ
+		// 3. 根据是否有目标来更新速度方向
 		if (traceBullet->hasTarget && traceBullet->target) {
-			// Ŀ꣺׷Ŀ
+			// 有目标：追踪目标
 			glm::vec2 targetPos = traceBullet->target->getSprite()->getPosition();
 			glm::vec2 toTarget = glm::normalize(targetPos - bulletPos);
 			
-			// ʹòֵƽת򣬱ڼת
+			// 使用插值平滑转向，避免过于急剧的转向
 			float lerpFactor = traceBullet->rotateSpeed * static_cast<float>(delta);
-			lerpFactor = std::min(lerpFactor, 1.0f); // תٶ
+			lerpFactor = std::min(lerpFactor, 1.0f); // 限制最大转向速度
 			
-			// µٶȷ
+			// 计算新的速度方向
 			glm::vec2 newVelocity = glm::normalize(
 				traceBullet->velocity * (1.0f - lerpFactor) + toTarget * lerpFactor
 			);
 			traceBullet->velocity = newVelocity;
 		} else {
-			// Ŀ꣺ֵǰǰƶ
-			// ٶȷ򲻱䣬ԭƶ
+			// 无目标：保持当前方向（向前移动）
+			// 速度方向不变，继续按原方向移动
 		}
 		
-		// 4. λ
+		// 4. 更新位置
 		glm::vec2 movement = traceBullet->velocity * traceBullet->speed * static_cast<float>(delta);
 		traceBullet->sprite->move(movement);
+		traceBullet->lastMove = movement;
 		
-		// 5. ¾תӵƶ
+		// 5. 更新精灵旋转（让子弹朝向移动方向）
 		float angle = atan2(traceBullet->velocity.y, traceBullet->velocity.x) * 180.0f / 3.14159f;
-		traceBullet->sprite->setRotation(angle + 90.0f); // +90ȵ鳯
+		traceBullet->sprite->setRotation(angle + 90.0f); // +90度调整精灵朝向
 		
 		++it;
 	}
@@ -145,30 +176,40 @@ Enemy* Reimu::findNearestEnemy(glm::vec2 bulletPos)
 	if (!mEnemyList || mEnemyList->empty()) {
 		return nullptr;
 	}
-	
+
+	glm::ivec2 screenSize = mRenderer.getWindowSize();
+	auto canTrack = [&](Enemy* enemy) {
+		if (!enemy || !enemy->mSpriteAvailable || enemy->mEnemyType == Enemy::EnemyType::EMITTER) {
+			return false;
+		}
+		// 只追踪屏幕内的敌机
+		glm::vec2 enemyPos = enemy->getSprite()->getPosition();
+		return enemyPos.x >= 0 && enemyPos.x <= screenSize.x &&
+			enemyPos.y >= 0 && enemyPos.y <= screenSize.y;
+	};
+
+	// 有网格时由近到远逐圈搜索
+	if (mEnemyGrid && mEnemyGrid->size() > 0) {
+		int64_t index = mEnemyGrid->nearest(bulletPos, [&](uint32_t i) {
+			return i < mEnemyList->size() && canTrack((*mEnemyList)[i]);
+		});
+		return index >= 0 ? (*mEnemyList)[index] : nullptr;
+	}
+
 	Enemy* nearestEnemy = nullptr;
 	float nearestDistance = std::numeric_limits<float>::max();
-	
+
 	for (Enemy* enemy : *mEnemyList) {
-		if (!enemy || !enemy->mSpriteAvailable || enemy->mEnemyType == Enemy::EnemyType::EMITTER) {
+		if (!canTrack(enemy)) {
 			continue;
 		}
-		
-		glm::vec2 enemyPos = enemy->getSprite()->getPosition();
-		float distance = glm::length(enemyPos - bulletPos);
-		
-		// ֻ׷Ļڵĵл
-		glm::ivec2 screenSize = mRenderer.getWindowSize();
-		if (enemyPos.x >= 0 && enemyPos.x <= screenSize.x &&
-			enemyPos.y >= 0 && enemyPos.y <= screenSize.y) {
-			
-			if (distance < nearestDistance) {
-				nearestDistance = distance;
-				nearestEnemy = enemy;
-			}
+		float distance = glm::length(enemy->getSprite()->getPosition() - bulletPos);
+		if (distance < nearestDistance) {
+			nearestDistance = distance;
+			nearestEnemy = enemy;
 		}
 	}
-	
+
 	return nearestEnemy;
 }
 
@@ -178,13 +219,13 @@ bool Reimu::isTargetValid(Enemy* target)
 		return false;
 	}
 	
-	// ĿǷڵлбҿ
+	// 检查目标是否还在敌机列表中且可用
 	auto it = std::find(mEnemyList->begin(), mEnemyList->end(), target);
 	if (it == mEnemyList->end() || !target->mHitable) {
 		return false;
 	}
 	
-	// ĿǷĻΧڣһ
+	// 检查目标是否还在屏幕范围内（给一定缓冲区域）
 	glm::vec2 enemyPos = target->getSprite()->getPosition();
 	glm::ivec2 screenSize = mRenderer.getWindowSize();
 	
@@ -194,23 +235,23 @@ bool Reimu::isTargetValid(Enemy* target)
 
 Reimu::Reimu(esl::Window& renderer, unsigned int& power) :mRenderer(renderer), Player(power)
 {
-	mTexture = std::make_unique<esl::Texture>(".\\Assets\\player\\reimu.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
-	mSlowEffectTexture = std::make_unique<esl::Texture>(".\\Assets\\effect\\eff_sloweffect.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
+	mTexture = esl::TextureCache::get(".\\Assets\\player\\reimu.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
+	mSlowEffectTexture = esl::TextureCache::get(".\\Assets\\effect\\eff_sloweffect.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
 	for (int i = 0; i < 8; i++) {
 		mRect[i]={ i*32,48*2 };
 	}
-	// 
+	// 左移
 	mRect[8]={ 7 * 32,48 * 1 };
-	// 
+	// 右移
 	mRect[9]={ 7 * 32,48 * 0 };
 	mSprite = std::make_unique<esl::Sprite>(mTexture.get());
 	mSprite->setTextureRect(mRect[0],{32,48});
 	mSprite->setScale({ 2,2 });
-	// ӵ
+	// 子弹加载
 	std::string bullet_dir_path = "Assets\\bullet\\reimu\\";
 	for (int i = 0; i < 11; i++) {
 		std::string path = bullet_dir_path + std::to_string(i + 1);
-		this->mBulletTextures.push_back(std::make_unique<esl::Texture>(path + ".png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST));
+		this->mBulletTextures.push_back(esl::TextureCache::get(path + ".png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST));
 	}
 	mSlowEffectSprite = std::make_unique<esl::Sprite>(mSlowEffectTexture.get());
 	mSlowEffectSprite->setTextureRect({ 0,0 }, { 64,64 });
@@ -218,19 +259,19 @@ Reimu::Reimu(esl::Window& renderer, unsigned int& power) :mRenderer(renderer), P
 	mMissRadius = 3*2;
 	mSlowEffectSprite->setPosition(mSprite->getPosition());
 
-	mYinYangOrbTexture = std::make_unique<esl::Texture>(".\\Assets\\bullet\\reimu\\9.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
+	mYinYangOrbTexture = esl::TextureCache::get(".\\Assets\\bullet\\reimu\\9.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
 	mYinYangOrbs.resize(1);
 	mYinYangOrbs[0] = std::make_unique<esl::Sprite>(mYinYangOrbTexture.get());
 	mYinYangOrbs[0]->setScale({1.5,1.5});
 	mYinYangOrbs[0]->setPosition(mSprite->getPosition()+glm::vec2{0,-72});
 	
-	// ׷ٵ
-	mTraceBulletTexture = std::make_unique<esl::Texture>(".\\Assets\\bullet\\reimu\\trace.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
+	// 追踪弹纹理加载
+	mTraceBulletTexture = esl::TextureCache::get(".\\Assets\\bullet\\reimu\\trace.png", esl::Texture::Wrap::CLAMP_TO_EDGE, esl::Texture::Filter::NEAREST);
 }
 
 void Reimu::update(double delta)
 {
-	// ɫ
+	// 角色动画更新
 	mFrame++;
 	if(mInvincible){
 		mInvincibleTimer -= delta;
@@ -262,39 +303,39 @@ void Reimu::update(double delta)
 		}
 	}
 	mSprite->setTextureRect(mRect[mSpriteIndex],{32,48});
-	// ӵ
+	// 射击子弹
 	this->shoot();
 	
-	// ͨӵ
+	// 更新普通子弹
 	update_bullets(delta);
 	
-	// ׷ٵ
+	// 更新追踪弹
 	update_trace_bullets(delta);
 
 	mSlowEffectSprite->setPosition(mSprite->getPosition());
 	mSlowEffectSprite->setRotation(mSlowEffectSprite->getRotation() + 1);
 
-	// ̬
+	// 动态调整阴阳玉数量
 	size_t requiredOrbs = mPower / 100;
 	if (requiredOrbs > mYinYangOrbs.size()) {
-		// ҪӸ
+		// 需要添加更多阴阳玉
 		while (mYinYangOrbs.size() < requiredOrbs) {
 			mYinYangOrbs.push_back(std::make_unique<esl::Sprite>(mYinYangOrbTexture.get()));
 			mYinYangOrbs.back()->setScale({ 1.5,1.5 });
 		}
 	}
-	// 񶯻λø
+	// 阴阳玉动画和位置更新
 	glm::vec2 playerPos = mSprite->getPosition();
 	for (size_t i = 0; i < requiredOrbs && i < mYinYangOrbs.size(); i++) {
-		// ˮƽƫƣУ36px
-		float totalWidth = (requiredOrbs - 1) * 36.0f;  // ܿ
-		float startX = -totalWidth / 2.0f;              // ʼXƫ
-		float offsetX = startX + i * 36.0f;             // ǰXƫ
+		// 计算水平偏移：居中排列，间隔36px
+		float totalWidth = (requiredOrbs - 1) * 36.0f;  // 总宽度
+		float startX = -totalWidth / 2.0f;              // 起始X偏移
+		float offsetX = startX + i * 36.0f;             // 当前阴阳玉的X偏移
 		mYinYangOrbs[i]->setPosition(playerPos + glm::vec2{ offsetX, -72 });
 		mYinYangOrbs[i]->setRotation(mYinYangOrbs[i]->getRotation() + 4);
 	}
 
-	// 
+	// 更新阴阳玉计数
 	mYinYangOrbCount = requiredOrbs;
 
 	mDeathCircle.update(delta);
@@ -302,7 +343,7 @@ void Reimu::update(double delta)
 
 void Reimu::shoot()
 {
-	// ֡
+	// 射击间隔帧
 	mShootInterval++;
 	if (!mEnableShoot) return;
 	if (mShootInterval < 4) return;
@@ -321,7 +362,7 @@ void Reimu::shoot()
 		bullet->setScale({ 2,2 });
 		mBullets.push_back(std::move(bullet));
 		
-		// ÿ׷ٵ
+		// 从每个阴阳玉发射追踪弹
 		for (int i = 0; i < mYinYangOrbCount; i++) {
 			auto traceBullet = std::make_unique<TraceBullet>(mTraceBulletTexture, mYinYangOrbs[i]->getPosition());
 			mTraceBullets.push_back(std::move(traceBullet));
@@ -355,24 +396,47 @@ void Reimu::shoot()
 
 void Reimu::render()
 {
-	// ƽɫ
+	// 角色与阴阳玉按插值位置绘制，绘制后恢复
+	glm::vec2 offset = renderOffset(mRenderer.getInterpolationAlpha());
+	// 绘制角色
+	mSprite->move(offset);
 	mRenderer.draw(*mSprite.get());
-	// ͨӵ
+	mSprite->move(-offset);
+	// 普通子弹与追踪弹合并为实例化绘制
+	mShotBatch.begin();
 	for (auto& bullet : mBullets) {
-		mRenderer.draw(*bullet.get());
+		mShotBatch.add(*bullet.get(), esl::SpriteBatch::Blend::ALPHA, { 0, mShotStep });
 	}
-	// ׷ٵ
 	for (auto& traceBullet : mTraceBullets) {
-		mRenderer.draw(*traceBullet->sprite.get());
+		mShotBatch.add(*traceBullet->sprite.get(), esl::SpriteBatch::Blend::ALPHA, traceBullet->lastMove);
 	}
-	// 
+	mRenderer.draw(mShotBatch);
+	// 绘制阴阳玉
 	for(int i=0;i<mPower/100 && i<mYinYangOrbs.size();i++){
+		mYinYangOrbs[i]->move(offset);
 		mRenderer.draw(*mYinYangOrbs[i].get());
+		mYinYangOrbs[i]->move(-offset);
 	}
 	mDeathCircle.draw(mRenderer);
 }
 
 void Reimu::slowEffectRender()
 {
-	if (!mHyperMode) mRenderer.draw(*mSlowEffectSprite.get());
+	if (!mHyperMode) {
+		glm::vec2 offset = renderOffset(mRenderer.getInterpolationAlpha());
+		mSlowEffectSprite->move(offset);
+		mRenderer.draw(*mSlowEffectSprite.get());
+		mSlowEffectSprite->move(-offset);
+	}
+}
+
+void Reimu::hashState(StateHash& hash)
+{
+	Player::hashState(hash);
+	hash.add(static_cast<uint64_t>(mTraceBullets.size()));
+	for (auto& bullet : mTraceBullets) {
+		hash.add(bullet->sprite->getPosition());
+		hash.add(bullet->velocity);
+		hash.add(bullet->hasTarget);
+	}
 }
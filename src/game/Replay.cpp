@@ -0,0 +1,139 @@
+﻿#include <Replay.h>
+#include <fstream>
+#include <iostream>
+
+namespace {
+	const char MAGIC[4] = { 'T', 'H', 'R', 'P' };
+
+	struct KeyBit {
+		Keyboard::KeyCode key;
+		uint8_t bit;
+	};
+	const KeyBit KEY_BITS[] = {
+		{ Keyboard::KEY_UP, Replay::INPUT_UP },
+		{ Keyboard::KEY_DOWN, Replay::INPUT_DOWN },
+		{ Keyboard::KEY_LEFT, Replay::INPUT_LEFT },
+		{ Keyboard::KEY_RIGHT, Replay::INPUT_RIGHT },
+		{ Keyboard::KEY_LEFT_SHIFT, Replay::INPUT_SLOW },
+		{ Keyboard::KEY_Z, Replay::INPUT_SHOT },
+		{ Keyboard::KEY_X, Replay::INPUT_BOMB },
+		{ Keyboard::KEY_ESCAPE, Replay::INPUT_PAUSE },
+	};
+
+	template<typename T>
+	void writeValue(std::ostream& out, T value) {
+		for (size_t i = 0; i < sizeof(T); i++) {
+			out.put(static_cast<char>((value >> (i * 8)) & 0xFF));
+		}
+	}
+	template<typename T>
+	bool readValue(std::istream& in, T& value) {
+		value = 0;
+		for (size_t i = 0; i < sizeof(T); i++) {
+			int c = in.get();
+			if (c == EOF) return false;
+			value |= static_cast<T>(static_cast<uint8_t>(c)) << (i * 8);
+		}
+		return true;
+	}
+	void writeVarint(std::ostream& out, uint32_t value) {
+		while (value >= 0x80) {
+			out.put(static_cast<char>((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+		out.put(static_cast<char>(value));
+	}
+	bool readVarint(std::istream& in, uint32_t& value) {
+		value = 0;
+		for (int shift = 0; shift < 35; shift += 7) {
+			int c = in.get();
+			if (c == EOF) return false;
+			value |= static_cast<uint32_t>(c & 0x7F) << shift;
+			if (!(c & 0x80)) return true;
+		}
+		return false;
+	}
+}
+
+uint8_t Replay::capture(esl::Event& e)
+{
+	uint8_t input = 0;
+	for (const KeyBit& k : KEY_BITS) {
+		if (e.isKeyPressed(k.key)) input |= k.bit;
+	}
+	return input;
+}
+
+void Replay::apply(uint8_t input, esl::Event& e)
+{
+	for (const KeyBit& k : KEY_BITS) {
+		e.setKeyState(k.key, (input & k.bit) ? Keyboard::PRESS : Keyboard::RELEASE);
+	}
+}
+
+void Replay::clear()
+{
+	mSeed = 0;
+	mInputs.clear();
+}
+
+bool Replay::save(const std::string& path) const
+{
+	std::ofstream out(path, std::ios::binary);
+	if (!out) {
+		std::cerr << "Failed to write replay: " << path << std::endl;
+		return false;
+	}
+	out.write(MAGIC, sizeof(MAGIC));
+	writeValue<uint16_t>(out, VERSION);
+	writeValue<uint32_t>(out, mSeed);
+	writeValue<uint32_t>(out, static_cast<uint32_t>(mInputs.size()));
+	// 按键状态通常持续很多步，行程编码后一局只有几 KB
+	for (size_t i = 0; i < mInputs.size();) {
+		size_t run = 1;
+		while (i + run < mInputs.size() && mInputs[i + run] == mInputs[i]) run++;
+		out.put(static_cast<char>(mInputs[i]));
+		writeVarint(out, static_cast<uint32_t>(run));
+		i += run;
+	}
+	return static_cast<bool>(out);
+}
+
+bool Replay::load(const std::string& path)
+{
+	std::ifstream in(path, std::ios::binary);
+	if (!in) {
+		std::cerr << "Failed to open replay: " << path << std::endl;
+		return false;
+	}
+	char magic[4] = {};
+	uint16_t version = 0;
+	uint32_t seed = 0, count = 0;
+	in.read(magic, sizeof(magic));
+	if (!in || std::string(magic, 4) != std::string(MAGIC, 4) ||
+		!readValue(in, version) || version != VERSION ||
+		!readValue(in, seed) || !readValue(in, count)) {
+		std::cerr << "Invalid replay file: " << path << std::endl;
+		return false;
+	}
+	// 行程编码下几个字节就能表示任意多步，文件大小限制不住步数，
+	// 按录像长度上限校验后再分配，损坏的文件不会触发巨大的分配
+	if (count > MAX_STEPS) {
+		std::cerr << "Corrupted replay file: " << path << " (" << count << " steps)" << std::endl;
+		return false;
+	}
+	std::vector<uint8_t> inputs;
+	inputs.reserve(count);
+	while (inputs.size() < count) {
+		int input = in.get();
+		uint32_t run = 0;
+		if (input == EOF || !readVarint(in, run) || run == 0 || run > count - inputs.size()) {
+			std::cerr << "Corrupted replay file: " << path << std::endl;
+			return false;
+		}
+		inputs.insert(inputs.end(), run, static_cast<uint8_t>(input));
+	}
+	mSeed = seed;
+	mInputs = std::move(inputs);
+	return true;
+}
@@ -1,6 +1,12 @@
 #include <Scene.h>
-#include <BulletPool.h>  //  BulletPool ͷļ
 #include <Item.h>
+#include <GpuProfiler.hpp>
+#include <AllocTracker.hpp>
+#include <ResourceCache.hpp>
+
+uint32_t MainGame::sSeed = std::random_device{}();
+std::mt19937 MainGame::sRandom(MainGame::sSeed);
+uint64_t MainGame::sRandomDraws = 0;
 
 void Scene::process_input(esl::Event& e)
 {
@@ -18,15 +24,15 @@ TitleScene::TitleScene(esl::Window& renderer, ScriptSystem& system) :Scene(syste
 {
 
 	glm::ivec2 renderPos = renderer.getWindowSize();
-	mTitleBackTexture = std::make_unique<esl::Texture>(".\\Assets\\title\\title_bk01.png");
+	mTitleBackTexture = esl::TextureCache::get(".\\Assets\\title\\title_bk01.png");
 	mTitleBackgroundSprite = std::make_unique<esl::Sprite>(mTitleBackTexture.get());
 	mTitleBackgroundSprite->setPosition(renderPos / 2);
 	std::string selections[4] = { "Game_Start.png","MusicRoom.png","Option.png","Quit.png" };
-	// ѡʼ
+	// 选项初始化
 	for (int i = 0; i < 4; i++) {
 		std::string path = ".\\Assets\\title\\selecttitle\\" + selections[i];
 		
-		mMenuSelectionTextures.push_back(std::make_unique<esl::Texture>(path));
+		mMenuSelectionTextures.push_back(esl::TextureCache::get(path));
 		mMenuSelections.push_back(std::make_unique<esl::Sprite>(mMenuSelectionTextures[i].get()));
 		mMenuSelections[i]->setScale({ 0.25,0.25 });
 		mMenuSelections[i]->setColor(glm::vec4{ 0.6,0.6,0.6,1 });
@@ -39,10 +45,10 @@ TitleScene::TitleScene(esl::Window& renderer, ScriptSystem& system) :Scene(syste
 void TitleScene::process_input(esl::Event& e)
 {
 	
-	// Ƿ¼
+	// 是否允许处理键盘事件
 	if (mSelectRespond) {
-		// Event 1: ȴ¼ mSelectIndex
-		// òֵڼ¼һ֡ǷѾ¼ֹʱδ
+		// Event 1: 先处理上下键和 mSelectIndex
+		// 该布尔值用于记录上一次帧是否已经按下了上下键，防止长按时多次触发
 		static bool key_pressed_last_frame = false;
 		if (e.isKeyPressed(Keyboard::KEY_UP) && !key_pressed_last_frame) {
 			mSelectIndex+=3;
@@ -59,11 +65,11 @@ void TitleScene::process_input(esl::Event& e)
 			key_pressed_last_frame = false;
 		}
 		
-		// Event 2: Zѡ
+		// Event 2: Z键选择
 		if (e.isKeyPressed(Keyboard::KEY_Z)) {
-			// ѡкֹ¼
+			// 选中后禁止处理键盘事件
 			mSelectRespond = false;
-			// óлϢ
+			// 设置场景切换信息
 			mSceneInfo.mSwitchToNextScene = true;
 			mSceneInfo.mSwitchToSceneIndex = mSelectIndex;
 		}
@@ -83,7 +89,7 @@ void TitleScene::render()
 
 void TitleScene::update(double deltaTime)
 {
-	// ÿһ֡ɫֹڴ޸indexʵʻƲͬ
+	// 每一帧重置颜色防止内存修改造成index与实际绘制不同
 	for (int i = 0; i < 4; i++) {
 		mMenuSelections[i]->setColor(glm::vec4{ 0.6,0.6,0.6,1 });
 	}
@@ -93,27 +99,28 @@ void TitleScene::update(double deltaTime)
 MainGame::MainGame(esl::Window& render, ScriptSystem& system) :Scene(system), mRenderer(render)
 {
 	mFront = new Front(mRenderer);
-	// 1ʼ̬Դʵģ
+	// 步骤1：初始化静态资源（不依赖实例的）
 	Background3D::init(&mRenderer, mCenterPos);
 	Enemy::init(&mRenderer);
 	Enemy::setSystem(&mScriptSystem);
-	Bullet_1::init();  // Ԥ֮ǰ
+	Enemy::setBulletWorld(&mBulletWorld);
+	mBulletWorld.setJobSystem(&mJobs);
+	Bullet::init();
 	Bullet::initEtBreak();
 	Player::setSystem(&mScriptSystem);
 
-	// 2Ԥ
-	BulletPoolHelper::preallocateBullets(3000, render);
-	mAllEnemyBullets.reserve(3000);
+	// 步骤2：子弹存储按关卡预留，见 setupStage
 
-	// 3 Player ʵ
+	// 步骤3：创建 Player 实例
 	mPlayer = std::make_unique<Reimu>(mRenderer, mData.mPlayerPower);
 	mPlayer->set_position(Position());
 	mPlayer->setEnemyList(&mEnemys);
+	mPlayer->setEnemyGrid(&mEnemyGrid);
 
-	// 4ʼ Player ϵͳ mPlayer Ѿڣ
+	// 步骤4：初始化依赖 Player 的系统（现在 mPlayer 已经存在）
 	Item::init(&mRenderer, mPlayer.get(), mData);
 
-	// 5ʼ
+	// 步骤5：其他初始化
 	mScriptSystem.setCenterPos(mCenterPos);
 	
 	mBackground = new Stage01_Background();
@@ -128,26 +135,24 @@ MainGame::MainGame(esl::Window& render, ScriptSystem& system) :Scene(system), mR
 	//mBlurEffect.setColor(glm::vec4{0,0,0,0});
 	
 	
-	// ײĻص
+	// 设置碰撞管理器的回调函数
 	mCollisionManager.setEnemyBulletHitPlayerCallback([this]() {
 		if (mPlayer->isInvincible()) return;
 		if (mData.mPlayerLife > 0) {
 			mData.mPlayerLife--;
 			Item::generate_at_player_death(mPlayer->get_position(), Position({0,450}));
 			mPlayer->hitPlayer(Position({0,-128}));
-			// ǰĻеӵ
-			for (auto& enemy : mEnemys) {
-				enemy->clearBullets();
-			}
+			// 清除当前屏幕所有敌人子弹
+			Bullet::clearWithEffect(mBulletWorld);
 			
 		}
 	});
-	// ص
+	// 擦弹回调
 	mCollisionManager.setPlayerGrazeEnemyBulletCallback([this]() {
 		mData.mPlayerScore += 1;
 		mScriptSystem.playSoundEffect("se_graze.wav");
 	});
-	// лص
+	// 命中回调
 	mCollisionManager.setPlayerBulletHitEnemyCallback([this]() {
 		mData.mPlayerScore += 10;
 	});
@@ -159,18 +164,31 @@ MainGame::MainGame(esl::Window& render, ScriptSystem& system) :Scene(system), mR
 	
 }
 
+void MainGame::buildEnemyGrid()
+{
+	mEnemyX.resize(mEnemys.size());
+	mEnemyY.resize(mEnemys.size());
+	for (size_t i = 0; i < mEnemys.size(); i++) {
+		glm::vec2 pos = mEnemys[i]->getSprite()->getPosition();
+		mEnemyX[i] = pos.x;
+		mEnemyY[i] = pos.y;
+	}
+	mEnemyGrid.build(mEnemyX.data(), mEnemyY.data(), nullptr, mEnemys.size());
+}
+
 MainGame::~MainGame()
 {
-	// 1. е˶󣨰еӵ
+	// 1. 先停止子弹渲染线程，再清空子弹（子弹记录着归属的敌人），然后清理所有敌人对象
+	mBulletRender.stop();
+	mBulletWorld.clear();
 	for (auto* enemy : mEnemys) {
 		if (enemy) {
-			delete enemy;  // EnemymBullets
+			delete enemy;
 		}
 	}
 	mEnemys.clear();
-	mAllEnemyBullets.clear();  // ָʵʶѱEnemy
 
-	// 2. ԭָ
+	// 2. 清理原生指针对象
 	if (mFront) {
 		delete mFront;
 		mFront = nullptr;
@@ -180,22 +198,19 @@ MainGame::~MainGame()
 		mBackground = nullptr;
 	}
 
-	// 3. أͷԤӵ
-	BulletPool::getInstance().clear();
-	
-	// 4. ̬Դ߶ȣ
+	// 3. 清理静态道具资源（道具对象、纹理等）
 	Item::cleanup();
 	
-	// 5. ӵ̬Դȣ
-	Bullet_1::cleanup();
+	// 4. 清理子弹静态资源（纹理、外观表等）
+	Bullet::cleanup();
 	
-	// 6. ӵЧԴ
+	// 5. 清理子弹特效资源
 	Bullet::cleanupEtBreak();
 	
-	// 7. ˾̬ԴHPȣ
+	// 6. 清理敌人静态资源（HP条纹理等）
 	Enemy::cleanup();
 	
-	// 8. ̬Դ
+	// 7. 清理背景静态资源
 	Background3D::cleanup();
 
 
@@ -206,11 +221,11 @@ void MainGame::process_input(esl::Event& e)
 	handleGlobalInput(e);
 
 	if (mPause) {
-		// Pauseʱ
+		// 处理Pause时的输入
 		handlePauseInput(e);
 	}
 	else {
-		// Pauseʱ
+		// 处理非Pause时的输入
 		handleGameplayInput(e);
 	}
 }
@@ -218,28 +233,48 @@ void MainGame::process_input(esl::Event& e)
 void MainGame::render()
 {
 	
+	ESL_PROFILE_ZONE("MainGame::render");
 	mRenderer.clear();
 	if (mSwitchEffectEnabled) {
 		mSwitchScreenAnimation.draw(mRenderer);
 		
 	}
 	else {
-		mBackground->render();
-		for (auto& enemy : mEnemys) {
-			enemy->render();
+		// 每个阶段同时记录 CPU 提交耗时与 GPU 执行耗时（"GPU " 前缀）
+		{
+			ESL_PROFILE_GPU_ZONE("Render background");
+			mBackground->render();
 		}
-		Bullet::drawEtBreaks(mRenderer);
-		mPlayer->render();
-		Item::RenderAll();
-
-		mDeathCircle.draw(mRenderer);
-
-		mScriptSystem.render();
+		{
+			ESL_PROFILE_GPU_ZONE("Render enemies and bullets");
+			for (auto& enemy : mEnemys) {
+				enemy->render();
+			}
+			Bullet::render(mRenderer, mBulletRender.latest());
+			Bullet::drawEtBreaks(mRenderer);
+		}
+		{
+			ESL_PROFILE_GPU_ZONE("Render player");
+			mPlayer->render();
+		}
+		{
+			ESL_PROFILE_GPU_ZONE("Render items");
+			Item::RenderAll();
 
-		mPlayer->slowEffectRender();
+			mDeathCircle.draw(mRenderer);
+		}
+		{
+			ESL_PROFILE_GPU_ZONE("Render dialogue");
+			mScriptSystem.render();
+		}
+		{
+			ESL_PROFILE_GPU_ZONE("Render HUD (remaining)");
+			mPlayer->slowEffectRender();
 
-		mFront->renderRemaining();
+			mFront->renderRemaining();
+		}
 		if (mPause) {
+			ESL_PROFILE_GPU_ZONE("Render pause blur");
 			if (!mBlurredScreenReady) {
 				mBlurEffect.setIterations(2);
 				mBlurEffect.setSpread(5.f);
@@ -252,18 +287,26 @@ void MainGame::render()
 			mRenderer.draw(mBlurEffect);
 			mPauseMenu.draw(mRenderer);
 		}
-		mFront->render();
+		{
+			ESL_PROFILE_GPU_ZONE("Render HUD (front)");
+			mFront->render();
+		}
 	}
-	
+	mRenderer.draw(mProfilerOverlay);
+
+	ESL_PROFILE_ZONE("Present");
 	mRenderer.display();
 
 }
 
 void MainGame::setupStage() {
 	mScriptSystem.nextAudio();
-	// ȴ 3 
+	// 本关卡同屏子弹最多约 3000 颗，一次性预留，避免战斗中扩容
+	mBulletWorld.reserve(3000);
+	mBulletWorld.resetStats();
+	// 等待 3 秒
 	mStage.addWait(3.0);
-	// Wave 1: 10Enemy,ƶ1뷢价εĻ
+	// Wave 1: 生成10Enemy,移动，间隔1秒发射环形弹幕
 	mStage.addAction([this](MainGame* game) {
 		for (int i = 0; i < 10; i++) {
 			EnemyUnit* enemy = new EnemyUnit(EnemyUnit::NormalType::TYPE3, { LEFT - 48,600 }, 50);
@@ -300,7 +343,7 @@ void MainGame::setupStage() {
 	}
 	);
 	mStage.addWait(5.0);
-	// Wave 2: 10Enemy,ƶ1뷢价εĻ
+	// Wave 2: 生成10Enemy,移动，间隔1秒发射环形弹幕
 	mStage.addAction([this](MainGame* game) {
 		for (int i = 0; i < 10; i++) {
 			EnemyUnit* enemy = new EnemyUnit(EnemyUnit::NormalType::TYPE3, { RIGHT + 48,600 }, 50);
@@ -380,19 +423,19 @@ void MainGame::setupStage() {
 
 	
 	mStage.addWait(5.0);
-	// Ի
+	// 开场对话
 	mStage.addAction(
 		[this](MainGame* game) {
 			mScriptSystem.activateDialogueSection("opening");
 		}
 	);
-	// ȴԻ
+	// 等待对话结束
 	mStage.addWaitUntil([this]() {
 		return !mScriptSystem.mDialogueActived;  
 		});
 	Boss* boss = new Boss(1, 10000, Position({ 700,900 }));
 	boss->setBonus(0, 16, 0, 0, 0, 0, 64, 64);
-	//  Boss
+	// 生成 Boss
 	mStage.addAction([this,boss](MainGame* game) {
 		boss->addAction(
 			LinearMovement()
@@ -465,7 +508,7 @@ void MainGame::setupStage() {
 		}
 	);
 	mStage.addWaitUntil([this]() {
-		return !mScriptSystem.mDialogueActived;  // ȴԻ
+		return !mScriptSystem.mDialogueActived;  // 等待对话结束
 	});
 	
 	
@@ -480,7 +523,7 @@ void MainGame::setupStage() {
 		}
 	);
 	mStage.addWaitUntil([this]() {
-		return !mScriptSystem.mDialogueActived;  // ȴԻ
+		return !mScriptSystem.mDialogueActived;  // 等待对话结束
 		});
 	mStage.addAction(
 		[this](MainGame* game) {
@@ -491,8 +534,79 @@ void MainGame::setupStage() {
 	mStage.start(this);
 }
 void MainGame::update(double deltaTime)
+{
+	ESL_PROFILE_ZONE("MainGame::update");
+	ESL_ALLOC_BUDGET("MainGame::update");
+	simulate(deltaTime);
+	if (mStateHashing) {
+		ESL_PROFILE_ZONE("State hash");
+		mStateHash = computeStateHash();
+		if (mHashStream) {
+			fprintf(mHashStream, "%llu %016llx\n",
+				static_cast<unsigned long long>(mHashedSteps), static_cast<unsigned long long>(mStateHash));
+		}
+		mHashedSteps++;
+	}
+}
+
+void MainGame::setStateHashing(bool enabled, std::FILE* stream)
+{
+	mStateHashing = enabled;
+	mHashStream = enabled ? stream : nullptr;
+	mHashedSteps = 0;
+}
+
+uint64_t MainGame::computeStateHash()
+{
+	StateHash hash;
+	// 子弹：只取参与模拟的列，mPrevX/mPrevY 与 mRotation 只影响绘制
+	hash.add(mBulletWorld.mX);
+	hash.add(mBulletWorld.mY);
+	hash.add(mBulletWorld.mVelX);
+	hash.add(mBulletWorld.mVelY);
+	hash.add(mBulletWorld.mRadius);
+	hash.add(mBulletWorld.mGrazeTimer);
+	hash.add(mBulletWorld.mAngle);
+	hash.add(mBulletWorld.mSpeed);
+	hash.add(mBulletWorld.mLifetime);
+	hash.add(mBulletWorld.mStyle);
+	hash.add(mBulletWorld.mProgram);
+	hash.add(mBulletWorld.mPc);
+	hash.add(mBulletWorld.mOpTime);
+	hash.add(mBulletWorld.mFlags);
+
+	hash.add(static_cast<uint64_t>(mEnemys.size()));
+	for (Enemy* enemy : mEnemys) {
+		hash.add(enemy->mEnemyType);
+		hash.add(enemy->getPosition());
+		hash.add(enemy->getHP());
+		hash.add(enemy->mLiveBullets);
+		hash.add(enemy->mSpwaned);
+		hash.add(enemy->mFinished);
+		hash.add(enemy->mSpriteAvailable);
+		hash.add(enemy->mBulletsAvailable);
+	}
+
+	Item::HashAll(hash);
+	mPlayer->hashState(hash);
+
+	hash.add(mData.mPlayerLife);
+	hash.add(mData.mPlayerSpellCard);
+	hash.add(mData.mPlayerScore);
+	hash.add(mData.mPlayerPower);
+	hash.add(mData.mHighScore);
+	hash.add(mData.mMoney);
+
+	hash.add(sSeed);
+	hash.add(sRandomDraws);
+	hash.add(mPause);
+	return hash.value();
+}
+
+void MainGame::simulate(double deltaTime)
 {
 	mDeltaTime += deltaTime;
+	mAdvanced = !mPause;
 	if (mPause) {
 		if (mSwitchEffectEnabled) {
 			mSwitchScreenAnimation.update(deltaTime);
@@ -527,59 +641,83 @@ void MainGame::update(double deltaTime)
 		return;
 	}
 	
-	mBackground->update(deltaTime);
-	
-	mAllEnemyBullets.clear();
-	
+	mStepClock.restart();
+	{
+		ESL_PROFILE_ZONE("Background::update");
+		mBackground->update(deltaTime);
+	}
+	mStepTimings.steps++;
+	mStepTimings.other += lap();
 	
-	// µ˲ռӵ
-	for (auto& enemy : mEnemys) {
-		enemy->update(deltaTime);
-
-		// ռӵָ
-		for (auto& bullet : enemy->mBullets) {
-			if (bullet && bullet->getSprite()) {
-				mAllEnemyBullets.push_back(bullet.get());
-			}
+	// 更新敌人（发射的子弹直接进入 mBulletWorld）
+	{
+		ESL_PROFILE_ZONE("Enemy update");
+		for (auto& enemy : mEnemys) {
+			enemy->update(deltaTime);
 		}
 	}
-
-	// 
-	glm::vec2 movement = {
-		mPlayer->mDirection.h * deltaTime * mPlayer->mSpeed,
-		mPlayer->mDirection.v * deltaTime * mPlayer->mSpeed
-	};
-	mPlayer->move(movement);
-	mPlayer->update(deltaTime);
-
-	mStage.update(deltaTime, this);
-
-	// Żײ⣨һԼӵ
-	if (mCollisionManager.checkEnemyBulletsVsPlayer(mAllEnemyBullets, *mPlayer)) {
-		mScriptSystem.playSoundEffect("se_pldead00.wav");
+	mStepTimings.enemies += lap();
+
+	// 统一更新全部子弹（并行），并删除飞出屏幕的子弹；
+	// 子弹的生成都发生在上面的敌人更新中，碰撞检测在全部更新完成之后
+	{
+		ESL_PROFILE_ZONE("Bullet update");
+		mBulletWorld.setAimTarget(mPlayer->get_position());
+		mBulletWorld.update(deltaTime);
+		mBulletWorld.cullOutside({ 0.0f, 0.0f }, { 896.0f, 960.0f });
+	}
+	mStepTimings.bullets += lap();
+
+	{
+		ESL_PROFILE_ZONE("Player update");
+		// 玩家更新时追踪弹会按网格查找目标
+		buildEnemyGrid();
+
+		// 更新玩家
+		glm::vec2 movement = {
+			mPlayer->mDirection.h * deltaTime * mPlayer->mSpeed,
+			mPlayer->mDirection.v * deltaTime * mPlayer->mSpeed
+		};
+		mPlayer->move(movement);
+		mPlayer->update(deltaTime);
 	}
+	{
+		ESL_PROFILE_ZONE("Stage::update");
+		mStage.update(deltaTime, this);
+	}
+	mStepTimings.player += lap();
+
+	{
+		ESL_PROFILE_ZONE("Collision");
+		// 按子弹当前位置重建网格，只检测玩家附近格子里的子弹
+		mBulletGrid.build(mBulletWorld.mX.data(), mBulletWorld.mY.data(), mBulletWorld.mRadius.data(), mBulletWorld.size());
+		if (mCollisionManager.checkEnemyBulletsVsPlayer(mBulletWorld, mBulletGrid, *mPlayer)) {
+			mScriptSystem.playSoundEffect("se_pldead00.wav");
+		}
 
-	// ӵ vs 
-	for (auto& enemy : mEnemys) {
-		mCollisionManager.checkPlayerBulletsVsEnemy(mPlayer->mBullets, *enemy);
+		// 玩家子弹 vs 敌人
+		for (auto& enemy : mEnemys) {
+			mCollisionManager.checkPlayerBulletsVsEnemy(mPlayer->mBullets, *enemy);
 
-		if (auto* reimu = dynamic_cast<Reimu*>(mPlayer.get())) {
-			mCollisionManager.checkPlayerBulletsVsEnemy(reimu->mTraceBullets, *enemy);
-		}
+			if (auto* reimu = dynamic_cast<Reimu*>(mPlayer.get())) {
+				mCollisionManager.checkPlayerBulletsVsEnemy(reimu->mTraceBullets, *enemy);
+			}
 
-		mCollisionManager.checkPlayerVsEnemy(*mPlayer, *enemy);
+			mCollisionManager.checkPlayerVsEnemy(*mPlayer, *enemy);
+		}
 	}
+	mStepTimings.collision += lap();
 
-	// DeathCircle 
+	// DeathCircle 更新
 	mDeathCircle.update(deltaTime);
-	// 
+	// 批量清理死亡敌人
 	mEnemys.erase(
 		std::remove_if(mEnemys.begin(), mEnemys.end(), [this](Enemy* enemy) {
 			if (!enemy->mSpriteAvailable && !enemy->mBulletsAvailable) {
-				//  Boss,֪ͨ Front
+				// 如果是 Boss,先通知 Front
 				if (auto* boss = dynamic_cast<Boss*>(enemy)) {
 					mFront->hideBossXPosIndicator();
-					// ڴ˴deathcircle
+					// 在此处调用deathcircle
 					mDeathCircle.start(boss->getPosition());
 					mScriptSystem.playSoundEffect("se_enep01.wav");
 				}
@@ -591,12 +729,30 @@ void MainGame::update(double deltaTime)
 		mEnemys.end()
 	);
 
-	mScriptSystem.update(deltaTime);
-	Item::UpdateAll(deltaTime,mPlayer->get_position().y);
+	{
+		ESL_PROFILE_ZONE("ScriptSystem::update");
+		mScriptSystem.update(deltaTime);
+	}
+	{
+		ESL_PROFILE_ZONE("Item::UpdateAll");
+		Item::UpdateAll(deltaTime,mPlayer->get_position().y);
+	}
 	Bullet::updateEtBreaks(deltaTime);
-	mFront->update(deltaTime);
+	{
+		ESL_PROFILE_ZONE("Front::update");
+		mFront->update(deltaTime);
+	}
+	// 删除本步内释放的子弹，状态哈希与绘制只看到存活的子弹
+	mBulletWorld.compact();
+	{
+		// 本步的模拟结果已完整，发布给子弹渲染线程
+		ESL_PROFILE_ZONE("Bullet snapshot");
+		Bullet::capture(mBulletWorld, mBulletRender.snapshot());
+		mBulletRender.publish();
+	}
+	mStepTimings.other += lap();
 }
-// άֹף
+// 数据维护，防止数据溢出和作弊，但不调用
 void MainGame::data_maintain()
 {
 	if (mData.mPlayerLife > 7 || mData.mPlayerLife < 0) {
@@ -620,23 +776,62 @@ void MainGame::resume()
 void MainGame::handleGlobalInput(esl::Event& e)
 {
 	static bool escLatch = false;
-	//  ESC δʱлͣ״̬
+	// 按下 ESC 键且未锁定时切换暂停状态
 	if (e.isKeyPressed(Keyboard::KEY_ESCAPE) && !escLatch) {
-		// 
+		// 上锁
 		escLatch = true;
 
 		if (!mPause) {
 			enterPause();
 		}
 		else {
-			// ˳ͣ
+			// 请求退出暂停
 			requestExitPause();
 		}
 	}
-	// ͷ
+	// 若释放则重置锁
 	else if (e.isKeyReleased(Keyboard::KEY_ESCAPE)) {
 		escLatch = false;
 	}
+
+	// F3 显示/隐藏性能分析面板，F4 把最近的分析记录导出为 Chrome trace
+	static bool f3Latch = false, f4Latch = false;
+	if (e.isKeyPressed(Keyboard::KEY_F3) && !f3Latch) {
+		f3Latch = true;
+		mProfilerOverlay.toggle();
+	}
+	else if (e.isKeyReleased(Keyboard::KEY_F3)) {
+		f3Latch = false;
+	}
+	if (e.isKeyPressed(Keyboard::KEY_F4) && !f4Latch) {
+		f4Latch = true;
+		if (!esl::Profiler::enabled()) {
+			esl::Profiler::setEnabled(true);
+			std::cout << "Profiler enabled, press F4 again to write profile_trace.json" << std::endl;
+		}
+		else if (esl::Profiler::writeChromeTrace("profile_trace.json")) {
+			std::cout << "Profile trace written: profile_trace.json" << std::endl;
+		}
+	}
+	else if (e.isKeyReleased(Keyboard::KEY_F4)) {
+		f4Latch = false;
+	}
+	// F5 开启分配跟踪（面板中显示每帧分配），再按一次打印分配报告并关闭
+	static bool f5Latch = false;
+	if (e.isKeyPressed(Keyboard::KEY_F5) && !f5Latch) {
+		f5Latch = true;
+		if (!esl::AllocTracker::enabled()) {
+			esl::AllocTracker::reset();
+			esl::AllocTracker::setEnabled(true);
+		}
+		else {
+			esl::AllocTracker::writeReport(stdout);
+			esl::AllocTracker::setEnabled(false);
+		}
+	}
+	else if (e.isKeyReleased(Keyboard::KEY_F5)) {
+		f5Latch = false;
+	}
 }
 void MainGame::enterPause()
 {
@@ -658,13 +853,13 @@ void MainGame::returnTitleScreen()
 void MainGame::requestExitPause()
 {
 	if (mPauseMenu.getState() == PauseMenu::PauseMenuState::WAITING) {
-		mPauseMenu.state = PauseMenu::PauseMenuState::FADE_OUT; // ֱӴ FADE_OUT
+		mPauseMenu.state = PauseMenu::PauseMenuState::FADE_OUT; // 或直接触发 FADE_OUT
 		mPauseMenu.restartTimer();
 	}
 }
 void MainGame::handlePauseInput(esl::Event& e)
 {
-	// ˵ѡƶ
+	// 菜单选项移动锁
 	static bool navLatch = false;
 
 	if (e.isKeyPressed(Keyboard::KEY_UP) && !navLatch) {
@@ -679,11 +874,11 @@ void MainGame::handlePauseInput(esl::Event& e)
 	}
 	else if(e.isKeyPressed(Keyboard::KEY_Z) && !navLatch) {
 		switch (mPauseMenu.confirmSelection()) {
-			case 0: // Ϸ
+			case 0: // 继续游戏
 				requestExitPause();
 				break;
 			case 1:
-				returnTitleScreen(); // ر
+				returnTitleScreen(); // 返回标题
 				break;
 		default: break;
 		}
@@ -699,7 +894,7 @@ void MainGame::handleGameplayInput(esl::Event& e)
 {
 	static bool inputSuppressed = true;
 
-	// ƣZ ȫͷ
+	// 解除输入抑制：Z 完全释放
 	if (inputSuppressed && e.isKeyReleased(Keyboard::KEY_Z)) {
 		inputSuppressed = false;
 	}
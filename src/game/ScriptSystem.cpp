@@ -10,6 +10,7 @@
 #include <Scene.h>
 #include <Enemy.h>
 #include <Action.h>
+#include <ResourceCache.hpp>
 ScriptSystem::ScriptSystem()
 {
 
@@ -18,7 +19,6 @@ ScriptSystem::~ScriptSystem()
 {
 	delete pDialogue;
 	delete pAudio;
-	delete mStageClearTexture;
 	delete mStageClearSprite;
 
 }
@@ -39,14 +39,14 @@ void ScriptSystem::initAudioSystem(esl::Window& renderer)
 	for (int i = 1; i < mAudioFmts.size(); i++) {
 		bool isStage = i % 2;
 		if (isStage)
-			mAudioFmts[i]->texture = new esl::Texture("Assets\\front\\logo\\st0" + std::to_string(i) + "logo.png");
+			mAudioFmts[i]->texture = esl::TextureCache::get("Assets\\front\\logo\\st0" + std::to_string(i) + "logo.png");
 		else mAudioFmts[i]->texture = mAudioFmts[i - 1]->texture;
-		mAudioFmts[i]->titleSprite = new esl::Sprite(mAudioFmts[i]->texture);
+		mAudioFmts[i]->titleSprite = new esl::Sprite(mAudioFmts[i]->texture.get());
 		mAudioFmts[i]->titleSprite->setTextureRect({ 0,isStage ? 32 : 0, }, { 768,32 });
 	}
 	mRenderer = &renderer;
-	mStageClearTexture = new esl::Texture("Assets/front/front01.png");
-	mStageClearSprite = new esl::Sprite(mStageClearTexture);
+	mStageClearTexture = esl::TextureCache::get("Assets/front/front01.png");
+	mStageClearSprite = new esl::Sprite(mStageClearTexture.get());
 }
 void ScriptSystem::nextAudio()
 {
@@ -74,9 +74,9 @@ void ScriptSystem::resumeAudio()
 }
 void ScriptSystem::setAudio(int audio)
 {
-	int channels = 2;      // Ĭ
-	int sampleRate = 44100; // Ĭϲ
-	int bitsPerSample = 16; // Ĭ16λ
+	int channels = 2;      // 默认立体声
+	int sampleRate = 44100; // 默认采样率
+	int bitsPerSample = 16; // 默认16位
 	auto bytesToFrames = [](ma_uint64 bytes) -> ma_uint64 {
 		int bytesPerFrame = 2 * (16 / 8);
 		return (bytesPerFrame > 0) ? bytes / bytesPerFrame : 0;
@@ -161,35 +161,35 @@ void ScriptSystem::render()
 
 void ScriptSystem::update(double deltaTime)
 {
-	//Ի
+	//对话更新
 	if (pDialogue && mDialogueActived) {
 		pDialogue->update(deltaTime);
 
-		// ԣӡǰ״̬
+		// 调试：打印当前状态
 		static bool hasStartedExit = false;
 
-		// ԻǷ
+		// 检查对话是否结束
 		if (Message::isEmpty()) {
-			// ˳ֻһΣ
+			// 触发退出动画（只触发一次）
 			if (!hasStartedExit && !pDialogue->isExiting()) {
 				pDialogue->startExit();
 				hasStartedExit = true;
 
 			}
 
-			// ȴ˳
+			// 等待退出动画完成
 			if (pDialogue->mIsExiting == false && hasStartedExit) {
-				// ˳
+				// 退出动画已完成
 				mDialogueActived = false;
-				hasStartedExit = false;  // ñ־
+				hasStartedExit = false;  // 重置标志
 			}
 		}
 		else {
-			// ñ־ϢΪգ
+			// 重置标志（如果消息不为空）
 			hasStartedExit = false;
 		}
 	}
-	//ֱ
+	//音乐标题更新
 	if (mAudioTitleAnimation) {
 		mAudioTimer += deltaTime;
 		float alpha = 1.0f;
@@ -270,15 +270,15 @@ std::wstring ScriptSystem::fileConvertToWideString(const std::string& path)
 	if (!std::filesystem::exists(filePath)) {
 		throw std::runtime_error("File not found: " + path);
 	}
-	// ʹifstreamȡUTF-8ļ
+	// 使用ifstream读取UTF-8文件
 	std::ifstream file(filePath, std::ios::in | std::ios::binary);
 	if (!file.is_open()) {
 		throw std::runtime_error("Failed to open file: " + path);
 	}
-	// ȡļ
+	// 读取整个文件内容
 	std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
 	file.close();
-	// תUTF-8wstring
+	// 转换UTF-8到wstring
 	std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
 	return converter.from_bytes(content);
 }
@@ -288,7 +288,7 @@ void ScriptSystem::preloadDialogueScript(const std::string& path)
 	std::wistringstream stream(fileConvertToWideString(path));
 	std::wstring line;
 
-	// 1. ɫϢԭһ
+	// 1. 解析角色信息（和原来一样）
 	auto parseRole = [this, &stream, &line](size_t role) {
 		std::getline(stream, line);
 		std::string face_index_str = parseStrVal(line);
@@ -319,20 +319,20 @@ void ScriptSystem::preloadDialogueScript(const std::string& path)
 		}
 		};
 
-	// 2. ޸ģԻ䣨ֶַ֧Σ
+	// 2. 修改：解析对话段落（支持分段）
 	auto parseDialogueSection = [this, &stream, &line](const std::string& sectionName) {
-		std::vector<Message*> messages;  // ʱ洢һεϢ
+		std::vector<Message*> messages;  // 临时存储这一段的消息
 
 		while (std::getline(stream, line)) {
 			trim(line);
 			if (line.empty()) continue;
 
-			//  @#ǰ
+			// 如果遇到 @#，当前段落结束
 			if (line.find(L"@#") != std::wstring::npos) {
 				break;
 			}
 
-			// µĶǣֹͣ
+			// 如果遇到新的段落标记，停止解析
 			if (line.find(L"@DialogueSection:") != std::wstring::npos) {
 				break;
 			}
@@ -348,7 +348,7 @@ void ScriptSystem::preloadDialogueScript(const std::string& path)
 				continue;
 			}
 
-			// ȡ
+			// 读取属性
 			int role = 0, face = 0, balloon = 0;
 			for (int i = 0; i < 3; i++) {
 				if (!std::getline(stream, line)) break;
@@ -371,7 +371,7 @@ void ScriptSystem::preloadDialogueScript(const std::string& path)
 				}
 			}
 
-			// Ϣ
+			// 创建消息
 			Message* message = new Message(role);
 
 			for (size_t i = 0; i < text_line_count; i++) {
@@ -393,15 +393,15 @@ void ScriptSystem::preloadDialogueScript(const std::string& path)
 			message->setPosition(mCenterPos + glm::vec2{ role == 0 ? -200:200,200});
 			message->setBalloonStyle(balloon);
 
-			//  endEditǴ洢
+			// 不立即 endEdit，而是存储起来
 			messages.push_back(message);
 		}
 
-		// һεϢ
+		// 保存这一段的消息
 		mDialogueSections[sectionName] = messages;
 	};
 
-	// 3. ļ
+	// 3. 解析文件
 	std::string currentSection;
 	while (std::getline(stream, line)) {
 		trim(line);
@@ -414,7 +414,7 @@ void ScriptSystem::preloadDialogueScript(const std::string& path)
 			parseRole(1);
 		}
 		else if (line.find(L"@DialogueSection:") != std::wstring::npos) {
-			// ȡ
+			// 提取段落名称
 			size_t colonPos = line.find(L":");
 			if (colonPos != std::wstring::npos) {
 				std::wstring sectionNameW = line.substr(colonPos + 1);
@@ -428,7 +428,7 @@ void ScriptSystem::preloadDialogueScript(const std::string& path)
 		}
 	}
 }
-// ض
+// 新增：激活特定段落
 void ScriptSystem::activateDialogueSection(const std::string& sectionName)
 {
 	if (mDialogueSections.find(sectionName) == mDialogueSections.end()) {
@@ -439,13 +439,13 @@ void ScriptSystem::activateDialogueSection(const std::string& sectionName)
 		pDialogue->reset();
 		//std::cout << "[ScriptSystem] Dialogue state reset" << std::endl;
 	}
-	// öϢӵ
+	// 将该段落的消息添加到队列
 	for (auto* message : mDialogueSections[sectionName]) {
 		if (!message) {
 			//std::cerr << "[ScriptSystem] NULL message in section: " << sectionName << std::endl;
 			continue;
 		}
-		message->endEdit();  // ڲӵϢ
+		message->endEdit();  // 现在才真正添加到消息队列
 	}
 
 	mCurrentSection = sectionName;
@@ -454,7 +454,7 @@ void ScriptSystem::activateDialogueSection(const std::string& sectionName)
 	//std::cout << "[ScriptSystem] Activated dialogue section: " << sectionName << std::endl;
 }
 
-// Ƿ
+// 检查段落是否存在
 bool ScriptSystem::hasDialogueSection(const std::string& sectionName) const
 {
 	return mDialogueSections.find(sectionName) != mDialogueSections.end();
@@ -470,12 +470,12 @@ bool ScriptSystem::preloadSoundEffect(const std::string& dirPath)
 		for (const auto& entry : std::filesystem::directory_iterator(dirPath)) {
 			if (entry.is_regular_file()) {
 				std::string extension = entry.path().extension().string();
-				// ǷΪƵļ
+				// 检查是否为音频文件
 				if (extension == ".wav" || extension == ".mp3" || extension == ".ogg") {
 					std::string filePath = entry.path().string();
 					std::string fileName = entry.path().filename().string();
 
-					// Ч߼
+					// 音效加载逻辑
 					mSoundEffects[fileName] = std::move(std::make_unique<esl::Audio>(filePath,*pAudioEngine));
 
 					mSoundEffects[fileName]->setVolume(0.5f);
@@ -0,0 +1,58 @@
+﻿#include "SpatialGrid.h"
+#include <algorithm>
+
+void SpatialGrid::build(const float* xs, const float* ys, const float* radii, size_t count)
+{
+    mCellOf.resize(count);
+    mIndex.resize(count);
+    mX.resize(count);
+    mY.resize(count);
+    mRadius.resize(count);
+    mMaxRadius = 0.0f;
+
+    // 1. 统计每个格子的物体数量
+    std::array<uint32_t, CELL_COUNT> counts{};
+    for (size_t i = 0; i < count; ++i) {
+        uint16_t cell = static_cast<uint16_t>(cellY(ys[i]) * COLS + cellX(xs[i]));
+        mCellOf[i] = cell;
+        counts[cell]++;
+    }
+
+    // 2. 前缀和得到每个格子的起始位置
+    uint32_t offset = 0;
+    for (int c = 0; c < CELL_COUNT; ++c) {
+        mCellStart[c] = offset;
+        offset += counts[c];
+    }
+    mCellStart[CELL_COUNT] = offset;
+
+    // 3. 按格子顺序写入，同一格子内保持原始顺序
+    std::array<uint32_t, CELL_COUNT> cursor;
+    std::copy(mCellStart.begin(), mCellStart.end() - 1, cursor.begin());
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t k = cursor[mCellOf[i]]++;
+        float r = radii ? radii[i] : 0.0f;
+        mIndex[k] = static_cast<uint32_t>(i);
+        mX[k] = xs[i];
+        mY[k] = ys[i];
+        mRadius[k] = r;
+        if (r > mMaxRadius) mMaxRadius = r;
+    }
+}
+
+SpatialGrid::Query SpatialGrid::query(glm::vec2 min, glm::vec2 max) const
+{
+    Query result;
+    const int x0 = cellX(min.x);
+    const int x1 = cellX(max.x);
+    const int y0 = cellY(min.y);
+    const int y1 = cellY(max.y);
+    // 行优先存放，一行中 x0..x1 的格子首尾相接
+    for (int y = y0; y <= y1; ++y) {
+        Span span{ mCellStart[y * COLS + x0], mCellStart[y * COLS + x1 + 1] };
+        if (span.end > span.begin) {
+            result.rows[result.count++] = span;
+        }
+    }
+    return result;
+}
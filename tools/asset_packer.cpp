@@ -0,0 +1,133 @@
+﻿// 资源打包工具：把 Assets 目录下的图片预先解码、翻转为 RGBA 像素，写成一个资源包，
+// 运行时由 esl::AssetPack 映射进内存直接上传，跳过 PNG 解码。
+// 用法：asset_packer <资源目录> <输出文件>
+// 例如 asset_packer ./Assets ./Assets.pak，包内名字为 "assets/bullet/bullet1.png" 这样的相对路径，
+// 与游戏中 "./Assets/bullet/bullet1.png" 或 ".\\Assets\\bullet\\bullet1.png" 都能对应上。
+// 修改资源后需要重新打包
+#define STB_IMAGE_IMPLEMENTATION
+#include "stbImage/stb_image.h"
+#include "AssetPack.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+	const uint64_t DATA_ALIGNMENT = 16;
+
+	struct Source {
+		std::string name;	// 规范化后的包内名字
+		fs::path path;
+	};
+
+	bool isImage(const fs::path& path)
+	{
+		std::string ext = path.extension().string();
+		std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+		return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".bmp" || ext == ".tga";
+	}
+
+	void pad(std::ofstream& out, uint64_t& offset, uint64_t alignment)
+	{
+		while (offset % alignment != 0) {
+			out.put(0);
+			offset++;
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 3) {
+		std::printf("usage: %s <asset dir> <output pack>\n", argv[0]);
+		return 1;
+	}
+	fs::path root = fs::path(argv[1]).lexically_normal();
+	if (!root.has_filename()) root = root.parent_path();
+	if (!fs::is_directory(root)) {
+		std::printf("asset_packer: %s is not a directory\n", argv[1]);
+		return 1;
+	}
+
+	std::vector<Source> sources;
+	for (auto& item : fs::recursive_directory_iterator(root)) {
+		if (!item.is_regular_file() || !isImage(item.path())) continue;
+		std::string relative = (root.filename() / fs::relative(item.path(), root)).generic_string();
+		sources.push_back({ esl::AssetPack::normalize(relative), item.path() });
+	}
+	// 运行时按名字二分查找
+	std::sort(sources.begin(), sources.end(), [](const Source& a, const Source& b) { return a.name < b.name; });
+	for (size_t i = 1; i < sources.size(); i++) {
+		if (sources[i].name == sources[i - 1].name) {
+			std::printf("asset_packer: %s and %s map to the same name\n",
+				sources[i - 1].path.string().c_str(), sources[i].path.string().c_str());
+			return 1;
+		}
+	}
+
+	std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+	if (!out) {
+		std::printf("asset_packer: cannot write %s\n", argv[2]);
+		return 1;
+	}
+	auto start = std::chrono::steady_clock::now();
+	esl::AssetPackHeader header = {};
+	std::memcpy(header.magic, esl::AssetPack::MAGIC, 4);
+	header.version = esl::AssetPack::VERSION;
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	uint64_t offset = sizeof(header);
+
+	std::vector<esl::AssetPackEntry> entries;
+	std::string names;
+	uint64_t pixelBytes = 0;
+	stbi_set_flip_vertically_on_load(true);
+	for (auto& source : sources) {
+		int width, height, channel;
+		stbi_uc* pixels = stbi_load(source.path.string().c_str(), &width, &height, &channel, 4);
+		if (!pixels) {
+			std::printf("asset_packer: skipped %s: %s\n", source.path.string().c_str(), stbi_failure_reason());
+			continue;
+		}
+		pad(out, offset, DATA_ALIGNMENT);
+		esl::AssetPackEntry entry = {};
+		entry.dataOffset = offset;
+		entry.nameOffset = static_cast<uint32_t>(names.size());
+		entry.nameLength = static_cast<uint32_t>(source.name.size());
+		entry.width = static_cast<uint32_t>(width);
+		entry.height = static_cast<uint32_t>(height);
+		uint64_t bytes = static_cast<uint64_t>(width) * height * 4;
+		out.write(reinterpret_cast<const char*>(pixels), bytes);
+		stbi_image_free(pixels);
+		offset += bytes;
+		pixelBytes += bytes;
+		names += source.name;
+		entries.push_back(entry);
+	}
+
+	pad(out, offset, DATA_ALIGNMENT);
+	header.entryCount = static_cast<uint32_t>(entries.size());
+	header.indexOffset = offset;
+	out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(esl::AssetPackEntry));
+	offset += entries.size() * sizeof(esl::AssetPackEntry);
+	header.namesOffset = offset;
+	out.write(names.data(), names.size());
+	out.seekp(0);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.close();
+	if (!out) {
+		std::printf("asset_packer: failed writing %s\n", argv[2]);
+		return 1;
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::printf("asset_packer: %u images, %.1f MiB of texels -> %s (%.2f s)\n",
+		header.entryCount, pixelBytes / (1024.0 * 1024.0), argv[2], seconds);
+	return 0;
+}